@@ -1,26 +1,181 @@
 #include <iostream>
 #include <string>
 #include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
 #include "system_data.h"
 #include "utility_fun.h"
 #include "input_validation.h"
 #include "file_operation.h"
+#include "console_input.h"
+#include "console_output.h"
 #include "user.h"
 #include "event_registration.h"
 #include "event_booking.h"   
 #include "event_monitoring.h"
 #include "feedback.h"            
+#include "reservation_benchmark.h"
+#include "lock_benchmark.h"
+#include "clock.h"
+#include "script_runner.h"
+#include "json_protocol.h"
+#include "local_server.h"
+#include "remote_client.h"
+#include "worker_pool.h"
+#include <fstream>
+#include <thread>
+#include <memory>
 
 using namespace std;
 
 // Function declarations
+void runUserMenu(SystemData& data);
 void mainSystemMenu(SystemData& data);
 string getCurrentUserName(const SystemData& data);
 
 // Main function
-int main() {
+int main(int argc, char* argv[]) {
+    // Stress benchmark: --bench-reservations [threads] [operations per thread]
+    if (argc > 1 && string(argv[1]) == "--bench-reservations") {
+        int threads = argc > 2 ? atoi(argv[2]) : 8;
+        int operations = argc > 3 ? atoi(argv[3]) : 200000;
+        return runReservationBenchmark(max(threads, 1), max(operations, 1)) ? 0 : 1;
+    }
+
+    // Read scaling benchmark: --bench-locks [threads] [reads per thread]
+    if (argc > 1 && string(argv[1]) == "--bench-locks") {
+        int threads = argc > 2 ? atoi(argv[2]) : static_cast<int>(max(thread::hardware_concurrency(), 1u));
+        int operations = argc > 3 ? atoi(argv[3]) : 2000;
+        return runLockBenchmark(max(threads, 1), max(operations, 1)) ? 0 : 1;
+    }
+
+    // Run as if today were another date: --today YYYY-MM-DD
+    for (int i = 1; i + 1 < argc; i++) {
+        if (string(argv[i]) == "--today") {
+            Date today{};
+            char dash1 = 0, dash2 = 0;
+            stringstream dateStream(argv[i + 1]);
+            if (dateStream >> today.year >> dash1 >> today.month >> dash2 >> today.day && dash1 == '-' && dash2 == '-') {
+                systemClock().startOn(today);
+            }
+        }
+    }
+
+    // Thin client for a running server: --connect SOCKET [--json | --changes]
+    for (int i = 1; i + 1 < argc; i++) {
+        if (string(argv[i]) == "--connect") {
+            RemoteMode mode = RemoteMode::Menu;
+            if (find(argv + 1, argv + argc, string("--json")) != argv + argc) {
+                mode = RemoteMode::Json;
+            }
+            else if (find(argv + 1, argv + argc, string("--changes")) != argv + argc) {
+                mode = RemoteMode::Changes;
+            }
+            return runRemoteClient(argv[i + 1], mode);
+        }
+    }
+
+    // JSON-lines protocol: --json answers one request per stdin line on
+    // stdout, so everything else the system prints is discarded
+    bool jsonMode = find(argv + 1, argv + argc, string("--json")) != argv + argc;
+    ostream jsonOut(nullptr);
+    if (jsonMode) {
+        ios::sync_with_stdio(false);    // buffered stdin, so pipelined requests batch their saves
+        jsonOut.rdbuf(cout.rdbuf());
+        cout.rdbuf(nullptr);
+    }
+
+    // Background pool size: --workers N (it also answers the shared
+    // server's JSON requests). Set before loading, which already uses it.
+    for (int i = 1; i + 1 < argc; i++) {
+        if (string(argv[i]) == "--workers") {
+            setBackgroundThreads(max(atoi(argv[i + 1]), 1));
+        }
+    }
+
     SystemData data;
+
+    // Change stream for downstream systems: --change-log FILE appends one
+    // JSON line per committed change, in any mode
+    unique_ptr<ChangeListener> changeLog;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (string(argv[i]) == "--change-log") {
+            changeLog = startChangeLog(data.changes, argv[i + 1]);
+            if (changeLog == nullptr) {
+                cerr << "Error: Cannot open change log " << argv[i + 1] << endl;
+                return 1;
+            }
+        }
+    }
+
+    if (jsonMode) {
+        int failures = runJsonProtocol(data, cin, jsonOut);
+        return failures == 0 ? 0 : 1;
+    }
+
+    // Headless batch: --script FILE runs its commands ("-" reads stdin)
+    for (int i = 1; i + 1 < argc; i++) {
+        if (string(argv[i]) == "--script") {
+            int failures = 0;
+            if (string(argv[i + 1]) == "-") {
+                failures = runScript(data, cin);
+            }
+            else {
+                ifstream script(argv[i + 1]);
+                if (!script.is_open()) {
+                    cout << "Error: Cannot open script file " << argv[i + 1] << endl;
+                    return 1;
+                }
+                failures = runScript(data, script);
+            }
+            saveDataToFiles(data);
+            return failures == 0 ? 0 : 1;
+        }
+    }
     
+    // Shared server: --serve SOCKET [--workers N]
+    for (int i = 1; i + 1 < argc; i++) {
+        if (string(argv[i]) == "--serve") {
+            return runLocalServer(data, argv[i + 1], runUserMenu) ? 0 : 1;
+        }
+    }
+
+    // Interactive console: menu actions only queue their saves. The session
+    // holds the data while it works and lets go at every prompt, which is
+    // when the persistence thread writes the files.
+    DataLockSet session(data.locks, LockPlan().writes(ALL_DATA));
+    setSessionLocks(&session);
+    setPromptWaitHook([&session](bool waiting) {
+        if (waiting) {
+            session.unlock();
+        }
+        else {
+            session.relock();
+        }
+        });
+    startBackgroundSaves(data);
+
+    // Each screen reaches the terminal in one write, cleared and paused
+    // without a shell; --plain-console keeps the old line-by-line output.
+    // --frame-stats reports how long screens took to draw, on exit.
+    startConsoleScreens(find(argv + 1, argv + argc, string("--plain-console")) != argv + argc);
+
+    runUserMenu(data);
+
+    setPromptWaitHook(nullptr);
+    setSessionLocks(nullptr);
+    session.unlock();
+    stopBackgroundSaves();
+    stopConsoleScreens();
+    if (find(argv + 1, argv + argc, string("--frame-stats")) != argv + argc) {
+        cerr << formatFrameStats(consoleFrameStats()) << endl;
+    }
+    return 0;
+}
+
+// Sign up / log in loop, until the user picks Exit
+void runUserMenu(SystemData& data) {
     bool exitProgram = false, loginValidation = false;
 
     while (!exitProgram) {
@@ -68,8 +223,6 @@ int main() {
             break;
         }
     }
-
-    return 0;
 }
 
 void mainSystemMenu(SystemData& data) {
@@ -78,6 +231,7 @@ void mainSystemMenu(SystemData& data) {
     while (!logoutRequested) {
         clearScreen();
         displayLogo();
+        runHousekeeping(data);
         cout << "Welcome, " << getCurrentUserName(data) << "!" << endl;
         cout << "======= MAIN SYSTEM MENU =======" << endl;
         cout << setfill('=') << setw(50) << "=" << setfill(' ') << endl;
@@ -115,6 +269,10 @@ void mainSystemMenu(SystemData& data) {
         case 7:
             saveDataToFiles(data);
             saveRegistrationsToFile(data.registrations);
+            {
+                UnlockedSection unlocked;
+                waitForSaves(data);
+            }
             cout << "Data saved successfully!" << endl;
             cout << "Logging out..." << endl;
             logoutRequested = true;
@@ -0,0 +1,406 @@
+#include "auto_scheduler.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include "system_data.h"
+#include "utility_fun.h"
+#include "input_validation.h"
+#include "booking_transaction.h"
+#include "worker_pool.h"
+
+using namespace std;
+
+// Upper bound on relocation attempts per unplaced registration
+static const int MAX_REPAIR_TRIES = 2000;
+
+// Longest preferred-date window the screen accepts
+static const int MAX_WINDOW_DAYS = 366;
+
+namespace {
+
+    // One registration to place, with the venues it may use in ranking order
+    struct Candidate {
+        RecordHandle registration;
+        vector<int> venues;         // seat the guests and fit the budget
+        long long freeOptions = 0;  // free (day, slot, venue) combinations at the start
+    };
+
+    struct Option {
+        int day;                    // day number
+        int slot;                   // index into timeConfig.timeSlots
+        int venue;
+    };
+
+    // Working state of the planner: who holds which venue-slot and manufacturer-day
+    class Planner {
+    public:
+        Planner(const SystemData& data, const ScheduleRequest& request)
+            : data(data), request(request),
+            firstDay(request.windowStart.toDayNumber()), lastDay(request.windowEnd.toDayNumber()),
+            slotCount(static_cast<int>(data.timeConfig.timeSlots.size())),
+            venueCount(static_cast<int>(data.venues.size())) {
+            // Launches already booked count against the one-per-day rule
+            for (const auto& booking : data.bookings) {
+                if (booking.bookingStatus != "Cancelled") {
+                    bookedManufacturerDays.insert(manufacturerDayKey(booking.eventReg.manufacturer, booking.eventDate.toDayNumber()));
+                }
+            }
+        }
+
+        vector<Candidate> buildCandidates() const;
+        SchedulePlan run();
+
+    private:
+        const SystemData& data;
+        const ScheduleRequest& request;
+        int firstDay, lastDay, slotCount, venueCount;
+
+        unordered_set<string> bookedManufacturerDays;       // from existing bookings
+        unordered_map<long long, int> slotOwner;            // option key -> candidate
+        unordered_map<string, int> manufacturerDayOwner;    // manufacturer|day -> candidate
+        vector<Candidate> candidates;
+        vector<Option> placed;                              // per candidate, valid when isPlaced
+        vector<bool> isPlaced;
+
+        static string manufacturerDayKey(const string& manufacturer, int day) {
+            return manufacturer + "|" + to_string(day);
+        }
+
+        long long optionKey(const Option& option) const {
+            return (static_cast<long long>(option.day) * slotCount + option.slot) * venueCount + option.venue;
+        }
+
+        const string& manufacturerOf(int candidate) const {
+            return data.registrations[candidates[candidate].registration].manufacturer;
+        }
+
+        // Free in the live venue index and not a day the manufacturer already launches
+        bool openOutsidePlan(int candidate, const Option& option) const {
+            if (!isVenueSlotFree(data.venueIndex, option.venue, Date::fromDayNumber(option.day), data.timeConfig.timeSlots[option.slot])) {
+                return false;
+            }
+            return !request.onePerManufacturerPerDay ||
+                bookedManufacturerDays.count(manufacturerDayKey(manufacturerOf(candidate), option.day)) == 0;
+        }
+
+        bool manufacturerDayTaken(int candidate, int day) const {
+            if (!request.onePerManufacturerPerDay) {
+                return false;
+            }
+            auto owner = manufacturerDayOwner.find(manufacturerDayKey(manufacturerOf(candidate), day));
+            return owner != manufacturerDayOwner.end() && owner->second != candidate;
+        }
+
+        void place(int candidate, const Option& option) {
+            slotOwner[optionKey(option)] = candidate;
+            if (request.onePerManufacturerPerDay) {
+                manufacturerDayOwner[manufacturerDayKey(manufacturerOf(candidate), option.day)] = candidate;
+            }
+            placed[candidate] = option;
+            isPlaced[candidate] = true;
+        }
+
+        void unplace(int candidate) {
+            const Option& option = placed[candidate];
+            slotOwner.erase(optionKey(option));
+            if (request.onePerManufacturerPerDay) {
+                manufacturerDayOwner.erase(manufacturerDayKey(manufacturerOf(candidate), option.day));
+            }
+            isPlaced[candidate] = false;
+        }
+
+        // Earliest day, then listed slot order, then best-fit venue
+        template <typename Visitor>
+        bool forEachOption(int candidate, Visitor visit) const {
+            for (int day = firstDay; day <= lastDay; day++) {
+                for (int slot = 0; slot < slotCount; slot++) {
+                    for (int venue : candidates[candidate].venues) {
+                        if (visit(Option{ day, slot, venue })) {
+                            return true;
+                        }
+                    }
+                }
+            }
+            return false;
+        }
+
+        bool placeGreedy(int candidate, long long skipKey = -1) {
+            Option chosen{};
+            bool found = forEachOption(candidate, [&](const Option& option) {
+                if (optionKey(option) == skipKey || slotOwner.count(optionKey(option)) > 0 ||
+                    manufacturerDayTaken(candidate, option.day) || !openOutsidePlan(candidate, option)) {
+                    return false;
+                }
+                chosen = option;
+                return true;
+                });
+            if (found) {
+                place(candidate, chosen);
+            }
+            return found;
+        }
+
+        // Take an option held by exactly one other registration and move that one elsewhere
+        bool placeByRelocation(int candidate) {
+            int tries = 0;
+            return forEachOption(candidate, [&](const Option& option) {
+                if (++tries > MAX_REPAIR_TRIES) {
+                    return true; // give up, checked below
+                }
+                if (!openOutsidePlan(candidate, option)) {
+                    return false;
+                }
+
+                int blocker = -1;
+                auto slotHolder = slotOwner.find(optionKey(option));
+                if (slotHolder != slotOwner.end()) {
+                    blocker = slotHolder->second;
+                }
+                if (request.onePerManufacturerPerDay) {
+                    auto dayHolder = manufacturerDayOwner.find(manufacturerDayKey(manufacturerOf(candidate), option.day));
+                    if (dayHolder != manufacturerDayOwner.end()) {
+                        if (blocker != -1 && blocker != dayHolder->second) {
+                            return false; // two registrations in the way
+                        }
+                        blocker = dayHolder->second;
+                    }
+                }
+                if (blocker == -1) {
+                    place(candidate, option); // became free since the greedy pass
+                    return true;
+                }
+
+                Option previous = placed[blocker];
+                unplace(blocker);
+                place(candidate, option);
+                if (placeGreedy(blocker, optionKey(option))) {
+                    return true;
+                }
+                unplace(candidate);
+                place(blocker, previous);
+                return false;
+                }) && isPlaced[candidate];
+        }
+    };
+
+    vector<Candidate> Planner::buildCandidates() const {
+        const vector<RecordHandle>& registrations = request.registrations;
+        vector<Candidate> result(registrations.size());
+
+        // Each registration is evaluated on its own, so split them across threads
+        auto evaluate = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const EventRegistration& reg = data.registrations[registrations[i]];
+                Candidate& candidate = result[i];
+                candidate.registration = registrations[i];
+
+                bool limitCost = request.respectBudget && reg.estimatedBudget > Money();
+                for (int venue : data.venueIndex.byCapacity) {
+                    const Venue& v = data.venues[venue];
+                    if (v.capacity >= reg.expectedGuests && (!limitCost || v.rentalCost <= reg.estimatedBudget)) {
+                        candidate.venues.push_back(venue);
+                    }
+                }
+
+                for (int day = firstDay; day <= lastDay; day++) {
+                    Date date = Date::fromDayNumber(day);
+                    for (const auto& time : data.timeConfig.timeSlots) {
+                        for (int venue : candidate.venues) {
+                            if (isVenueSlotFree(data.venueIndex, venue, date, time)) {
+                                candidate.freeOptions++;
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        WorkerPool& pool = backgroundPool();
+        size_t workers = static_cast<size_t>(pool.size());
+        size_t chunk = (registrations.size() + workers - 1) / workers;
+        vector<TaskFuture<void>> jobs;
+        for (size_t begin = 0; begin < registrations.size(); begin += chunk) {
+            size_t end = min(begin + chunk, registrations.size());
+            jobs.push_back(pool.submit(TaskPriority::Normal, "schedule candidates", [&evaluate, begin, end] { evaluate(begin, end); }));
+        }
+        for (auto& job : jobs) {
+            job.get();
+        }
+        return result;
+    }
+
+    SchedulePlan Planner::run() {
+        candidates = buildCandidates();
+
+        // Most constrained first; bigger events first among equals
+        sort(candidates.begin(), candidates.end(), [&](const Candidate& a, const Candidate& b) {
+            if (a.freeOptions != b.freeOptions) {
+                return a.freeOptions < b.freeOptions;
+            }
+            return data.registrations[a.registration].expectedGuests > data.registrations[b.registration].expectedGuests;
+            });
+
+        placed.assign(candidates.size(), Option{});
+        isPlaced.assign(candidates.size(), false);
+
+        vector<int> leftOver;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (!placeGreedy(static_cast<int>(i))) {
+                leftOver.push_back(static_cast<int>(i));
+            }
+        }
+
+        SchedulePlan plan;
+        for (int candidate : leftOver) {
+            if (placeByRelocation(candidate)) {
+                plan.repaired++;
+            }
+        }
+
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (isPlaced[i]) {
+                plan.assignments.push_back({ candidates[i].registration, placed[i].venue,
+                    Date::fromDayNumber(placed[i].day), data.timeConfig.timeSlots[placed[i].slot] });
+            }
+            else {
+                plan.unplaced.push_back(candidates[i].registration);
+            }
+        }
+
+        sort(plan.assignments.begin(), plan.assignments.end(), [](const ScheduleAssignment& a, const ScheduleAssignment& b) {
+            if (a.date.toDayNumber() != b.date.toDayNumber()) {
+                return a.date.toDayNumber() < b.date.toDayNumber();
+            }
+            return a.time < b.time;
+            });
+        return plan;
+    }
+}
+
+SchedulePlan planSchedule(const SystemData& data, const ScheduleRequest& request) {
+    if (request.registrations.empty() || data.venues.empty() || data.timeConfig.timeSlots.empty() ||
+        request.windowEnd.toDayNumber() < request.windowStart.toDayNumber()) {
+        SchedulePlan plan;
+        plan.unplaced = request.registrations;
+        return plan;
+    }
+    Planner planner(data, request);
+    return planner.run();
+}
+
+bool applySchedulePlan(SystemData& data, const SchedulePlan& plan, string& error) {
+    BookingTransaction transaction;
+    for (const auto& assignment : plan.assignments) {
+        stageBooking(transaction, assignment.registration, assignment.venue, assignment.date, assignment.time);
+    }
+
+    TransactionResult result = commitTransaction(data, transaction);
+    if (!result.committed && !result.conflicts.empty()) {
+        error = result.conflicts.front().reason;
+    }
+    return result.committed;
+}
+
+void autoScheduleEvents(SystemData& data) {
+    clearScreen();
+    displayLogo();
+    cout << "=== AUTO-SCHEDULE MY EVENTS ===" << endl;
+    cout << setfill('=') << setw(100) << "=" << setfill(' ') << endl;
+
+    if (data.currentUser.empty()) {
+        cout << "Error: No user logged in!" << endl;
+        return;
+    }
+
+    ScheduleRequest request;
+    string normalizedCurrentUser = normalizeUserID(data.currentUser);
+    for (auto it = data.registrations.begin(); it != data.registrations.end(); ++it) {
+        if (it->eventStatus == "UNSCHEDULED" &&
+            normalizeUserID(it->organizer.userID) == normalizedCurrentUser) {
+            request.registrations.push_back(it.handle());
+        }
+    }
+
+    if (request.registrations.empty()) {
+        cout << "You have no unscheduled event registrations." << endl;
+        return;
+    }
+    cout << "Unscheduled registrations: " << request.registrations.size() << endl;
+
+    cout << "\nEarliest preferred date:" << endl;
+    request.windowStart = getValidDateInput();
+    cout << "\nLatest preferred date:" << endl;
+    request.windowEnd = getValidDateInput();
+
+    int span = request.windowEnd.toDayNumber() - request.windowStart.toDayNumber();
+    if (span < 0) {
+        cout << "Error: Latest date is before the earliest date." << endl;
+        return;
+    }
+    if (span >= MAX_WINDOW_DAYS) {
+        cout << "Error: Date window cannot exceed " << MAX_WINDOW_DAYS << " days." << endl;
+        return;
+    }
+
+    vector<char> validChars = { 'Y', 'N' };
+    request.respectBudget = getValidCharInput("Only use venues within each event's budget? (Y/N): ", validChars) == 'Y';
+
+    cout << "\nPlanning..." << endl;
+    SchedulePlan plan = planSchedule(data, request);
+
+    cout << "\n=== PROPOSED SCHEDULE ===" << endl;
+    cout << setfill('=') << setw(100) << "=" << setfill(' ') << endl;
+    cout << left << setw(10) << "Event ID"
+        << setw(20) << "Event Title"
+        << setw(14) << "Manufacturer"
+        << setw(12) << "Date"
+        << setw(14) << "Time"
+        << setw(16) << "Venue"
+        << setw(14) << "Cost (RM)" << endl;
+    cout << setfill('-') << setw(100) << "-" << setfill(' ') << endl;
+
+    Money total;
+    for (const auto& assignment : plan.assignments) {
+        const EventRegistration& reg = data.registrations[assignment.registration];
+        const Venue& venue = data.venues[assignment.venue];
+        cout << left << setw(10) << reg.eventID
+            << setw(20) << reg.eventTitle.substr(0, 19)
+            << setw(14) << reg.manufacturer.substr(0, 13)
+            << setw(12) << assignment.date.toString()
+            << setw(14) << assignment.time
+            << setw(16) << venue.venueName.substr(0, 15)
+            << venue.rentalCost << endl;
+        total += venue.rentalCost;
+    }
+    cout << setfill('-') << setw(100) << "-" << setfill(' ') << endl;
+    cout << "Placed: " << plan.assignments.size() << " (" << plan.repaired << " after rearranging)"
+        << " | Total venue cost: RM " << total << endl;
+
+    if (!plan.unplaced.empty()) {
+        cout << "\nCould not place " << plan.unplaced.size() << " registration(s):" << endl;
+        for (RecordHandle handle : plan.unplaced) {
+            const EventRegistration& reg = data.registrations[handle];
+            cout << "  " << reg.eventID << " - " << reg.eventTitle
+                << " (" << reg.expectedGuests << " guests, budget RM " << reg.estimatedBudget << ")" << endl;
+        }
+    }
+
+    if (plan.assignments.empty()) {
+        return;
+    }
+
+    char confirm = getValidCharInput("\nBook all placed events now? (Y/N): ", validChars);
+    if (confirm != 'Y') {
+        cout << "No bookings were made." << endl;
+        return;
+    }
+
+    string error;
+    if (!applySchedulePlan(data, plan, error)) {
+        cout << "Scheduling failed, no bookings were made: " << error << endl;
+        return;
+    }
+    cout << plan.assignments.size() << " booking(s) created with status Pending. Proceed to payment to confirm them." << endl;
+}
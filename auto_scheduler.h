@@ -0,0 +1,48 @@
+#pragma once
+#ifndef AUTO_SCHEDULER_H
+#define AUTO_SCHEDULER_H
+
+#include <string>
+#include <vector>
+#include "date.h"
+#include "record_table.h"
+using namespace std;
+
+// What to place and where it may go
+struct ScheduleRequest {
+    vector<RecordHandle> registrations; // into data.registrations
+    Date windowStart;                   // preferred dates, inclusive
+    Date windowEnd;
+    bool respectBudget = true;          // venue rental must fit estimatedBudget
+    bool onePerManufacturerPerDay = true;
+};
+
+struct ScheduleAssignment {
+    RecordHandle registration;          // into data.registrations
+    int venue;                          // index into data.venues
+    Date date;
+    string time;
+};
+
+struct SchedulePlan {
+    vector<ScheduleAssignment> assignments;
+    vector<RecordHandle> unplaced;      // registrations with no conflict-free slot
+    int repaired = 0;                   // placed by moving another registration
+};
+
+// Forward declarations
+class SystemData;
+
+// Greedy placement, most constrained registration first, followed by a
+// repair pass that relocates one blocking registration at a time. Only
+// reads data; nothing is booked until the plan is applied.
+SchedulePlan planSchedule(const SystemData& data, const ScheduleRequest& request);
+
+// Books the whole plan in one transaction, or none of it when anything
+// conflicts with the current data (first reason in error)
+bool applySchedulePlan(SystemData& data, const SchedulePlan& plan, string& error);
+
+// Interactive screen: schedule the current user's UNSCHEDULED registrations
+void autoScheduleEvents(SystemData& data);
+
+#endif
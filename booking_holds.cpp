@@ -0,0 +1,108 @@
+#include "booking_holds.h"
+#include <iostream>
+#include "system_data.h"
+#include "file_operation.h"
+#include "cascade.h"
+
+using namespace std;
+
+void placeBookingHold(HoldBook& holds, const string& bookingID, RecordHandle booking, RecordHandle registration, long long now) {
+    long long expiresAt = now + holds.holdSeconds;
+    holds.live[bookingID] = { expiresAt, booking, registration };
+    holds.deadlines.push({ expiresAt, bookingID });
+}
+
+void releaseBookingHold(HoldBook& holds, const string& bookingID) {
+    holds.live.erase(bookingID);
+}
+
+long long holdExpiry(const HoldBook& holds, const string& bookingID) {
+    auto found = holds.live.find(bookingID);
+    return found == holds.live.end() ? 0 : found->second.expiresAt;
+}
+
+void adoptPendingBookings(SystemData& data, long long now) {
+    unordered_map<string, RecordHandle> registrationOf;
+    for (auto it = data.registrations.begin(); it != data.registrations.end(); ++it) {
+        registrationOf.emplace(it->eventID, it.handle());
+    }
+
+    for (auto it = data.bookings.begin(); it != data.bookings.end(); ++it) {
+        if (it->bookingStatus != "Pending") {
+            continue;
+        }
+        auto registration = registrationOf.find(it->eventReg.eventID);
+        RecordHandle regHandle = registration != registrationOf.end() ? registration->second : RecordHandle();
+        auto found = data.holds.live.find(it->bookingID);
+        if (found == data.holds.live.end()) {
+            placeBookingHold(data.holds, it->bookingID, it.handle(), regHandle, now);
+        }
+        else {
+            found->second.booking = it.handle();
+            found->second.registration = regHandle;
+        }
+    }
+}
+
+vector<string> sweepExpiredHolds(SystemData& data, long long now) {
+    HoldBook& holds = data.holds;
+    vector<string> expired;
+    unordered_map<int, unordered_set<string>> leavingSchedule;  // venue position -> booking IDs
+
+    while (!holds.deadlines.empty() && holds.deadlines.top().expiresAt <= now) {
+        HoldDeadline due = holds.deadlines.top();
+        holds.deadlines.pop();
+
+        auto live = holds.live.find(due.bookingID);
+        if (live == holds.live.end() || live->second.expiresAt != due.expiresAt) {
+            continue; // paid, cancelled or re-held since
+        }
+        EventBooking* held = data.bookings.find(live->second.booking);
+        EventRegistration* reg = data.registrations.find(live->second.registration);
+        holds.live.erase(live);
+        if (held == nullptr || held->bookingID != due.bookingID || held->bookingStatus != "Pending") {
+            continue;
+        }
+
+        EventBooking& booking = *held;
+        booking.bookingStatus = "Cancelled";
+        recordBookingInCube(data.revenue, booking);
+        data.changes.publish(ChangeKind::BookingCancelled, booking.bookingID, booking.eventReg.organizer.userID, booking.finalCost);
+        if (reg != nullptr && reg->eventID == booking.eventReg.eventID) {
+            reg->eventStatus = "UNSCHEDULED";
+            data.changes.publish(ChangeKind::RegistrationUpdated, reg->eventID, reg->organizer.userID);
+        }
+        auto venue = data.venueIndex.positionOf.find(booking.venue.venueID);
+        if (venue != data.venueIndex.positionOf.end()) {
+            leavingSchedule[venue->second].insert(booking.bookingID);
+        }
+        expired.push_back(booking.bookingID);
+    }
+
+    if (expired.empty()) {
+        return expired;
+    }
+
+    vector<ReleasedSlot> released = removeScheduleEntries(data, leavingSchedule);
+    saveVenuesToFile(data.venues);
+    saveRegistrationsToFile(data.registrations);
+    saveBookingsToFile(data.bookings);
+    saveHoldsToFile(data.holds);
+
+    // After every status change, so a promoted waitlist entry sees the
+    // registrations as they end up
+    offerReleasedSlots(data, released);
+    return expired;
+}
+
+void runHoldSweep(SystemData& data) {
+    vector<string> expired = sweepExpiredHolds(data, currentTimestamp());
+    if (expired.empty()) {
+        return;
+    }
+    cout << expired.size() << " unpaid booking(s) passed their payment deadline and were cancelled:";
+    for (const auto& bookingID : expired) {
+        cout << " " << bookingID;
+    }
+    cout << endl;
+}
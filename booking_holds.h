@@ -0,0 +1,58 @@
+#pragma once
+#ifndef BOOKING_HOLDS_H
+#define BOOKING_HOLDS_H
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <unordered_map>
+#include "clock.h"
+#include "record_table.h"
+using namespace std;
+
+// Pending bookings hold their venue slot only until the deadline; unpaid
+// ones are cancelled by the sweeper and the slot goes back on offer.
+const long long DEFAULT_HOLD_SECONDS = 24 * 60 * 60;
+
+struct HoldDeadline {
+    long long expiresAt;
+    string bookingID;
+
+    auto operator<=>(const HoldDeadline&) const = default;
+};
+
+struct LiveHold {
+    long long expiresAt;
+    RecordHandle booking;           // into data.bookings
+    RecordHandle registration;      // into data.registrations, set back to UNSCHEDULED on expiry
+};
+
+struct HoldBook {
+    long long holdSeconds = DEFAULT_HOLD_SECONDS;
+    // Earliest deadline on top. Released holds are not removed from the
+    // heap; they are skipped when they surface, so each push pops once.
+    priority_queue<HoldDeadline, vector<HoldDeadline>, greater<HoldDeadline>> deadlines;
+    unordered_map<string, LiveHold> live;   // bookingID -> current hold
+};
+
+// Forward declarations
+class SystemData;
+
+void placeBookingHold(HoldBook& holds, const string& bookingID, RecordHandle booking, RecordHandle registration, long long now);
+void releaseBookingHold(HoldBook& holds, const string& bookingID);
+long long holdExpiry(const HoldBook& holds, const string& bookingID); // 0 when not held
+
+// Gives every Pending booking without a hold a fresh one, and links each
+// hold to its booking and registration; used after loading
+void adoptPendingBookings(SystemData& data, long long now);
+
+// Cancels the Pending bookings whose hold ran out, releases their slots
+// (promoting waitlists) and saves once. Costs O(1) when nothing is due and
+// O(expired log n) otherwise. Returns the cancelled booking IDs.
+vector<string> sweepExpiredHolds(SystemData& data, long long now);
+
+// Menu-boundary hook: sweeps and tells the user what expired
+void runHoldSweep(SystemData& data);
+
+#endif
@@ -0,0 +1,87 @@
+#include "booking_lifecycle.h"
+#include <iostream>
+#include <atomic>
+#include "system_data.h"
+#include "file_operation.h"
+#include "utility_fun.h"
+#include "clock.h"
+
+using namespace std;
+
+static atomic<int> compactionHolds{ 0 };
+
+void trackConfirmedBooking(LifecycleIndex& index, const string& bookingID, int eventDay, RecordHandle booking) {
+    index.byEventDay[eventDay].push_back({ bookingID, booking });
+}
+
+void rebuildLifecycleIndex(SystemData& data) {
+    data.lifecycle = LifecycleIndex();
+    for (auto it = data.bookings.begin(); it != data.bookings.end(); ++it) {
+        if (it->bookingStatus == "Confirmed") {
+            trackConfirmedBooking(data.lifecycle, it->bookingID, it->eventDate.toDayNumber(), it.handle());
+        }
+    }
+}
+
+vector<string> completePastBookings(SystemData& data, int today) {
+    LifecycleIndex& index = data.lifecycle;
+    vector<string> completed;
+
+    if (today != index.lastSweptDay) {
+        index.lastSweptDay = today;
+        advanceTrendWindows(data.ratingTrends, today);
+    }
+
+    auto passedEnd = index.byEventDay.lower_bound(today);
+    for (auto day = index.byEventDay.begin(); day != passedEnd; ++day) {
+        for (const auto& entry : day->second) {
+            EventBooking* tracked = data.bookings.find(entry.booking);
+            if (tracked == nullptr || tracked->bookingID != entry.bookingID || tracked->bookingStatus != "Confirmed") {
+                continue;
+            }
+            EventBooking& booking = *tracked;
+            booking.bookingStatus = "Completed";
+            recordBookingInCube(data.revenue, booking);
+            data.changes.publish(ChangeKind::BookingCompleted, booking.bookingID, booking.eventReg.organizer.userID, booking.finalCost);
+            completed.push_back(booking.bookingID);
+        }
+    }
+    index.byEventDay.erase(index.byEventDay.begin(), passedEnd);
+
+    if (!completed.empty()) {
+        saveBookingsToFile(data.bookings);
+    }
+    return completed;
+}
+
+void runHousekeeping(SystemData& data) {
+    runHoldSweep(data);
+
+    vector<string> completed = completePastBookings(data, getCurrentDate().toDayNumber());
+    if (!completed.empty()) {
+        cout << completed.size() << " booking(s) took place and are now Completed." << endl;
+    }
+
+    // Nothing holds a record reference between menus, so this is the
+    // safe point to drop tombstones
+    if (compactionHolds.load() > 0) {
+        return;
+    }
+    if (data.registrations.needsCompaction()) {
+        data.registrations.compact();
+    }
+    if (data.bookings.needsCompaction()) {
+        data.bookings.compact();
+    }
+    if (data.feedbacks.needsCompaction()) {
+        data.feedbacks.compact();
+    }
+}
+
+void holdCompaction() {
+    compactionHolds++;
+}
+
+void releaseCompaction() {
+    compactionHolds--;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef BOOKING_LIFECYCLE_H
+#define BOOKING_LIFECYCLE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include "record_table.h"
+using namespace std;
+
+struct LifecycleEntry {
+    string bookingID;
+    RecordHandle booking;           // into data.bookings
+};
+
+// Confirmed bookings ordered by event day. Bookings that are cancelled or
+// refunded stay in here and are skipped when their day comes up.
+struct LifecycleIndex {
+    map<int, vector<LifecycleEntry>> byEventDay;
+    int lastSweptDay = 0;
+};
+
+// Forward declarations
+class SystemData;
+
+void trackConfirmedBooking(LifecycleIndex& index, const string& bookingID, int eventDay, RecordHandle booking);
+void rebuildLifecycleIndex(SystemData& data);
+
+// Moves Confirmed bookings whose event day is before today to Completed,
+// oldest day first, and keeps the revenue rollups and rating windows in
+// step. Only days that have just passed are visited. Returns the
+// completed booking IDs.
+vector<string> completePastBookings(SystemData& data, int today);
+
+// Menu-boundary jobs: payment hold expiry, the booking lifecycle, then
+// compaction of record tables that have built up tombstones
+void runHousekeeping(SystemData& data);
+
+// Compaction moves records, so while anyone may keep record references
+// across a menu boundary (a remote menu session parked at a prompt) it
+// is held off. Holds nest; compaction resumes when the last is released.
+void holdCompaction();
+void releaseCompaction();
+
+#endif
@@ -0,0 +1,201 @@
+#include "booking_transaction.h"
+#include <unordered_map>
+#include "system_data.h"
+#include "utility_fun.h"
+#include "file_operation.h"
+#include "venue.h"
+
+using namespace std;
+
+size_t stageBooking(BookingTransaction& transaction, RecordHandle registration, int venue, const Date& date, const string& time) {
+    StagedBooking booking;
+    booking.registration = registration;
+    booking.venue = venue;
+    booking.date = date;
+    booking.time = time;
+    transaction.staged.push_back(booking);
+    return transaction.staged.size() - 1;
+}
+
+vector<BookingConflict> validateTransaction(const SystemData& data, const BookingTransaction& transaction) {
+    vector<BookingConflict> conflicts;
+    unordered_map<string, size_t> claimedSlots;         // venueID|date|time -> staged index
+    unordered_map<uint32_t, size_t> firstPart;          // registration -> first staged index
+    unordered_map<uint32_t, int> groupCapacity;         // registration -> seats across its venues
+    unordered_map<uint32_t, bool> groupOverride;
+    int today = getCurrentDate().toDayNumber();   // today itself can still be booked, as at the console
+
+    // Active bookings of the staged events, gathered in one pass
+    unordered_map<string, vector<const EventBooking*>> activeByEvent;
+    for (const auto& staged : transaction.staged) {
+        if (const EventRegistration* reg = data.registrations.find(staged.registration)) {
+            activeByEvent.try_emplace(reg->eventID);
+        }
+    }
+    for (const auto& existing : data.bookings) {
+        auto event = activeByEvent.find(existing.eventReg.eventID);
+        if (event != activeByEvent.end() && existing.bookingStatus != "Cancelled") {
+            event->second.push_back(&existing);
+        }
+    }
+
+    for (size_t i = 0; i < transaction.staged.size(); i++) {
+        const StagedBooking& staged = transaction.staged[i];
+        if (data.registrations.find(staged.registration) == nullptr ||
+            staged.venue < 0 || staged.venue >= static_cast<int>(data.venues.size())) {
+            conflicts.push_back({ i, "Unknown registration or venue." });
+            continue;
+        }
+
+        const EventRegistration& reg = data.registrations[staged.registration];
+        const Venue& venue = data.venues[staged.venue];
+
+        auto first = firstPart.find(staged.registration.id);
+        if (first == firstPart.end()) {
+            firstPart[staged.registration.id] = i;
+            if (reg.eventStatus != "UNSCHEDULED") {
+                conflicts.push_back({ i, reg.eventID + " is " + reg.eventStatus + ", not waiting to be scheduled." });
+            }
+        }
+        else {
+            const StagedBooking& lead = transaction.staged[first->second];
+            if (lead.date.toDayNumber() != staged.date.toDayNumber() || lead.time != staged.time) {
+                conflicts.push_back({ i, "Group launch parts of " + reg.eventID + " must share one date and time." });
+            }
+        }
+        groupCapacity[staged.registration.id] += venue.capacity;
+        groupOverride[staged.registration.id] = groupOverride[staged.registration.id] || staged.allowOverCapacity;
+
+        string slotKey = venue.venueID + "|" + staged.date.toString() + "|" + staged.time;
+        auto claimed = claimedSlots.emplace(slotKey, i);
+        if (staged.date.toDayNumber() < today) {
+            conflicts.push_back({ i, staged.date.toString() + " has already passed." });
+        }
+        else if (!claimed.second) {
+            conflicts.push_back({ i, venue.venueName + " is staged twice for " + staged.date.toString() + " (" + staged.time + ")." });
+        }
+        else if (isVenueSlotClosed(data.venueIndex, staged.venue, staged.date, staged.time)) {
+            conflicts.push_back({ i, venue.venueName + " is closed on " + staged.date.toString() + " (" + staged.time + ")." });
+        }
+        else if (isVenueSlotTaken(data.venueIndex, staged.venue, staged.date, staged.time)) {
+            conflicts.push_back({ i, venue.venueName + " is already booked on " + staged.date.toString() + " (" + staged.time + ")." });
+        }
+        else if (!isVenueSlotFree(data.venueIndex, staged.venue, staged.date, staged.time)) {
+            conflicts.push_back({ i, venue.venueName + " can't be booked on " + staged.date.toString() + " (" + staged.time + ")." });
+        }
+
+        for (const EventBooking* existing : activeByEvent[reg.eventID]) {
+            if (existing->eventDate.toDayNumber() == staged.date.toDayNumber() && existing->eventTime == staged.time) {
+                conflicts.push_back({ i, reg.eventID + " already has booking " + existing->bookingID + " at this date and time." });
+                break;
+            }
+        }
+    }
+
+    for (const auto& group : groupCapacity) {
+        const EventRegistration& reg = data.registrations[RecordHandle{ group.first }];
+        if (group.second < reg.expectedGuests && !groupOverride[group.first]) {
+            conflicts.push_back({ firstPart[group.first], reg.eventID + " expects " + to_string(reg.expectedGuests) +
+                " guests but the venues seat " + to_string(group.second) + "." });
+        }
+    }
+    return conflicts;
+}
+
+TransactionResult commitTransaction(SystemData& data, const BookingTransaction& transaction) {
+    TransactionResult result;
+    result.conflicts = validateTransaction(data, transaction);
+    if (!result.conflicts.empty() || transaction.staged.empty()) {
+        return result;
+    }
+
+    // Grow containers up front so nothing below can fail halfway through
+    for (const auto& staged : transaction.staged) {
+        Venue& venue = data.venues[staged.venue];
+        venue.bookingSchedule.reserve(venue.bookingSchedule.size() + transaction.staged.size());
+    }
+
+    string firstID = generateBookingID(data.bookings);
+    int nextNumber = stoi(firstID.substr(3));
+
+    // Claim every slot before writing anything. Validation only saw a
+    // snapshot, so another session may have won a slot since; the first
+    // lost claim hands back the ones already taken and aborts.
+    vector<string> bookingIDs;
+    for (size_t i = 0; i < transaction.staged.size(); i++) {
+        const StagedBooking& staged = transaction.staged[i];
+        const Venue& venue = data.venues[staged.venue];
+        string bookingID = "BKG" + to_string(nextNumber + static_cast<int>(i));
+        ReserveResult claim = reserveVenueSlot(data.venueIndex, venue.venueID, staged.date, staged.time, bookingID);
+        if (claim != ReserveResult::Claimed) {
+            for (size_t j = 0; j < i; j++) {
+                const StagedBooking& claimed = transaction.staged[j];
+                releaseVenueSlot(data.venueIndex, data.venues[claimed.venue].venueID, claimed.date, claimed.time, bookingIDs[j]);
+            }
+            string when = staged.date.toString() + " (" + staged.time + ")";
+            result.conflicts.push_back({ i, claim == ReserveResult::Conflict
+                ? venue.venueName + " was just booked on " + when + "."
+                : venue.venueName + " can't be booked on " + when + "." });
+            return result;
+        }
+        bookingIDs.push_back(bookingID);
+    }
+
+    vector<RecordHandle> bookingHandles;
+    for (size_t i = 0; i < transaction.staged.size(); i++) {
+        const StagedBooking& staged = transaction.staged[i];
+        EventRegistration& reg = data.registrations[staged.registration];
+        Venue& venue = data.venues[staged.venue];
+
+        EventBooking booking;
+        booking.bookingID = bookingIDs[i];
+        booking.eventReg = reg;
+        booking.eventDate = staged.date;
+        booking.eventTime = staged.time;
+        booking.venue = venueDetails(venue);
+        booking.bookingStatus = "Pending";
+        booking.finalCost = venue.rentalCost + staged.logisticsCost;
+        booking.logisticsItems = staged.logisticsItems;
+        booking.logisticsCost = staged.logisticsCost;
+
+        TimeSlot slot;
+        slot.date = staged.date;
+        slot.time = staged.time;
+        slot.eventID = booking.bookingID;
+        slot.isBooked = true;
+        venue.bookingSchedule.push_back(slot);
+
+        bookingHandles.push_back(data.bookings.insert(booking));
+        recordBookingInCube(data.revenue, booking);
+        result.bookingIDs.push_back(booking.bookingID);
+    }
+
+    // Unpaid bookings only keep their slots until the payment deadline
+    long long now = currentTimestamp();
+    for (size_t i = 0; i < transaction.staged.size(); i++) {
+        placeBookingHold(data.holds, bookingIDs[i], bookingHandles[i], transaction.staged[i].registration, now);
+    }
+
+    // After the loop so every part of a group launch copies the same registration
+    for (const auto& staged : transaction.staged) {
+        data.registrations[staged.registration].eventStatus = "SCHEDULED";
+    }
+
+    // Single flush for the whole transaction
+    saveVenuesToFile(data.venues);
+    saveRegistrationsToFile(data.registrations);
+    saveBookingsToFile(data.bookings);
+    saveHoldsToFile(data.holds);
+
+    for (size_t i = 0; i < transaction.staged.size(); i++) {
+        const EventBooking& booking = data.bookings[bookingHandles[i]];
+        data.changes.publish(ChangeKind::BookingCreated, booking.bookingID, booking.eventReg.organizer.userID, booking.finalCost);
+    }
+    for (const auto& staged : transaction.staged) {
+        const EventRegistration& reg = data.registrations[staged.registration];
+        data.changes.publish(ChangeKind::RegistrationUpdated, reg.eventID, reg.organizer.userID);
+    }
+
+    result.committed = true;
+    return result;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#ifndef BOOKING_TRANSACTION_H
+#define BOOKING_TRANSACTION_H
+
+#include <string>
+#include <vector>
+#include "date.h"
+#include "money.h"
+#include "record_table.h"
+using namespace std;
+
+// One booking waiting in a transaction
+struct StagedBooking {
+    RecordHandle registration;          // into data.registrations
+    int venue;                          // index into data.venues
+    Date date;
+    string time;
+    vector<string> logisticsItems;
+    Money logisticsCost;
+    bool allowOverCapacity = false;     // organizer accepted a venue smaller than expectedGuests
+};
+
+// Bookings that succeed or fail together. A registration staged more than
+// once is a multi-venue group launch: every part must share the same date
+// and time, and the venues together must seat the expected guests.
+struct BookingTransaction {
+    vector<StagedBooking> staged;
+};
+
+struct BookingConflict {
+    size_t stagedIndex;                 // position in BookingTransaction::staged
+    string reason;
+};
+
+struct TransactionResult {
+    bool committed = false;
+    vector<string> bookingIDs;          // in staged order, when committed
+    vector<BookingConflict> conflicts;  // why it was rejected, otherwise
+};
+
+// Forward declarations
+class SystemData;
+
+size_t stageBooking(BookingTransaction& transaction, RecordHandle registration, int venue, const Date& date, const string& time);
+
+// Check every staged booking against the data and against each other
+vector<BookingConflict> validateTransaction(const SystemData& data, const BookingTransaction& transaction);
+
+// Validate, then apply every booking, schedule slot and status change and
+// save once; on any conflict nothing is changed
+TransactionResult commitTransaction(SystemData& data, const BookingTransaction& transaction);
+
+#endif
@@ -0,0 +1,159 @@
+#include "cascade.h"
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "system_data.h"
+#include "file_operation.h"
+#include "utility_fun.h"
+#include "input_validation.h"
+
+using namespace std;
+
+bool CascadePlan::empty() const {
+    return cancelRegistrations.empty() && deleteRegistrations.empty() && unscheduleRegistrations.empty() &&
+        cancelBookings.empty() && deleteBookings.empty();
+}
+
+int planManufacturerWithdrawal(const SystemData& data, CascadePlan& plan, const string& organizerID,
+    const string& manufacturer, const Date& from, const Date& to) {
+    string normalizedOrganizer = normalizeUserID(organizerID);
+    string wantedManufacturer = toUpperCase(manufacturer);
+    int firstDay = from.toDayNumber();
+    int lastDay = to.toDayNumber();
+
+    int added = 0;
+    for (const auto& booking : data.bookings) {
+        int day = booking.eventDate.toDayNumber();
+        if (booking.bookingStatus == "Cancelled" || booking.bookingStatus == "Completed" ||
+            day < firstDay || day > lastDay ||
+            toUpperCase(booking.eventReg.manufacturer) != wantedManufacturer ||
+            normalizeUserID(booking.eventReg.organizer.userID) != normalizedOrganizer) {
+            continue;
+        }
+        if (plan.cancelRegistrations.insert(booking.eventReg.eventID).second) {
+            added++;
+        }
+    }
+    return added;
+}
+
+vector<ReleasedSlot> removeScheduleEntries(SystemData& data, const unordered_map<int, unordered_set<string>>& leaving) {
+    vector<ReleasedSlot> released;
+    for (const auto& venueEntries : leaving) {
+        Venue& venue = data.venues[venueEntries.first];
+        const unordered_set<string>& bookingIDs = venueEntries.second;
+        auto removed = remove_if(venue.bookingSchedule.begin(), venue.bookingSchedule.end(), [&](const TimeSlot& slot) {
+            if (bookingIDs.find(slot.eventID) == bookingIDs.end()) {
+                return false;
+            }
+            releaseVenueSlot(data.venueIndex, venue.venueID, slot.date, slot.time, slot.eventID);
+            released.push_back({ venue.venueID, slot.date, slot.time });
+            return true;
+            });
+        venue.bookingSchedule.erase(removed, venue.bookingSchedule.end());
+    }
+    return released;
+}
+
+int offerReleasedSlots(SystemData& data, const vector<ReleasedSlot>& released) {
+    int promotions = 0;
+    for (const auto& slot : released) {
+        if (!promoteFromWaitlist(data, slot.venueID, slot.date, slot.time).empty()) {
+            promotions++;
+        }
+    }
+    return promotions;
+}
+
+CascadeResult applyCascade(SystemData& data, const CascadePlan& plan) {
+    CascadeResult result;
+    if (plan.empty()) {
+        return result;
+    }
+
+    auto contains = [](const unordered_set<string>& set, const string& key) {
+        return set.find(key) != set.end();
+    };
+
+    // Pass 1: bookings. Collect which schedule entries go, per venue.
+    unordered_map<int, unordered_set<string>> leavingSchedule;   // venue position -> booking IDs
+    unordered_set<string> unscheduled;                           // registrations losing a booking
+
+    for (auto it = data.bookings.begin(); it != data.bookings.end(); ++it) {
+        EventBooking& booking = *it;
+        const string& eventID = booking.eventReg.eventID;
+        bool erase = contains(plan.deleteRegistrations, eventID) || contains(plan.deleteBookings, booking.bookingID);
+        bool cancel = !erase && booking.bookingStatus != "Cancelled" && booking.bookingStatus != "Completed" &&
+            (contains(plan.cancelRegistrations, eventID) || contains(plan.unscheduleRegistrations, eventID) ||
+                contains(plan.cancelBookings, booking.bookingID));
+        if (!erase && !cancel) {
+            continue;
+        }
+
+        auto venue = data.venueIndex.positionOf.find(booking.venue.venueID);
+        if (venue != data.venueIndex.positionOf.end()) {
+            leavingSchedule[venue->second].insert(booking.bookingID);
+        }
+        releaseBookingHold(data.holds, booking.bookingID);
+
+        if (erase) {
+            removeBookingFromCube(data.revenue, booking.bookingID);
+            data.changes.publish(ChangeKind::BookingDeleted, booking.bookingID, booking.eventReg.organizer.userID);
+            data.bookings.erase(it.handle());
+            result.bookingsDeleted++;
+        }
+        else {
+            booking.bookingStatus = "Cancelled";
+            recordBookingInCube(data.revenue, booking);
+            data.changes.publish(ChangeKind::BookingCancelled, booking.bookingID, booking.eventReg.organizer.userID,
+                booking.finalCost);
+            if (contains(plan.cancelBookings, booking.bookingID)) {
+                unscheduled.insert(eventID);
+            }
+            result.bookingsCancelled++;
+        }
+    }
+
+    // Pass 2: only the schedules of venues that lose an entry
+    vector<ReleasedSlot> released = removeScheduleEntries(data, leavingSchedule);
+    result.slotsReleased = static_cast<int>(released.size());
+
+    // Pass 3: registrations
+    bool waitlistChanged = false;
+    for (auto it = data.registrations.begin(); it != data.registrations.end(); ++it) {
+        EventRegistration& reg = *it;
+        if (contains(plan.deleteRegistrations, reg.eventID)) {
+            waitlistChanged = removeWaitlistEntriesFor(data.waitlist, reg.eventID) > 0 || waitlistChanged;
+            data.changes.publish(ChangeKind::RegistrationDeleted, reg.eventID, reg.organizer.userID);
+            data.registrations.erase(it.handle());
+            result.registrationsDeleted++;
+            continue;
+        }
+        if (contains(plan.cancelRegistrations, reg.eventID)) {
+            if (reg.eventStatus != "CANCELLED") {
+                reg.eventStatus = "CANCELLED";
+                data.changes.publish(ChangeKind::RegistrationCancelled, reg.eventID, reg.organizer.userID);
+                result.registrationsCancelled++;
+            }
+            waitlistChanged = removeWaitlistEntriesFor(data.waitlist, reg.eventID) > 0 || waitlistChanged;
+        }
+        else if ((contains(plan.unscheduleRegistrations, reg.eventID) || contains(unscheduled, reg.eventID)) &&
+            reg.eventStatus != "CANCELLED" && reg.eventStatus != "UNSCHEDULED") {
+            reg.eventStatus = "UNSCHEDULED";
+            data.changes.publish(ChangeKind::RegistrationUpdated, reg.eventID, reg.organizer.userID);
+        }
+    }
+
+    // Single save for the whole cascade
+    saveVenuesToFile(data.venues);
+    saveRegistrationsToFile(data.registrations);
+    saveBookingsToFile(data.bookings);
+    saveHoldsToFile(data.holds);
+    if (waitlistChanged) {
+        saveWaitlistToFile(data.waitlist);
+    }
+
+    // Freed slots go to their waitlists only once the cascade is complete
+    result.waitlistPromotions = offerReleasedSlots(data, released);
+    return result;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#ifndef CASCADE_H
+#define CASCADE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "date.h"
+using namespace std;
+
+// Everything a cancellation or delete should change, collected before any
+// of it is applied. Keys are event IDs or booking IDs.
+struct CascadePlan {
+    unordered_set<string> cancelRegistrations;     // -> CANCELLED, active bookings cancelled
+    unordered_set<string> deleteRegistrations;     // erased together with all their bookings
+    unordered_set<string> unscheduleRegistrations; // active bookings cancelled, -> UNSCHEDULED
+    unordered_set<string> cancelBookings;          // these bookings only; registration -> UNSCHEDULED
+    unordered_set<string> deleteBookings;          // booking records erased
+
+    bool empty() const;
+};
+
+struct CascadeResult {
+    int registrationsCancelled = 0;
+    int registrationsDeleted = 0;
+    int bookingsCancelled = 0;
+    int bookingsDeleted = 0;
+    int slotsReleased = 0;
+    int waitlistPromotions = 0;
+};
+
+struct ReleasedSlot {
+    string venueID;
+    Date date;
+    string time;
+};
+
+// Forward declarations
+class SystemData;
+
+// Drops the given bookings' entries from the schedules of just those venues
+// (venue position -> booking IDs) and releases their claim cells
+vector<ReleasedSlot> removeScheduleEntries(SystemData& data, const unordered_map<int, unordered_set<string>>& leaving);
+
+// Hands each released slot to the head of its waitlist; returns promotions
+int offerReleasedSlots(SystemData& data, const vector<ReleasedSlot>& released);
+
+// Adds every registration of the organizer for this manufacturer that has an
+// active booking between from and to (inclusive). Returns how many were added.
+int planManufacturerWithdrawal(const SystemData& data, CascadePlan& plan, const string& organizerID,
+    const string& manufacturer, const Date& from, const Date& to);
+
+// Applies the plan with one pass over bookings and registrations
+// (tombstoned deletes), one pass over the schedule of each affected
+// venue, and a single save. Freed slots are then offered to their waitlists.
+CascadeResult applyCascade(SystemData& data, const CascadePlan& plan);
+
+#endif
@@ -0,0 +1,279 @@
+#include "change_feed.h"
+#include <fstream>
+#include "json.h"
+
+using namespace std;
+
+string changeKindName(ChangeKind kind) {
+    switch (kind) {
+    case ChangeKind::UserCreated: return "UserCreated";
+    case ChangeKind::UserUpdated: return "UserUpdated";
+    case ChangeKind::RegistrationCreated: return "RegistrationCreated";
+    case ChangeKind::RegistrationUpdated: return "RegistrationUpdated";
+    case ChangeKind::RegistrationCancelled: return "RegistrationCancelled";
+    case ChangeKind::RegistrationDeleted: return "RegistrationDeleted";
+    case ChangeKind::BookingCreated: return "BookingCreated";
+    case ChangeKind::BookingUpdated: return "BookingUpdated";
+    case ChangeKind::BookingConfirmed: return "BookingConfirmed";
+    case ChangeKind::BookingCancelled: return "BookingCancelled";
+    case ChangeKind::BookingCompleted: return "BookingCompleted";
+    case ChangeKind::BookingDeleted: return "BookingDeleted";
+    case ChangeKind::PaymentCompleted: return "PaymentCompleted";
+    case ChangeKind::PaymentRefunded: return "PaymentRefunded";
+    case ChangeKind::FeedbackSubmitted: return "FeedbackSubmitted";
+    case ChangeKind::FeedbackDeleted: return "FeedbackDeleted";
+    }
+    return "Unknown";
+}
+
+void appendChangeJson(string& out, const ChangeEvent& event) {
+    JsonWriter writer(out);
+    writer.beginObject()
+        .field("seq", static_cast<long long>(event.sequence))
+        .field("kind", changeKindName(event.kind))
+        .field("record", event.recordID)
+        .field("user", event.userID)
+        .field("amount", event.amount)
+        .field("at", static_cast<long long>(event.publishedAt))
+        .endObject();
+}
+
+// ---- ChangeSubscription ----
+
+ChangeSubscription::ChangeSubscription(string name, size_t capacity, OverflowPolicy policy,
+    chrono::microseconds maxWait, function<void()> wake)
+    : name(move(name)), policy(policy), maxWait(maxWait), wake(move(wake)) {
+    this->capacity = 2;
+    while (this->capacity < capacity) {
+        this->capacity *= 2;
+    }
+    cells = make_unique<Cell[]>(this->capacity);
+    for (size_t i = 0; i < this->capacity; i++) {
+        cells[i].sequence.store(i, memory_order_relaxed);
+    }
+}
+
+// A cell is free for position pos when its sequence is pos, and holds the
+// event for pos once its sequence is pos + 1
+bool ChangeSubscription::tryPush(const ChangeEvent& event) {
+    uint64_t pos = enqueuePos.load(memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells[pos & (capacity - 1)];
+        uint64_t sequence = cell->sequence.load(memory_order_acquire);
+        if (sequence == pos) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (sequence < pos) {
+            return false;       // the consumer hasn't freed it: full
+        }
+        else {
+            pos = enqueuePos.load(memory_order_relaxed);
+        }
+    }
+    cell->event = event;
+    cell->sequence.store(pos + 1);
+
+    // The consumer stops only where the ring is empty, so it is asleep (or
+    // about to check again) exactly when it has caught up to this event
+    if (wake && dequeuePos.load() == pos) {
+        wake();
+    }
+    return true;
+}
+
+bool ChangeSubscription::tryPop(ChangeEvent& event) {
+    uint64_t pos = dequeuePos.load(memory_order_relaxed);
+    Cell& cell = cells[pos & (capacity - 1)];
+    if (cell.sequence.load() != pos + 1) {
+        return false;
+    }
+    event = move(cell.event);
+    cell.sequence.store(pos + capacity, memory_order_release);
+    dequeuePos.store(pos + 1);
+    delivered.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+void ChangeSubscription::deliver(const ChangeEvent& event) {
+    if (tryPush(event)) {
+        return;
+    }
+    if (policy == OverflowPolicy::Wait) {
+        waits.fetch_add(1, memory_order_relaxed);
+        auto deadline = chrono::steady_clock::now() + maxWait;
+        do {
+            if (wake) {
+                wake();
+            }
+            this_thread::yield();
+            if (tryPush(event)) {
+                return;
+            }
+        } while (chrono::steady_clock::now() < deadline);
+    }
+    dropped.fetch_add(1, memory_order_relaxed);
+}
+
+SubscriberStats ChangeSubscription::stats() const {
+    SubscriberStats result;
+    result.name = name;
+    result.delivered = delivered.load(memory_order_relaxed);
+    result.dropped = dropped.load(memory_order_relaxed);
+    result.waits = waits.load(memory_order_relaxed);
+    uint64_t popped = dequeuePos.load();   // first, so the difference can't go negative
+    result.backlog = static_cast<size_t>(enqueuePos.load() - popped);
+    result.capacity = capacity;
+    return result;
+}
+
+// ---- ChangeFeed ----
+
+ChangeFeed::~ChangeFeed() {
+    for (auto& slot : slots) {
+        delete slot.subscription.exchange(nullptr);
+    }
+}
+
+ChangeSubscription* ChangeFeed::subscribe(string name, size_t capacity, OverflowPolicy policy,
+    function<void()> wake, chrono::microseconds maxWait) {
+    lock_guard<mutex> guard(subscribing);
+    for (auto& slot : slots) {
+        if (slot.subscription.load() == nullptr) {
+            auto subscription = new ChangeSubscription(move(name), capacity, policy, maxWait, move(wake));
+            slot.subscription.store(subscription);
+            active.fetch_add(1);
+            return subscription;
+        }
+    }
+    return nullptr;
+}
+
+void ChangeFeed::unsubscribe(ChangeSubscription* subscription) {
+    if (subscription == nullptr) {
+        return;
+    }
+    lock_guard<mutex> guard(subscribing);
+    for (auto& slot : slots) {
+        if (slot.subscription.load() == subscription) {
+            slot.subscription.store(nullptr);
+            active.fetch_sub(1);
+            // Anyone who picked it up before the store is still counted here
+            while (slot.publishers.load() != 0) {
+                this_thread::yield();
+            }
+            delete subscription;
+            return;
+        }
+    }
+}
+
+void ChangeFeed::publish(ChangeKind kind, string_view recordID, string_view userID, Money amount) {
+    uint64_t sequence = nextSequence.fetch_add(1, memory_order_relaxed) + 1;
+    if (active.load() == 0) {
+        return;
+    }
+
+    ChangeEvent event;
+    event.sequence = sequence;
+    event.kind = kind;
+    event.recordID = recordID;
+    event.userID = userID;
+    event.amount = amount;
+    event.publishedAt = time(nullptr);
+
+    for (auto& slot : slots) {
+        if (slot.subscription.load(memory_order_relaxed) == nullptr) {
+            continue;
+        }
+        slot.publishers.fetch_add(1);
+        ChangeSubscription* subscription = slot.subscription.load();
+        if (subscription != nullptr) {
+            subscription->deliver(event);
+        }
+        slot.publishers.fetch_sub(1);
+    }
+}
+
+vector<SubscriberStats> ChangeFeed::subscriberStats() const {
+    lock_guard<mutex> guard(subscribing);
+    vector<SubscriberStats> result;
+    for (const auto& slot : slots) {
+        if (const ChangeSubscription* subscription = slot.subscription.load()) {
+            result.push_back(subscription->stats());
+        }
+    }
+    return result;
+}
+
+// ---- ChangeListener ----
+
+ChangeListener::ChangeListener(ChangeFeed& feed, string name, OverflowPolicy policy,
+    function<void(const ChangeEvent&)> handle, function<void()> drained, size_t capacity)
+    : feed(feed), handle(move(handle)), drained(move(drained)) {
+    subscription = feed.subscribe(move(name), capacity, policy, [this] {
+        signal.fetch_add(1);
+        signal.notify_one();
+        });
+    if (subscription != nullptr) {
+        worker = thread([this] { run(); });
+    }
+}
+
+ChangeListener::~ChangeListener() {
+    if (subscription == nullptr) {
+        return;
+    }
+    stopping = true;
+    signal.fetch_add(1);
+    signal.notify_one();
+    worker.join();
+    feed.unsubscribe(subscription);
+}
+
+void ChangeListener::run() {
+    ChangeEvent event;
+    while (true) {
+        uint32_t seen = signal.load();
+        // Read before draining, so whatever was queued before the stop is handled
+        bool stop = stopping.load();
+        bool any = false;
+        while (subscription->tryPop(event)) {
+            handle(event);
+            any = true;
+        }
+        if (any && drained) {
+            drained();
+        }
+        if (stop) {
+            return;
+        }
+        signal.wait(seen);
+    }
+}
+
+unique_ptr<ChangeListener> startChangeLog(ChangeFeed& feed, const string& path) {
+    auto file = make_shared<ofstream>(path, ios::app);
+    if (!file->is_open()) {
+        return nullptr;
+    }
+    auto line = make_shared<string>();
+    auto listener = make_unique<ChangeListener>(feed, "change log " + path, OverflowPolicy::Wait,
+        [file, line](const ChangeEvent& event) {
+            appendChangeJson(*line, event);
+            *line += '\n';
+            // Written in batches rather than line by line
+            if (line->size() >= 65536) {
+                file->write(line->data(), static_cast<streamsize>(line->size()));
+                line->clear();
+            }
+        },
+        [file, line] {
+            file->write(line->data(), static_cast<streamsize>(line->size()));
+            line->clear();
+            file->flush();
+        });
+    return listener->subscribed() ? move(listener) : nullptr;
+}
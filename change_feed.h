@@ -0,0 +1,178 @@
+#pragma once
+#ifndef CHANGE_FEED_H
+#define CHANGE_FEED_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "money.h"
+using namespace std;
+
+enum class ChangeKind : uint8_t {
+    UserCreated,
+    UserUpdated,
+    RegistrationCreated,
+    RegistrationUpdated,        // details, products or scheduling status
+    RegistrationCancelled,
+    RegistrationDeleted,
+    BookingCreated,
+    BookingUpdated,             // time, venue, logistics or status rolled back
+    BookingConfirmed,
+    BookingCancelled,
+    BookingCompleted,
+    BookingDeleted,
+    PaymentCompleted,
+    PaymentRefunded,
+    FeedbackSubmitted,
+    FeedbackDeleted,
+};
+
+// One committed change. recordID is the record's own ID: a userID,
+// eventID, bookingID, paymentID or feedbackID by kind.
+struct ChangeEvent {
+    uint64_t sequence = 0;      // publication order, from 1
+    ChangeKind kind = ChangeKind::UserUpdated;
+    string recordID;
+    string userID;              // organizer the record belongs to
+    Money amount;               // booking cost or payment amount; zero otherwise
+    time_t publishedAt = 0;
+};
+
+string changeKindName(ChangeKind kind);             // e.g. "BookingConfirmed"
+
+// {"seq":12,"kind":"BookingConfirmed","record":"BKG0007","user":"USER1001","amount":"1234.50","at":1790000000}
+void appendChangeJson(string& out, const ChangeEvent& event);
+
+// What publishing does when a subscriber's ring is full
+enum class OverflowPolicy {
+    Drop,       // count the event as dropped; writers never wait
+    Wait,       // hold the writer until there is room, up to a limit, then drop
+};
+
+struct SubscriberStats {
+    string name;
+    uint64_t delivered = 0;
+    uint64_t dropped = 0;
+    uint64_t waits = 0;         // publishes that found the ring full
+    size_t backlog = 0;
+    size_t capacity = 0;
+};
+
+// Bounded lock-free ring of one subscriber: any number of publishers push
+// (a slot is claimed with one compare-exchange and published by its
+// sequence word), and the one consumer pops. wake, if set, is called by
+// the publisher whose push found the ring empty; drain the ring fully
+// before waiting for the next wake.
+class ChangeSubscription {
+public:
+    ChangeSubscription(string name, size_t capacity, OverflowPolicy policy,
+        chrono::microseconds maxWait, function<void()> wake);
+    ChangeSubscription(const ChangeSubscription&) = delete;
+    ChangeSubscription& operator=(const ChangeSubscription&) = delete;
+
+    // Consumer side; false when nothing is waiting
+    bool tryPop(ChangeEvent& event);
+    SubscriberStats stats() const;
+
+private:
+    friend class ChangeFeed;
+
+    struct Cell {
+        atomic<uint64_t> sequence;
+        ChangeEvent event;
+    };
+
+    string name;
+    OverflowPolicy policy;
+    chrono::microseconds maxWait;
+    function<void()> wake;
+    size_t capacity;            // a power of two
+    unique_ptr<Cell[]> cells;
+    atomic<uint64_t> enqueuePos{ 0 };
+    atomic<uint64_t> dequeuePos{ 0 };
+    atomic<uint64_t> delivered{ 0 };
+    atomic<uint64_t> dropped{ 0 };
+    atomic<uint64_t> waits{ 0 };
+
+    bool tryPush(const ChangeEvent& event);
+    void deliver(const ChangeEvent& event);
+};
+
+// Fan-out point for every mutation of users, registrations, bookings,
+// payments and feedback. Each subscriber gets its own ring and consumes at
+// its own pace: a Drop subscriber that falls behind loses events (counted),
+// a Wait subscriber slows the writers down instead. Changes to one record
+// arrive in the order they were made; changes to different records made at
+// the same time may arrive slightly out of sequence order. With nobody
+// subscribed, publishing only counts.
+class ChangeFeed {
+public:
+    static const int MAX_SUBSCRIBERS = 16;
+
+    ChangeFeed() = default;
+    ~ChangeFeed();
+    ChangeFeed(const ChangeFeed&) = delete;
+    ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+    // Null when every slot is taken. The feed owns the subscription.
+    ChangeSubscription* subscribe(string name, size_t capacity, OverflowPolicy policy,
+        function<void()> wake = nullptr, chrono::microseconds maxWait = chrono::milliseconds(50));
+    // Waits for publishers still pushing to it, then frees it
+    void unsubscribe(ChangeSubscription* subscription);
+
+    void publish(ChangeKind kind, string_view recordID, string_view userID, Money amount = Money());
+
+    uint64_t published() const { return nextSequence.load(memory_order_relaxed); }
+    vector<SubscriberStats> subscriberStats() const;
+
+private:
+    struct Slot {
+        atomic<ChangeSubscription*> subscription{ nullptr };
+        atomic<int> publishers{ 0 };    // publishers that may be holding it
+    };
+
+    Slot slots[MAX_SUBSCRIBERS];
+    atomic<int> active{ 0 };
+    atomic<uint64_t> nextSequence{ 0 };
+    mutable mutex subscribing;          // subscribe, unsubscribe and stats only
+};
+
+// Consumes a subscription on its own thread: handle is called for every
+// event in order, and drained (if set) whenever the ring runs dry, e.g. to
+// flush a batch. In-process consumers (the change log, a cache dropping
+// entries whose records changed) are built on this.
+class ChangeListener {
+public:
+    ChangeListener(ChangeFeed& feed, string name, OverflowPolicy policy,
+        function<void(const ChangeEvent&)> handle, function<void()> drained = nullptr, size_t capacity = 4096);
+    ~ChangeListener();      // handles what is already queued, then stops
+    ChangeListener(const ChangeListener&) = delete;
+    ChangeListener& operator=(const ChangeListener&) = delete;
+
+    bool subscribed() const { return subscription != nullptr; }
+
+private:
+    ChangeFeed& feed;
+    function<void(const ChangeEvent&)> handle;
+    function<void()> drained;
+    atomic<uint32_t> signal{ 0 };
+    atomic<bool> stopping{ false };
+    ChangeSubscription* subscription = nullptr;
+    thread worker;
+
+    void run();
+};
+
+// File sink: appends every change to path as one JSON line. Writers wait
+// for it rather than lose events. Null if the file can't be opened.
+unique_ptr<ChangeListener> startChangeLog(ChangeFeed& feed, const string& path);
+
+#endif
@@ -0,0 +1,45 @@
+#include "clock.h"
+#include <ctime>
+
+using namespace std;
+
+long long SystemClock::now() const {
+    return static_cast<long long>(time(nullptr)) + offsetSeconds;
+}
+
+void SystemClock::startOn(const Date& today) {
+    offsetSeconds = 0;
+    long long realNow = now();
+    offsetSeconds = static_cast<long long>(today.toDayNumber()) * SECONDS_PER_DAY - (realNow - realNow % SECONDS_PER_DAY);
+}
+
+void ManualClock::setDate(const Date& date) {
+    current = static_cast<long long>(date.toDayNumber()) * SECONDS_PER_DAY;
+}
+
+static Clock* installedClock = nullptr;
+
+SystemClock& systemClock() {
+    static SystemClock clock;
+    return clock;
+}
+
+Clock& activeClock() {
+    return installedClock != nullptr ? *installedClock : systemClock();
+}
+
+void setActiveClock(Clock* clock) {
+    installedClock = clock;
+}
+
+long long currentTimestamp() {
+    return activeClock().now();
+}
+
+Date dateOfTimestamp(long long seconds) {
+    long long days = seconds / SECONDS_PER_DAY;
+    if (seconds < 0 && seconds % SECONDS_PER_DAY != 0) {
+        days--;
+    }
+    return Date::fromDayNumber(static_cast<int>(days));
+}
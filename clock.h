@@ -0,0 +1,49 @@
+#pragma once
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "date.h"
+using namespace std;
+
+// Source of "now" for every date- or deadline-driven feature. Times are
+// seconds since 1970-01-01 UTC and dates are UTC calendar days.
+class Clock {
+public:
+    virtual ~Clock() = default;
+    virtual long long now() const = 0;
+};
+
+// Wall clock, optionally shifted so that "today" is a chosen date
+class SystemClock : public Clock {
+public:
+    long long now() const override;
+    void startOn(const Date& today);
+
+private:
+    long long offsetSeconds = 0;
+};
+
+// Stands still until told otherwise; for tests and simulations
+class ManualClock : public Clock {
+public:
+    explicit ManualClock(long long start = 0) : current(start) {}
+    long long now() const override { return current; }
+    void set(long long seconds) { current = seconds; }
+    void setDate(const Date& date);
+    void advance(long long seconds) { current += seconds; }
+
+private:
+    long long current;
+};
+
+const long long SECONDS_PER_DAY = 24 * 60 * 60;
+
+// The clock everything reads; nullptr restores the system clock
+Clock& activeClock();
+void setActiveClock(Clock* clock);
+SystemClock& systemClock();
+
+long long currentTimestamp();
+Date dateOfTimestamp(long long seconds);
+
+#endif
@@ -0,0 +1,74 @@
+#include "console_input.h"
+#include <iostream>
+
+using namespace std;
+
+static bool headlessMode = false;
+static deque<string> scriptedAnswers;
+static thread_local LineSource threadInputSource;
+static thread_local PromptWaitHook promptWaitHook;
+
+bool readInputLine(string& line) {
+    if (threadInputSource) {
+        return threadInputSource(line);
+    }
+    if (!headlessMode) {
+        WaitingForInput waiting;
+        return static_cast<bool>(getline(cin, line));
+    }
+    if (scriptedAnswers.empty()) {
+        throw ScriptInputExhausted();
+    }
+    line = move(scriptedAnswers.front());
+    scriptedAnswers.pop_front();
+    cout << line << endl;   // echo, so the transcript reads like a session
+    return true;
+}
+
+void rejectScriptedAnswer() {
+    if (headlessMode) {
+        throw ScriptInputRejected();
+    }
+}
+
+void setHeadless(bool headless) {
+    headlessMode = headless;
+}
+
+bool isHeadless() {
+    return headlessMode;
+}
+
+void queueScriptedAnswers(deque<string> answers) {
+    scriptedAnswers = move(answers);
+}
+
+size_t discardScriptedAnswers() {
+    size_t left = scriptedAnswers.size();
+    scriptedAnswers.clear();
+    return left;
+}
+
+void setThreadInputSource(LineSource source) {
+    threadInputSource = move(source);
+}
+
+bool hasThreadInputSource() {
+    return static_cast<bool>(threadInputSource);
+}
+
+void setPromptWaitHook(PromptWaitHook hook) {
+    promptWaitHook = move(hook);
+}
+
+WaitingForInput::WaitingForInput() {
+    if (promptWaitHook) {
+        promptWaitHook(true);
+    }
+}
+
+WaitingForInput::~WaitingForInput() {
+    if (promptWaitHook) {
+        promptWaitHook(false);
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#ifndef CONSOLE_INPUT_H
+#define CONSOLE_INPUT_H
+
+#include <string>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+using namespace std;
+
+// Thrown when a scripted command needs more answers than it was given,
+// so a prompt never blocks or loops in headless mode
+class ScriptInputExhausted : public runtime_error {
+public:
+    ScriptInputExhausted() : runtime_error("command needs more arguments than were given") {}
+};
+
+// Thrown when validation turns a scripted answer down; retrying would
+// shift every later answer onto the wrong prompt
+class ScriptInputRejected : public runtime_error {
+public:
+    ScriptInputRejected() : runtime_error("an argument was rejected by its prompt") {}
+};
+
+// Every prompt reads through here. Interactive sessions read stdin; in
+// headless mode the answers come from the queue filled by the script
+// runner, and screen clears and pauses are skipped.
+bool readInputLine(string& line);
+
+// Validation calls this when it turns an answer down; throws
+// ScriptInputRejected in headless mode, does nothing interactively
+void rejectScriptedAnswer();
+
+void setHeadless(bool headless);
+bool isHeadless();
+void queueScriptedAnswers(deque<string> answers);
+size_t discardScriptedAnswers();            // returns how many were left unused
+
+// Remote menu sessions: the calling thread takes its answers from source
+// instead of stdin, and screen clears and pauses go to its own output.
+// Pass an empty source to go back to the console.
+using LineSource = function<bool(string&)>;
+void setThreadInputSource(LineSource source);
+bool hasThreadInputSource();
+
+// Interactive console: the calling thread's hook is called with true just
+// before a prompt blocks on stdin and with false once it has the answer,
+// so the session can let go of the data while the operator types
+using PromptWaitHook = function<void(bool waiting)>;
+void setPromptWaitHook(PromptWaitHook hook);
+
+// Brackets any other wait on the operator (pauseScreen) with the hook
+class WaitingForInput {
+public:
+    WaitingForInput();
+    ~WaitingForInput();
+    WaitingForInput(const WaitingForInput&) = delete;
+    WaitingForInput& operator=(const WaitingForInput&) = delete;
+};
+
+#endif
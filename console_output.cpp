@@ -0,0 +1,272 @@
+#include "console_output.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <conio.h>
+#include <io.h>
+#else
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// A screen bigger than this goes out in parts, so a long report still
+// shows progress and doesn't pile up in memory
+static const size_t MAX_FRAME_BYTES = 1 << 20;
+
+static bool stdoutIsTerminal() {
+#ifdef _WIN32
+    return _isatty(_fileno(stdout)) != 0;
+#else
+    return isatty(STDOUT_FILENO) != 0;
+#endif
+}
+
+static bool stdinIsTerminal() {
+#ifdef _WIN32
+    return _isatty(_fileno(stdin)) != 0;
+#else
+    return isatty(STDIN_FILENO) != 0;
+#endif
+}
+
+// Older Windows consoles only understand ANSI sequences once asked to
+static bool enableAnsiSequences() {
+#ifdef _WIN32
+    HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (!GetConsoleMode(output, &mode)) {
+        return !stdoutIsTerminal();     // redirected: the bytes are just kept
+    }
+    return SetConsoleMode(output, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+#else
+    return true;
+#endif
+}
+
+static void writeToTerminal(const string& text) {
+#ifdef _WIN32
+    DWORD written = 0;
+    WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), text.data(), static_cast<DWORD>(text.size()), &written, nullptr);
+#else
+    size_t done = 0;
+    while (done < text.size()) {
+        ssize_t written = write(STDOUT_FILENO, text.data() + done, text.size() - done);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        done += static_cast<size_t>(written);
+    }
+#endif
+}
+
+static void runShellClear() {
+#ifdef _WIN32
+    system("cls");
+#else
+    system("clear");
+#endif
+}
+
+// cout while screens are active. Background threads (the persistence
+// thread's error messages) print too, hence the lock.
+class FrameOutput : public streambuf {
+public:
+    FrameOutput(bool plain, bool ansi) : plain(plain), ansi(ansi) {}
+
+    bool usesShell() const { return plain || !ansi; }
+
+    // The operator is about to be waited on: the screen is complete
+    void endFrame() {
+        lock_guard<mutex> guard(lock);
+        emit();
+        if (started) {
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - startedAt).count();
+            counters.frames++;
+            counters.totalMs += ms;
+            counters.maxMs = max(counters.maxMs, ms);
+            started = false;
+        }
+    }
+
+    void clear() {
+        if (usesShell()) {
+            {
+                lock_guard<mutex> guard(lock);
+                begin();
+                emit();
+            }
+            runShellClear();
+            return;
+        }
+        lock_guard<mutex> guard(lock);
+        begin();
+        // Whatever was drawn since the last wait would be wiped at once
+        if (stdoutIsTerminal()) {
+            frame.clear();
+        }
+        frame += "\033[2J\033[H";
+    }
+
+    FrameStats stats() const {
+        lock_guard<mutex> guard(lock);
+        return counters;
+    }
+
+protected:
+    int overflow(int c) override {
+        if (c != EOF) {
+            char ch = static_cast<char>(c);
+            xsputn(&ch, 1);
+        }
+        return traits_type::not_eof(c);
+    }
+    streamsize xsputn(const char* text, streamsize count) override {
+        lock_guard<mutex> guard(lock);
+        begin();
+        frame.append(text, static_cast<size_t>(count));
+        if (frame.size() >= MAX_FRAME_BYTES) {
+            emit();
+        }
+        return count;
+    }
+    // endl: plain output goes out now, a composed screen waits for its end
+    int sync() override {
+        if (plain) {
+            lock_guard<mutex> guard(lock);
+            emit();
+        }
+        return 0;
+    }
+
+private:
+    const bool plain;
+    const bool ansi;
+    mutable mutex lock;
+    string frame;
+    bool started = false;
+    chrono::steady_clock::time_point startedAt;
+    FrameStats counters;
+
+    // Lock held for both
+    void begin() {
+        if (!started) {
+            started = true;
+            startedAt = chrono::steady_clock::now();
+        }
+    }
+    void emit() {
+        if (frame.empty()) {
+            return;
+        }
+        writeToTerminal(frame);
+        counters.writes++;
+        counters.bytes += static_cast<long long>(frame.size());
+        frame.clear();
+    }
+};
+
+static unique_ptr<FrameOutput> screen;
+static streambuf* console = nullptr;
+static FrameStats lastStats;
+
+// cin is tied to this, so every read of the operator's input ends the frame
+class FrameEnd : public streambuf {
+protected:
+    int sync() override {
+        if (screen) {
+            screen->endFrame();
+        }
+        return 0;
+    }
+};
+
+static FrameEnd frameEnd;
+static ostream inputTie(&frameEnd);
+static ostream* previousTie = nullptr;
+
+void startConsoleScreens(bool plain) {
+    if (screen) {
+        return;
+    }
+    cout.flush();
+    console = cout.rdbuf();
+    screen = make_unique<FrameOutput>(plain, enableAnsiSequences());
+    cout.rdbuf(screen.get());
+    previousTie = cin.tie(&inputTie);
+}
+
+void stopConsoleScreens() {
+    if (!screen) {
+        return;
+    }
+    screen->endFrame();
+    cin.tie(previousTie);
+    cout.rdbuf(console);
+    lastStats = screen->stats();
+    screen.reset();
+}
+
+bool consoleScreensActive() {
+    return screen != nullptr;
+}
+
+void clearConsoleScreen() {
+    screen->clear();
+}
+
+void waitForKeypress() {
+    screen->endFrame();
+    if (screen->usesShell()) {
+        system("pause");
+        return;
+    }
+    // Piped input has no keys to press
+    if (!stdinIsTerminal()) {
+        return;
+    }
+#ifdef _WIN32
+    _getch();
+#else
+    termios saved;
+    if (tcgetattr(STDIN_FILENO, &saved) != 0) {
+        return;
+    }
+    termios raw = saved;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    cin.get();
+    tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+#endif
+    cout << '\n';
+}
+
+FrameStats consoleFrameStats() {
+    return screen ? screen->stats() : lastStats;
+}
+
+string formatFrameStats(const FrameStats& stats) {
+    if (stats.frames == 0) {
+        return "Frames: 0";
+    }
+    double frames = static_cast<double>(stats.frames);
+    return format("Frames: {} | avg {:.2f} ms, max {:.2f} ms | {:.1f} writes, {:.0f} bytes per frame",
+        stats.frames, stats.totalMs / frames, stats.maxMs, stats.writes / frames, stats.bytes / frames);
+}
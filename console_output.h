@@ -0,0 +1,38 @@
+#pragma once
+#ifndef CONSOLE_OUTPUT_H
+#define CONSOLE_OUTPUT_H
+
+#include <string>
+using namespace std;
+
+// Interactive console screens. Once started, everything printed to cout is
+// composed into one frame and reaches the terminal in a single write when
+// the program next waits for the operator (any read from cin, or a pause),
+// so endl no longer flushes line by line. Screens are cleared with ANSI
+// sequences and pauses wait for a key in-process, without starting a shell.
+
+// Milliseconds are from the first output of a screen until all of it is
+// on the terminal
+struct FrameStats {
+    long long frames = 0;
+    long long writes = 0;       // writes to the terminal
+    long long bytes = 0;
+    double totalMs = 0;
+    double maxMs = 0;
+};
+
+// plain keeps the old way (a write per flush, the shell's clear and pause)
+// but still measures it, for comparison
+void startConsoleScreens(bool plain = false);
+void stopConsoleScreens();      // writes what is left and gives cout back
+bool consoleScreensActive();
+
+// What clearScreen and pauseScreen do while screens are active
+void clearConsoleScreen();
+void waitForKeypress();
+
+FrameStats consoleFrameStats();
+// "Frames: 42 | avg 0.31 ms, max 2.10 ms | 1.0 writes, 1830 bytes per frame"
+string formatFrameStats(const FrameStats& stats);
+
+#endif
@@ -0,0 +1,187 @@
+#include "data_locks.h"
+#include <algorithm>
+
+using namespace std;
+
+// FNV-1a over the trimmed, upper-cased ID, so every spelling normalizeUserID
+// treats as one user lands on one shard
+static int shardOf(string_view id) {
+    size_t first = id.find_first_not_of(" \t\n\r");
+    size_t last = id.find_last_not_of(" \t\n\r");
+    id = first == string_view::npos ? string_view() : id.substr(first, last - first + 1);
+
+    uint32_t hash = 2166136261u;
+    for (char c : id) {
+        char upper = c >= 'a' && c <= 'z' ? static_cast<char>(c - 32) : c;
+        hash = (hash ^ static_cast<unsigned char>(upper)) * 16777619u;
+    }
+    return static_cast<int>(hash % PARTITION_SHARDS);
+}
+
+int organizerShard(string_view userID) {
+    return shardOf(userID);
+}
+
+int venueShard(string_view venueID) {
+    return shardOf(venueID);
+}
+
+void RwLock::lock() {
+    uint32_t current = state.fetch_add(ONE_WAITING_WRITER) + ONE_WAITING_WRITER;
+    while (true) {
+        if ((current & WRITING) || (current & READERS)) {
+            state.wait(current);
+            current = state.load();
+        }
+        else if (state.compare_exchange_weak(current, (current - ONE_WAITING_WRITER) | WRITING)) {
+            return;
+        }
+    }
+}
+
+void RwLock::unlock() {
+    state.fetch_and(~WRITING);
+    state.notify_all();
+}
+
+void RwLock::lock_shared() {
+    uint32_t current = state.load();
+    while (true) {
+        // Writers waiting go first
+        if (current & ~READERS) {
+            state.wait(current);
+            current = state.load();
+        }
+        else if (state.compare_exchange_weak(current, current + 1)) {
+            return;
+        }
+    }
+}
+
+void RwLock::unlock_shared() {
+    uint32_t previous = state.fetch_sub(1);
+    // The last reader out lets a waiting writer in
+    if ((previous & READERS) == 1 && (previous & ~READERS) != 0) {
+        state.notify_all();
+    }
+}
+
+LockPlan& LockPlan::readsAllPartitions() {
+    organizerRead = venueRead = ALL_SHARDS;
+    return *this;
+}
+
+uint64_t DataLocks::stampOf(int collection, uint32_t shards) const {
+    uint64_t newest = 0;
+    for (int shard = 0; shard < PARTITION_SHARDS; shard++) {
+        if (shards & (1u << shard)) {
+            newest = max(newest, stamps[collection][shard].load(memory_order_acquire));
+        }
+    }
+    return newest;
+}
+
+// Called with the plan's locks still held, so a snapshot taken after they
+// are released sees the new stamps
+static void stampWrites(DataLocks& locks, const LockPlan& plan) {
+    uint64_t now = 0;
+    for (int collection = 0; collection < DATA_COLLECTIONS; collection++) {
+        uint32_t shards = 0;
+        if (plan.write & (1u << collection)) {
+            shards = plan.organizerWrite != 0 ? plan.organizerWrite : ALL_SHARDS;
+        }
+        else if (plan.read & (1u << collection)) {
+            shards = plan.organizerWrite;     // records changed in place
+        }
+        if (shards == 0) {
+            continue;
+        }
+        if (now == 0) {
+            now = ++locks.epoch;
+        }
+        for (int shard = 0; shard < PARTITION_SHARDS; shard++) {
+            if (shards & (1u << shard)) {
+                locks.stamps[collection][shard].store(now, memory_order_release);
+            }
+        }
+    }
+}
+
+// Exclusive where asked for, otherwise shared where asked for
+static void lockEach(RwLock* mutexes, int count, uint32_t shared, uint32_t exclusive) {
+    for (int i = 0; i < count; i++) {
+        if (exclusive & (1u << i)) {
+            mutexes[i].lock();
+        }
+        else if (shared & (1u << i)) {
+            mutexes[i].lock_shared();
+        }
+    }
+}
+
+static void unlockEach(RwLock* mutexes, int count, uint32_t shared, uint32_t exclusive) {
+    for (int i = count - 1; i >= 0; i--) {
+        if (exclusive & (1u << i)) {
+            mutexes[i].unlock();
+        }
+        else if (shared & (1u << i)) {
+            mutexes[i].unlock_shared();
+        }
+    }
+}
+
+void DataLockSet::lock(const LockPlan& plan) {
+    unlock();
+    current = plan;
+    if (plan.empty()) {
+        // nothing to take
+    }
+    else if (locks.singleLock) {
+        locks.collections[0].lock();
+    }
+    else {
+        lockEach(locks.collections, DATA_COLLECTIONS, plan.read, plan.write);
+        lockEach(locks.organizers, PARTITION_SHARDS, plan.organizerRead, plan.organizerWrite);
+        lockEach(locks.venues, PARTITION_SHARDS, plan.venueRead, plan.venueWrite);
+    }
+    held = true;
+}
+
+void DataLockSet::unlock() {
+    if (!held) {
+        return;
+    }
+    stampWrites(locks, current);
+    if (current.empty()) {
+        // nothing was taken
+    }
+    else if (locks.singleLock) {
+        locks.collections[0].unlock();
+    }
+    else {
+        unlockEach(locks.venues, PARTITION_SHARDS, current.venueRead, current.venueWrite);
+        unlockEach(locks.organizers, PARTITION_SHARDS, current.organizerRead, current.organizerWrite);
+        unlockEach(locks.collections, DATA_COLLECTIONS, current.read, current.write);
+    }
+    held = false;
+}
+
+static thread_local DataLockSet* sessionLocks = nullptr;
+
+void setSessionLocks(DataLockSet* locks) {
+    sessionLocks = locks;
+}
+
+SessionLockSection::SessionLockSection(const LockPlan& plan) : session(sessionLocks) {
+    if (session == nullptr) {
+        return;
+    }
+    previous = session->plan();
+    session->lock(plan);
+}
+
+SessionLockSection::~SessionLockSection() {
+    if (session != nullptr) {
+        session->lock(previous);
+    }
+}
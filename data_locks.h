@@ -0,0 +1,157 @@
+#pragma once
+#ifndef DATA_LOCKS_H
+#define DATA_LOCKS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+using namespace std;
+
+// Lockable parts of SystemData. Derived indexes go with the records they
+// are built from; the venue slot cells are atomic and need no lock.
+using DataMask = uint32_t;
+const DataMask USERS_DATA = 1u << 0;            // organizer
+const DataMask VENUES_DATA = 1u << 1;           // venues, venueIndex
+const DataMask REGISTRATIONS_DATA = 1u << 2;    // registrations
+const DataMask BOOKINGS_DATA = 1u << 3;         // bookings
+const DataMask PAYMENTS_DATA = 1u << 4;         // payments
+const DataMask FEEDBACK_DATA = 1u << 5;         // feedbacks, feedbackRatings, ratingTrends, feedbackSearch
+const DataMask SCHEDULE_DATA = 1u << 6;         // holds, waitlist, lifecycle
+const DataMask REVENUE_DATA = 1u << 7;          // revenue
+const int DATA_COLLECTIONS = 8;
+const DataMask ALL_DATA = (1u << DATA_COLLECTIONS) - 1;
+
+// Organizers and venues are spread over this many shards each
+const int PARTITION_SHARDS = 16;
+const uint32_t ALL_SHARDS = (1u << PARTITION_SHARDS) - 1;
+
+// Shared/exclusive lock that lets a waiting writer in ahead of new
+// readers. (glibc's shared_mutex favours readers, so a steady stream of
+// queries would hold a booking off forever.) Blocks on the state word
+// with C++20 atomic wait; usable with unique_lock and shared_lock.
+class RwLock {
+public:
+    void lock();
+    void unlock();
+    void lock_shared();
+    void unlock_shared();
+
+private:
+    static const uint32_t WRITING = 1u << 31;
+    static const uint32_t ONE_WAITING_WRITER = 1u << 16;    // bits 16-30 count waiting writers
+    static const uint32_t READERS = ONE_WAITING_WRITER - 1; // bits 0-15 count readers
+    atomic<uint32_t> state{ 0 };
+};
+
+// One shared/exclusive lock per collection, plus per-partition locks for
+// changing records in place. The rules:
+//   - Adding, erasing or moving records (push_back, compaction) needs the
+//     collection exclusively.
+//   - A record's changeable fields (a booking or registration status, a
+//     venue's schedule) may be changed under a shared collection lock by
+//     whoever holds the owning organizer's or venue's shard exclusively.
+//     So readers look at those fields only under the shard lock, or under
+//     every shard when they read everyone's records. The fields naming the
+//     owner never change in place.
+// Locks are always taken in one order (collections, organizer shards,
+// venue shards, each by number), which DataLockSet takes care of.
+//
+// Releasing a write lock first stamps what it may have changed with a new
+// epoch: the owner's shards of each collection written or changed in
+// place, or every shard of a collection held exclusively with no shard
+// named. Snapshots (data_snapshot.h) reuse whatever has not been stamped
+// since they last copied it.
+struct DataLocks {
+    RwLock collections[DATA_COLLECTIONS];
+    RwLock organizers[PARTITION_SHARDS];
+    RwLock venues[PARTITION_SHARDS];
+    atomic<uint64_t> epoch{ 0 };
+    atomic<uint64_t> stamps[DATA_COLLECTIONS][PARTITION_SHARDS] = {};
+    bool tracksWrites = false;  // set while every change goes through a DataLockSet
+    bool singleLock = false;    // benchmark baseline: everything behind one exclusive lock
+
+    // Newest stamp among the given shards of one collection
+    uint64_t stampOf(int collection, uint32_t shards) const;
+};
+
+int organizerShard(string_view userID);     // by normalized user ID
+int venueShard(string_view venueID);
+
+// The locks one operation needs. Exclusive wins where both are asked for.
+struct LockPlan {
+    DataMask read = 0;
+    DataMask write = 0;
+    uint32_t organizerRead = 0;     // shard bits
+    uint32_t organizerWrite = 0;
+    uint32_t venueRead = 0;
+    uint32_t venueWrite = 0;
+
+    LockPlan& reads(DataMask collections) { read |= collections; return *this; }
+    LockPlan& writes(DataMask collections) { write |= collections; return *this; }
+    LockPlan& readsOrganizer(string_view userID) { organizerRead |= 1u << organizerShard(userID); return *this; }
+    LockPlan& writesOrganizer(string_view userID) { organizerWrite |= 1u << organizerShard(userID); return *this; }
+    LockPlan& readsVenue(string_view venueID) { venueRead |= 1u << venueShard(venueID); return *this; }
+    LockPlan& writesVenue(string_view venueID) { venueWrite |= 1u << venueShard(venueID); return *this; }
+    LockPlan& readsAllPartitions();
+    bool empty() const { return (read | write | organizerRead | organizerWrite | venueRead | venueWrite) == 0; }
+};
+
+// Takes a plan's locks in the canonical order and releases them in
+// reverse. The plan is kept, so relock() takes the same set again.
+class DataLockSet {
+public:
+    explicit DataLockSet(DataLocks& locks) : locks(locks) {}
+    DataLockSet(DataLocks& locks, const LockPlan& plan) : locks(locks) { lock(plan); }
+    ~DataLockSet() { unlock(); }
+    DataLockSet(const DataLockSet&) = delete;
+    DataLockSet& operator=(const DataLockSet&) = delete;
+
+    void lock(const LockPlan& plan);
+    void relock() { lock(current); }
+    void unlock();
+    const LockPlan& plan() const { return current; }
+
+private:
+    DataLocks& locks;
+    LockPlan current;
+    bool held = false;
+};
+
+// The lock set of the session running on this thread, if any. A remote
+// menu session holds everything exclusively while it runs; see
+// ReadOnlySection.
+void setSessionLocks(DataLockSet* locks);
+
+// Inside a remote menu session, trades the session's locks for the given
+// plan until the section ends, then takes the old ones back. Elsewhere it
+// does nothing. Hold no record references across the start or end of a
+// section.
+class SessionLockSection {
+public:
+    explicit SessionLockSection(const LockPlan& plan);
+    ~SessionLockSection();
+    SessionLockSection(const SessionLockSection&) = delete;
+    SessionLockSection& operator=(const SessionLockSection&) = delete;
+
+private:
+    DataLockSet* session;
+    LockPlan previous;
+};
+
+// Marks a screen that only reads: shared locks on the given collections
+// and the current user's shard, so JSON readers keep going meanwhile.
+// Other menu sessions still wait; they take turns on the server's console.
+class ReadOnlySection : public SessionLockSection {
+public:
+    ReadOnlySection(DataMask collections, string_view userID)
+        : SessionLockSection(LockPlan().reads(collections).readsOrganizer(userID)) {}
+};
+
+// Marks code that reads only a pinned snapshot (data_snapshot.h): no
+// locks at all, so writers carry on at full speed
+class UnlockedSection : public SessionLockSection {
+public:
+    UnlockedSection() : SessionLockSection(LockPlan()) {}
+};
+
+#endif
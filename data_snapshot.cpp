@@ -0,0 +1,196 @@
+#include "data_snapshot.h"
+#include "system_data.h"
+#include "utility_fun.h"
+#include <algorithm>
+
+using namespace std;
+
+static const vector<EventRegistration> NO_REGISTRATIONS;
+static const vector<EventBooking> NO_BOOKINGS;
+static const vector<Payment> NO_PAYMENTS;
+
+const vector<EventRegistration>& DataSnapshot::registrationsOf(string_view userID) const {
+    const auto& part = registrations[organizerShard(userID)];
+    return part ? *part : NO_REGISTRATIONS;
+}
+
+const vector<EventBooking>& DataSnapshot::bookingsOf(string_view userID) const {
+    const auto& part = bookings[organizerShard(userID)];
+    return part ? *part : NO_BOOKINGS;
+}
+
+const vector<Payment>& DataSnapshot::allPayments() const {
+    return payments ? *payments : NO_PAYMENTS;
+}
+
+// Collection number of a single-bit DataMask, as DataLocks::stamps counts them
+static int collectionOf(DataMask collection) {
+    int index = 0;
+    while ((collection >> index) != 1u) {
+        index++;
+    }
+    return index;
+}
+
+// Drops retired parts no pinned snapshot can still hold. Store lock held.
+static void reclaim(SnapshotStore& store) {
+    uint64_t oldestPinned = store.pinned.empty() ? UINT64_MAX : store.pinned.begin()->first;
+    auto kept = remove_if(store.retired.begin(), store.retired.end(), [&](const RetiredPart& part) {
+        return part.generation <= oldestPinned;
+        });
+    store.counters.partsReclaimed += store.retired.end() - kept;
+    store.retired.erase(kept, store.retired.end());
+}
+
+template <typename Part>
+static void replacePart(SnapshotStore& store, CachedPart<Part>& cached, uint64_t stamp, shared_ptr<const Part> data, size_t bytes, uint64_t generation) {
+    if (cached.data) {
+        store.retired.push_back({ generation, move(cached.data), cached.bytes });
+    }
+    cached = { stamp, move(data), bytes };
+    store.counters.partsCopied++;
+}
+
+// Brings the cached shards of one table up to date in a single pass over
+// the records, copying only the shards written since they were cached
+template <typename Record, typename OwnerOf>
+static void refreshShards(SnapshotStore& store, CachedPart<vector<Record>> (&cached)[PARTITION_SHARDS],
+    shared_ptr<const vector<Record>> (&parts)[PARTITION_SHARDS], const RecordTable<Record>& table, OwnerOf ownerOf,
+    const DataLocks& locks, int collection, uint32_t shards, bool reuse, uint64_t generation) {
+    uint64_t stamps[PARTITION_SHARDS] = {};
+    uint32_t stale = 0;
+    for (int shard = 0; shard < PARTITION_SHARDS; shard++) {
+        if (!(shards & (1u << shard))) {
+            continue;
+        }
+        stamps[shard] = locks.stampOf(collection, 1u << shard);
+        if (reuse && cached[shard].data && cached[shard].stamp == stamps[shard]) {
+            store.counters.partsReused++;
+        }
+        else {
+            stale |= 1u << shard;
+        }
+    }
+
+    if (stale != 0) {
+        vector<Record> copies[PARTITION_SHARDS];
+        for (const auto& record : table) {
+            int shard = organizerShard(ownerOf(record));
+            if (stale & (1u << shard)) {
+                copies[shard].push_back(record);
+            }
+        }
+        for (int shard = 0; shard < PARTITION_SHARDS; shard++) {
+            if (stale & (1u << shard)) {
+                size_t bytes = copies[shard].size() * sizeof(Record);
+                replacePart(store, cached[shard], stamps[shard],
+                    make_shared<const vector<Record>>(move(copies[shard])), bytes, generation);
+            }
+        }
+    }
+
+    for (int shard = 0; shard < PARTITION_SHARDS; shard++) {
+        if (shards & (1u << shard)) {
+            parts[shard] = cached[shard].data;
+        }
+    }
+}
+
+static size_t feedbackBytes(const FeedbackSnapshot& feedback) {
+    size_t samples = 0;
+    for (const auto& [key, series] : feedback.trends.byOrganizer) {
+        samples += series.samples.size();
+    }
+    for (const auto& [key, series] : feedback.trends.byVenue) {
+        samples += series.samples.size();
+    }
+    // a rating row is a byte per category plus its feedbackID
+    return feedback.feedbackCount * (NUM_RATING_CATEGORIES + sizeof(string)) + samples * sizeof(TrendSample);
+}
+
+SnapshotPtr takeSnapshot(const SystemData& data, DataMask collections, string_view userID) {
+    SnapshotStore& store = data.snapshots;
+    const DataLocks& locks = data.locks;
+    // Stamps only mean something while every change is stamped
+    bool reuse = locks.tracksWrites;
+    uint32_t shards = userID.empty() ? ALL_SHARDS : 1u << organizerShard(userID);
+
+    auto snapshot = make_unique<DataSnapshot>();
+    lock_guard<mutex> guard(store.lock);
+    uint64_t generation = store.nextGeneration++;
+    snapshot->epoch = locks.epoch.load(memory_order_acquire);
+    snapshot->takenAt = chrono::steady_clock::now();
+
+    if (collections & REGISTRATIONS_DATA) {
+        refreshShards(store, store.registrations, snapshot->registrations, data.registrations,
+            [](const EventRegistration& reg) -> const string& { return reg.organizer.userID; },
+            locks, collectionOf(REGISTRATIONS_DATA), shards, reuse, generation);
+    }
+    if (collections & BOOKINGS_DATA) {
+        refreshShards(store, store.bookings, snapshot->bookings, data.bookings,
+            [](const EventBooking& booking) -> const string& { return booking.eventReg.organizer.userID; },
+            locks, collectionOf(BOOKINGS_DATA), shards, reuse, generation);
+    }
+    if (collections & PAYMENTS_DATA) {
+        uint64_t stamp = locks.stampOf(collectionOf(PAYMENTS_DATA), ALL_SHARDS);
+        if (reuse && store.payments.data && store.payments.stamp == stamp) {
+            store.counters.partsReused++;
+        }
+        else {
+            replacePart(store, store.payments, stamp, make_shared<const vector<Payment>>(data.payments),
+                data.payments.size() * sizeof(Payment), generation);
+        }
+        snapshot->payments = store.payments.data;
+    }
+    if (collections & FEEDBACK_DATA) {
+        uint64_t stamp = locks.stampOf(collectionOf(FEEDBACK_DATA), ALL_SHARDS);
+        if (reuse && store.feedback.data && store.feedback.stamp == stamp) {
+            store.counters.partsReused++;
+        }
+        else {
+            auto feedback = make_shared<FeedbackSnapshot>();
+            feedback->feedbackCount = data.feedbacks.size();
+            feedback->ratings = data.feedbackRatings;
+            copyRatingTrends(data.ratingTrends, feedback->trends);
+            size_t bytes = feedbackBytes(*feedback);
+            replacePart(store, store.feedback, stamp, shared_ptr<const FeedbackSnapshot>(move(feedback)), bytes, generation);
+        }
+        snapshot->feedback = store.feedback.data;
+    }
+
+    store.pinned.emplace(generation, snapshot->takenAt);
+    store.counters.taken++;
+    reclaim(store);
+
+    // Letting go of the snapshot unpins its generation
+    return SnapshotPtr(snapshot.release(), [&store, generation](const DataSnapshot* released) {
+        delete released;
+        lock_guard<mutex> guard(store.lock);
+        store.pinned.erase(generation);
+        reclaim(store);
+        });
+}
+
+template <typename Part>
+static size_t cachedBytes(const CachedPart<Part>& cached) {
+    return cached.data ? cached.bytes : 0;
+}
+
+SnapshotMetrics snapshotMetrics(const SystemData& data) {
+    SnapshotStore& store = data.snapshots;
+    lock_guard<mutex> guard(store.lock);
+    SnapshotMetrics metrics = store.counters;
+
+    metrics.pinned = store.pinned.size();
+    if (!store.pinned.empty()) {
+        metrics.oldestAgeSeconds = chrono::duration<double>(chrono::steady_clock::now() - store.pinned.begin()->second).count();
+    }
+    metrics.cachedBytes = cachedBytes(store.payments) + cachedBytes(store.feedback);
+    for (int shard = 0; shard < PARTITION_SHARDS; shard++) {
+        metrics.cachedBytes += cachedBytes(store.registrations[shard]) + cachedBytes(store.bookings[shard]);
+    }
+    for (const auto& part : store.retired) {
+        metrics.retainedBytes += part.bytes;
+    }
+    return metrics;
+}
@@ -0,0 +1,105 @@
+#pragma once
+#ifndef DATA_SNAPSHOT_H
+#define DATA_SNAPSHOT_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#include "event_registration.h"
+#include "event_booking.h"
+#include "event_payment.h"
+#include "feedback_store.h"
+#include "rating_trends.h"
+#include "data_locks.h"
+using namespace std;
+
+// Feedback side of a snapshot
+struct FeedbackSnapshot {
+    size_t feedbackCount = 0;
+    FeedbackRatingStore ratings;
+    RatingTrendStore trends;
+};
+
+// Immutable view of the collections a report reads, as of one moment.
+// Records are held per organizer shard (data_locks.h) in table order, and
+// a shard nobody has written to since the previous snapshot is shared
+// with it rather than copied again. Parts not asked for are left empty.
+struct DataSnapshot {
+    uint64_t epoch = 0;                         // DataLocks::epoch when taken
+    chrono::steady_clock::time_point takenAt;
+    shared_ptr<const vector<EventRegistration>> registrations[PARTITION_SHARDS];
+    shared_ptr<const vector<EventBooking>> bookings[PARTITION_SHARDS];
+    shared_ptr<const vector<Payment>> payments;
+    shared_ptr<const FeedbackSnapshot> feedback;
+
+    // The records of the user's shard, which other organizers may share:
+    // still check the owner
+    const vector<EventRegistration>& registrationsOf(string_view userID) const;
+    const vector<EventBooking>& bookingsOf(string_view userID) const;
+    const vector<Payment>& allPayments() const;
+};
+
+using SnapshotPtr = shared_ptr<const DataSnapshot>;
+
+struct SnapshotMetrics {
+    size_t pinned = 0;              // snapshots still in use
+    double oldestAgeSeconds = 0;    // how long the oldest of them has been held
+    size_t cachedBytes = 0;         // latest copy of each part, for the next snapshot
+    size_t retainedBytes = 0;       // superseded parts kept alive for older snapshots
+    long long taken = 0;
+    long long partsReused = 0;
+    long long partsCopied = 0;
+    long long partsReclaimed = 0;
+};
+
+// Forward declarations
+class SystemData;
+
+// A part as last copied, with the newest write stamp it covers
+template <typename Part>
+struct CachedPart {
+    uint64_t stamp = 0;
+    shared_ptr<const Part> data;
+    size_t bytes = 0;
+};
+
+// A superseded part some older snapshot may still hold
+struct RetiredPart {
+    uint64_t generation = 0;    // of the snapshot that replaced it
+    shared_ptr<const void> data;
+    size_t bytes = 0;
+};
+
+// The latest copy of every part, plus what reclamation needs. Each
+// snapshot gets the next generation number. A part replaced by the
+// snapshot of generation G can only be held by snapshots older than G, so
+// it is released once none of those is pinned. Sizes are approximate
+// (record structs, not the text they point to). Only data_snapshot.cpp
+// touches the members, under the mutex.
+struct SnapshotStore {
+    mutex lock;
+    CachedPart<vector<EventRegistration>> registrations[PARTITION_SHARDS];
+    CachedPart<vector<EventBooking>> bookings[PARTITION_SHARDS];
+    CachedPart<vector<Payment>> payments;
+    CachedPart<FeedbackSnapshot> feedback;
+    vector<RetiredPart> retired;
+    map<uint64_t, chrono::steady_clock::time_point> pinned;    // generation -> taken at
+    uint64_t nextGeneration = 1;
+    SnapshotMetrics counters;   // only the running totals are kept here
+};
+
+// Pins a snapshot of the given collections (REGISTRATIONS_DATA,
+// BOOKINGS_DATA, PAYMENTS_DATA, FEEDBACK_DATA). With a userID only that
+// user's shard of registrations and bookings is filled. The caller must be
+// able to read the collections at that moment (its own locks, or being the
+// only session); the snapshot itself needs no locks, so long reports pair
+// it with an UnlockedSection. Snapshots must not outlive the SystemData.
+SnapshotPtr takeSnapshot(const SystemData& data, DataMask collections, string_view userID = {});
+
+SnapshotMetrics snapshotMetrics(const SystemData& data);
+
+#endif
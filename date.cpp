@@ -1,8 +1,49 @@
 #include "date.h"
 #include <string>
+#include <charconv>
 
 string Date::toString() const {
-    return to_string(year) + "-" +
-        (month < 10 ? "0" : "") + to_string(month) + "-" +
-        (day < 10 ? "0" : "") + to_string(day);
+    char buffer[40];
+    char* end = formatTo(buffer);
+    return string(buffer, end);
+}
+
+char* Date::formatTo(char* buffer) const {
+    char* out = to_chars(buffer, buffer + 12, year).ptr;
+    *out++ = '-';
+    if (month < 10) {
+        *out++ = '0';
+    }
+    out = to_chars(out, out + 12, month).ptr;
+    *out++ = '-';
+    if (day < 10) {
+        *out++ = '0';
+    }
+    return to_chars(out, out + 12, day).ptr;
+}
+
+int Date::toDayNumber() const {
+    // Civil-from-days inverse (proleptic Gregorian calendar)
+    int y = year - (month <= 2 ? 1 : 0);
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yearOfEra = y - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+Date Date::fromDayNumber(int dayNumber) {
+    // Days-to-civil, the inverse of toDayNumber
+    int z = dayNumber + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int dayOfEra = z - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int monthIndex = (5 * dayOfYear + 2) / 153;
+
+    Date date;
+    date.day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    date.month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    date.year = yearOfEra + era * 400 + (date.month <= 2 ? 1 : 0);
+    return date;
 }
@@ -11,6 +11,10 @@ struct Date {
     int day;
 
     string toString() const;
+    // Writes "2027-01-05" into buffer (at least 40 chars) and returns the end pointer
+    char* formatTo(char* buffer) const;
+    int toDayNumber() const; // days since 1970-01-01, for ordering and date arithmetic
+    static Date fromDayNumber(int dayNumber);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -18,6 +18,11 @@
 #include "utility_fun.h"
 #include "input_validation.h"
 #include "file_operation.h"
+#include "auto_scheduler.h"
+#include "booking_transaction.h"
+#include "waitlist.h"
+#include "cascade.h"
+#include "table_format.h"
 
 using namespace std;
 
@@ -28,16 +33,19 @@ void eventBookingMenu(SystemData& data) {
     while (!exitMenu) {
         clearScreen();
         displayLogo();
+        runHousekeeping(data);
         cout << "=== EVENT BOOKING SYSTEM ===" << endl;
         cout << setfill('=') << setw(50) << "=" << setfill(' ') << endl;
         cout << "1. Create New Event Booking" << endl;
         cout << "2. View My Event Bookings" << endl;
         cout << "3. Update Event Booking" << endl;
         cout << "4. Cancel / Delete Event Booking" << endl;
-        cout << "5. Back to Main Menu" << endl;
+        cout << "5. Auto-Schedule My Unscheduled Events" << endl;
+        cout << "6. My Venue Waitlists" << endl;
+        cout << "7. Back to Main Menu" << endl;
         cout << setfill('=') << setw(50) << "=" << setfill(' ') << endl;
 
-        int choice = getValidIntegerInput("Enter your choice [1-5]: ", 1, 5);
+        int choice = getValidIntegerInput("Enter your choice [1-7]: ", 1, 7);
 
         switch (choice) {
         case 1:
@@ -53,11 +61,17 @@ void eventBookingMenu(SystemData& data) {
             cancelEventBooking(data);
             break;
         case 5:
+            autoScheduleEvents(data);
+            break;
+        case 6:
+            manageWaitlist(data);
+            break;
+        case 7:
             exitMenu = true;
             break;
         }
 
-        if (choice != 5) {
+        if (choice != 7) {
             pauseScreen();
         }
     }
@@ -81,13 +95,13 @@ void createEventBooking(SystemData& data) {
     }
 
     // Display approved registrations that belong to current user (exclude cancelled)
-    vector<EventRegistration*> userApprovedRegs;
+    vector<RecordHandle> userApprovedRegs;
     string normalizedCurrentUser = normalizeUserID(data.currentUser);
-    for (auto& reg : data.registrations) {
-        string normalizedRegUser = normalizeUserID(reg.organizer.userID);
-        if ((reg.eventStatus == "UNSCHEDULED") &&
+    for (auto it = data.registrations.begin(); it != data.registrations.end(); ++it) {
+        string normalizedRegUser = normalizeUserID(it->organizer.userID);
+        if ((it->eventStatus == "UNSCHEDULED") &&
             normalizedRegUser == normalizedCurrentUser) {
-            userApprovedRegs.push_back(&reg);
+            userApprovedRegs.push_back(it.handle());
         }
     }
 
@@ -109,18 +123,20 @@ void createEventBooking(SystemData& data) {
     cout << setfill('=') << setw(80) << "=" << setfill(' ') << endl;
 
     for (size_t i = 0; i < userApprovedRegs.size(); i++) {
+        const EventRegistration& reg = data.registrations[userApprovedRegs[i]];
         cout << left
             << setw(4) << (i + 1)
-            << setw(8) << userApprovedRegs[i]->eventID
-            << setw(15) << userApprovedRegs[i]->eventTitle.substr(0, 14)
-            << setw(12) << userApprovedRegs[i]->manufacturer.substr(0, 11)
-            << setw(20) << userApprovedRegs[i]->organizer.organizerName.substr(0, 19)
-            << setw(12) << userApprovedRegs[i]->eventStatus<< endl;
+            << setw(8) << reg.eventID
+            << setw(15) << reg.eventTitle.substr(0, 14)
+            << setw(12) << reg.manufacturer.substr(0, 11)
+            << setw(20) << reg.organizer.organizerName.substr(0, 19)
+            << setw(12) << reg.eventStatus<< endl;
     }
     cout << setfill('=') << setw(80) << "=" << setfill(' ') << endl;
 
     int regChoice = getValidIntegerInput("Select registration number: ", 1, static_cast<int>(userApprovedRegs.size()));
-    EventRegistration* selectedReg = userApprovedRegs[regChoice - 1];
+    RecordHandle selectedHandle = userApprovedRegs[regChoice - 1];
+    EventRegistration* selectedReg = &data.registrations[selectedHandle];
 
     EventBooking newBooking;
     newBooking.bookingID = generateBookingID(data.bookings);
@@ -165,17 +181,22 @@ void createEventBooking(SystemData& data) {
         }
     }
 
-    // Display and select venue
-    displayAvailableVenues(data.venues, newBooking.eventDate, newBooking.eventTime);
+    // Offer the best-fit venues first, the full list only on request
+    int venueIndex = selectRecommendedVenue(data, selectedReg->expectedGuests, selectedReg->estimatedBudget,
+        newBooking.eventDate, newBooking.eventTime);
 
-    int venueIndex = selectAvailableVenue(data.venues, newBooking.eventDate, newBooking.eventTime);
+    if (venueIndex == -1) {
+        displayAvailableVenues(data, newBooking.eventDate, newBooking.eventTime);
+        venueIndex = selectAvailableVenue(data, newBooking.eventDate, newBooking.eventTime);
+    }
 
     if (venueIndex == -1) {
         cout << "No venues available for the selected date and time." << endl;
+        offerWaitlist(data, selectedHandle, newBooking.eventDate, newBooking.eventTime);
         return;
     }
 
-    newBooking.venue = data.venues[venueIndex];
+    newBooking.venue = venueDetails(data.venues[venueIndex]);
 
     // Verify venue is truly available across all bookings
     if (!isVenueAvailable(data.bookings, newBooking.venue.venueID,
@@ -185,11 +206,9 @@ void createEventBooking(SystemData& data) {
         return;
     }
 
-    newBooking.finalCost = newBooking.venue.rentalCost;
-    newBooking.bookingStatus = "Pending";
-
     // Check capacity
-    if (newBooking.eventReg.expectedGuests > newBooking.venue.capacity) {
+    bool overCapacity = newBooking.eventReg.expectedGuests > newBooking.venue.capacity;
+    if (overCapacity) {
         cout << "\nWARNING: Expected guests (" << newBooking.eventReg.expectedGuests
             << ") exceeds venue capacity (" << newBooking.venue.capacity << ")!" << endl;
 
@@ -204,20 +223,25 @@ void createEventBooking(SystemData& data) {
 
     // LOGISTICS SELECTION
     vector<string> selectedLogistics;
-    double logisticsCost = selectLogistics(selectedLogistics);
-    newBooking.finalCost += logisticsCost;
-
-    // Add booking to the venue's schedule
-    TimeSlot newSlot;
-    newSlot.date = newBooking.eventDate;
-    newSlot.time = newBooking.eventTime;
-    newSlot.eventID = newBooking.bookingID;
-    newSlot.isBooked = true;
-    data.venues[venueIndex].bookingSchedule.push_back(newSlot);
-
-    selectedReg->eventStatus = "SCHEDULED";
-
-    data.bookings.push_back(newBooking);
+    Money logisticsCost = selectLogistics(selectedLogistics);
+
+    // Schedule slot, registration status and booking are committed together
+    BookingTransaction transaction;
+    size_t part = stageBooking(transaction, selectedHandle, venueIndex,
+        newBooking.eventDate, newBooking.eventTime);
+    transaction.staged[part].logisticsItems = selectedLogistics;
+    transaction.staged[part].logisticsCost = logisticsCost;
+    transaction.staged[part].allowOverCapacity = overCapacity;
+
+    TransactionResult result = commitTransaction(data, transaction);
+    if (!result.committed) {
+        cout << "\nERROR: Booking could not be created:" << endl;
+        for (const auto& conflict : result.conflicts) {
+            cout << "  - " << conflict.reason << endl;
+        }
+        return;
+    }
+    newBooking = data.bookings.back();
 
     cout << "\n=== BOOKING CREATED SUCCESSFULLY ===" << endl;
     cout << "Booking ID: " << newBooking.bookingID << endl;
@@ -227,20 +251,19 @@ void createEventBooking(SystemData& data) {
     cout << "Expected Guests: " << newBooking.eventReg.expectedGuests << endl;
 
     cout << "\n=== COST BREAKDOWN ===" << endl;
-    cout << "Venue Rental: RM " << fixed << setprecision(2) << newBooking.venue.rentalCost << endl;
-    if (logisticsCost > 0) {
-        cout << "Logistics & Services: RM " << fixed << setprecision(2) << logisticsCost << endl;
+    cout << "Venue Rental: RM " << newBooking.venue.rentalCost << endl;
+    if (logisticsCost > Money()) {
+        cout << "Logistics & Services: RM " << logisticsCost << endl;
         cout << "\nSelected Logistics:" << endl;
         for (size_t i = 0; i < selectedLogistics.size(); i++) {
             cout << "  " << (i + 1) << ". " << selectedLogistics[i] << endl;
         }
     }
     cout << "------------------------" << endl;
-    cout << "TOTAL COST: RM " << fixed << setprecision(2) << newBooking.finalCost << endl;
+    cout << "TOTAL COST: RM " << newBooking.finalCost << endl;
     cout << "Status: " << newBooking.bookingStatus << endl;
-
-	saveRegistrationsToFile(data.registrations);
-    saveBookingsToFile(data.bookings);
+    cout << "Please pay within " << data.holds.holdSeconds / 3600
+        << " hour(s), or the booking is cancelled and the venue released." << endl;
 }
 
 void viewEventBookings(const SystemData& data) {
@@ -274,32 +297,32 @@ void viewEventBookings(const SystemData& data) {
         return;
     }
 
-    cout << setfill('=') << setw(140) << "=" << setfill(' ') << endl;
-    cout << left << setw(8) << "Book ID"
-        << setw(9) << "Event ID"
-        << setw(15) << "Event Title"
-        << setw(12) << "Manufacturer"
-        << setw(12) << "Date"
-        << setw(15) << "Time"
-        << setw(8) << "Guests"
-        << setw(15) << "Venue"
-        << setw(15) << "Cost (RM)"
-        << setw(15) << "Status" << endl;
-    cout << setfill('=') << setw(140) << "=" << setfill(' ') << endl;
-
+    static constexpr TableColumn columns[] = {
+        { "Book ID", 8 },
+        { "Event ID", 9 },
+        { "Event Title", 15, true },
+        { "Manufacturer", 12, true },
+        { "Date", 12 },
+        { "Time", 15 },
+        { "Guests", 8 },
+        { "Venue", 15, true },
+        { .header = "Cost (RM)", .width = 15, .prefix = "RM " },
+        { "Status", 15 },
+    };
+    TableWriter table(columns, userBookings.size());
+    table.rule('=', 140);
+    table.header();
+    table.rule('=', 140);
     for (const auto& booking : userBookings) {
-        cout << left << setw(8) << booking.bookingID
-            << setw(9) << booking.eventReg.eventID
-            << setw(15) << booking.eventReg.eventTitle.substr(0, 14)
-            << setw(12) << booking.eventReg.manufacturer.substr(0, 11)
-            << setw(12) << booking.eventDate.toString()
-            << setw(15) << booking.eventTime
-            << setw(8) << booking.eventReg.expectedGuests
-            << setw(15) << booking.venue.venueName.substr(0, 14)
-            << "RM " << setw(12) << fixed << setprecision(2) << booking.finalCost
-            << setw(15) << booking.bookingStatus << endl;
-    }
-    cout << setfill('=') << setw(140) << "=" << setfill(' ') << endl;
+        if (!table.row(booking.bookingID, booking.eventReg.eventID, booking.eventReg.eventTitle,
+            booking.eventReg.manufacturer, booking.eventDate, booking.eventTime,
+            booking.eventReg.expectedGuests, booking.venue.venueName, booking.finalCost,
+            booking.bookingStatus)) {
+            break;
+        }
+    }
+    table.rule('=', 140);
+    table.flush();
     cout << "Total Your Bookings: " << userBookings.size() << endl;
 
     // Show notice for cancelled bookings
@@ -359,51 +382,70 @@ void updateEventBooking(SystemData& data) {
     bookingID = toUpperCase(bookingID);
 
     // Find booking using loop and verify ownership
-    int bookingIndex = -1;
-    for (size_t i = 0; i < data.bookings.size(); i++) {
-        string normalizedBookingUser = normalizeUserID(data.bookings[i].eventReg.organizer.userID);
-        if (data.bookings[i].bookingID == bookingID &&
+    RecordHandle bookingHandle;
+    for (auto it = data.bookings.begin(); it != data.bookings.end(); ++it) {
+        string normalizedBookingUser = normalizeUserID(it->eventReg.organizer.userID);
+        if (it->bookingID == bookingID &&
             normalizedBookingUser == normalizedCurrentUser) {
-            bookingIndex = static_cast<int>(i);
+            bookingHandle = it.handle();
             break;
         }
     }
 
-    if (bookingIndex == -1) {
+    if (!bookingHandle.valid()) {
         cout << "Event booking not found or you don't have permission to update it!" << endl;
         return;
     }
 
     // Check if booking can be updated (not completed or cancelled)
-    if (data.bookings[bookingIndex].bookingStatus == "Completed" ||
-        data.bookings[bookingIndex].bookingStatus == "Cancelled") {
-        cout << "Cannot update booking with status: " << data.bookings[bookingIndex].bookingStatus << endl;
+    if (data.bookings[bookingHandle].bookingStatus == "Completed" ||
+        data.bookings[bookingHandle].bookingStatus == "Cancelled") {
+        cout << "Cannot update booking with status: " << data.bookings[bookingHandle].bookingStatus << endl;
         return;
     }
 
     cout << "\n=== Current Booking Details ===" << endl;
-    cout << "Booking ID: " << data.bookings[bookingIndex].bookingID << endl;
-    cout << "Event: " << data.bookings[bookingIndex].eventReg.eventTitle
-        << " by " << data.bookings[bookingIndex].eventReg.manufacturer << endl;
-    cout << "Date: " << data.bookings[bookingIndex].eventDate.toString() << endl;
-    cout << "Time: " << data.bookings[bookingIndex].eventTime << endl;
-    cout << "Venue: " << data.bookings[bookingIndex].venue.venueName << endl;
-    cout << "Expected Guests: " << data.bookings[bookingIndex].eventReg.expectedGuests << endl;
-    cout << "Final Cost: RM " << fixed << setprecision(2) << data.bookings[bookingIndex].finalCost << endl;
-    cout << "Status: " << data.bookings[bookingIndex].bookingStatus << endl;
+    cout << "Booking ID: " << data.bookings[bookingHandle].bookingID << endl;
+    cout << "Event: " << data.bookings[bookingHandle].eventReg.eventTitle
+        << " by " << data.bookings[bookingHandle].eventReg.manufacturer << endl;
+    cout << "Date: " << data.bookings[bookingHandle].eventDate.toString() << endl;
+    cout << "Time: " << data.bookings[bookingHandle].eventTime << endl;
+    cout << "Venue: " << data.bookings[bookingHandle].venue.venueName << endl;
+    cout << "Expected Guests: " << data.bookings[bookingHandle].eventReg.expectedGuests << endl;
+    cout << "Final Cost: RM " << data.bookings[bookingHandle].finalCost << endl;
+    cout << "Status: " << data.bookings[bookingHandle].bookingStatus << endl;
 
     cout << "\nWhat would you like to update?" << endl;
     cout << "1. Time Slot" << endl;
     cout << "2. Venue" << endl;
     cout << "3. Add/Update Logistics" << endl;
 
+    // Other sessions run while this one waits at a prompt, so every answer
+    // is followed by a fresh look at the booking before anything changes
+    auto stillOpen = [&]() {
+        const EventBooking* booking = data.bookings.find(bookingHandle);
+        if (booking != nullptr && (booking->bookingStatus == "Pending" || booking->bookingStatus == "Confirmed")) {
+            return true;
+        }
+        cout << "This booking was cancelled, completed or deleted in the meantime. No changes made." << endl;
+        return false;
+    };
+
     int choice = getValidIntegerInput("Enter choice [1-3]: ", 1, 3);
+    if (!stillOpen()) {
+        return;
+    }
+
+    // Each option can back out without changing anything
+    string timeBefore = data.bookings[bookingHandle].eventTime;
+    string venueBefore = data.bookings[bookingHandle].venue.venueID;
+    Money costBefore = data.bookings[bookingHandle].finalCost;
 
     switch (choice) {
     case 1: // Update Time Slot
     {
         cout << "\n=== UPDATE TIME SLOT ===" << endl;
-        cout << "Current time slot: " << data.bookings[bookingIndex].eventTime << endl;
+        cout << "Current time slot: " << data.bookings[bookingHandle].eventTime << endl;
 
         // Show available time slots
         cout << "\nAvailable Time Slots:" << endl;
@@ -414,18 +456,24 @@ void updateEventBooking(SystemData& data) {
         int timeChoice = getValidIntegerInput("Select new time slot [1-" +
             to_string(data.timeConfig.timeSlotNames.size()) + "]: ", 1,
             static_cast<int>(data.timeConfig.timeSlotNames.size()));
+        if (!stillOpen()) {
+            return;
+        }
 
         string newTimeSlot = data.timeConfig.timeSlots[timeChoice - 1];
 
         // Check if the new time slot is different
-        if (newTimeSlot == data.bookings[bookingIndex].eventTime) {
+        if (newTimeSlot == data.bookings[bookingHandle].eventTime) {
             cout << "Selected time slot is the same as current. No changes made." << endl;
             break;
         }
 
-        // Check if venue is available at the new time slot
-        if (!isVenueAvailableInSchedule(data.bookings[bookingIndex].venue,
-            data.bookings[bookingIndex].eventDate,
+        // Check if venue is available at the new time slot (the booking's own
+        // venue copy has a stale schedule, so ask the live index)
+        auto venuePosition = data.venueIndex.positionOf.find(data.bookings[bookingHandle].venue.venueID);
+        if (venuePosition != data.venueIndex.positionOf.end() &&
+            !isVenueSlotFree(data.venueIndex, venuePosition->second,
+            data.bookings[bookingHandle].eventDate,
             newTimeSlot)) {
             cout << "ERROR: Current venue is not available at the selected time slot!" << endl;
             cout << "Please try a different time or update the venue as well." << endl;
@@ -436,10 +484,10 @@ void updateEventBooking(SystemData& data) {
         bool duplicateFound = false;
         for (const auto& existingBooking : data.bookings) {
             if (existingBooking.bookingID != bookingID && // Don't check against itself
-                existingBooking.eventReg.eventID == data.bookings[bookingIndex].eventReg.eventID &&
-                existingBooking.eventDate.day == data.bookings[bookingIndex].eventDate.day &&
-                existingBooking.eventDate.month == data.bookings[bookingIndex].eventDate.month &&
-                existingBooking.eventDate.year == data.bookings[bookingIndex].eventDate.year &&
+                existingBooking.eventReg.eventID == data.bookings[bookingHandle].eventReg.eventID &&
+                existingBooking.eventDate.day == data.bookings[bookingHandle].eventDate.day &&
+                existingBooking.eventDate.month == data.bookings[bookingHandle].eventDate.month &&
+                existingBooking.eventDate.year == data.bookings[bookingHandle].eventDate.year &&
                 existingBooking.eventTime == newTimeSlot &&
                 existingBooking.bookingStatus != "Cancelled") {
 
@@ -453,19 +501,29 @@ void updateEventBooking(SystemData& data) {
             break;
         }
 
+        // Claim the new slot before giving up the old one, so a session that
+        // took it since the check above leaves this booking untouched
+        if (reserveVenueSlot(data.venueIndex, data.bookings[bookingHandle].venue.venueID,
+            data.bookings[bookingHandle].eventDate, newTimeSlot, bookingID) != ReserveResult::Claimed) {
+            cout << "ERROR: Current venue can't be booked at the selected time slot!" << endl;
+            break;
+        }
+
         // Update venue schedule - remove old slot
         for (size_t i = 0; i < data.venues.size(); i++) {
-            if (data.venues[i].venueID == data.bookings[bookingIndex].venue.venueID) {
+            if (data.venues[i].venueID == data.bookings[bookingHandle].venue.venueID) {
                 for (size_t j = 0; j < data.venues[i].bookingSchedule.size(); j++) {
                     if (data.venues[i].bookingSchedule[j].eventID == bookingID) {
                         data.venues[i].bookingSchedule.erase(data.venues[i].bookingSchedule.begin() + j);
                         break;
                     }
                 }
+                releaseVenueSlot(data.venueIndex, data.venues[i].venueID, data.bookings[bookingHandle].eventDate,
+                    data.bookings[bookingHandle].eventTime, bookingID);
 
                 // Add new slot
                 TimeSlot newSlot;
-                newSlot.date = data.bookings[bookingIndex].eventDate;
+                newSlot.date = data.bookings[bookingHandle].eventDate;
                 newSlot.time = newTimeSlot;
                 newSlot.eventID = bookingID;
                 newSlot.isBooked = true;
@@ -474,23 +532,28 @@ void updateEventBooking(SystemData& data) {
             }
         }
 
-        data.bookings[bookingIndex].eventTime = newTimeSlot;
+        string oldTimeSlot = data.bookings[bookingHandle].eventTime;
+        data.bookings[bookingHandle].eventTime = newTimeSlot;
         cout << "Time slot updated successfully to: " << newTimeSlot << endl;
+        promoteFromWaitlist(data, data.bookings[bookingHandle].venue.venueID,
+            data.bookings[bookingHandle].eventDate, oldTimeSlot);
         break;
     }
     case 2: // Update Venue
     {
         cout << "\n=== UPDATE VENUE ===" << endl;
-        cout << "Current venue: " << data.bookings[bookingIndex].venue.venueName
-            << " (Cost: RM " << fixed << setprecision(2)
-            << data.bookings[bookingIndex].venue.rentalCost << ")" << endl;
+        cout << "Current venue: " << data.bookings[bookingHandle].venue.venueName
+            << " (Cost: RM " << data.bookings[bookingHandle].venue.rentalCost << ")" << endl;
 
         // Display available venues for current date and time
-        displayAvailableVenues(data.venues, data.bookings[bookingIndex].eventDate,
-            data.bookings[bookingIndex].eventTime);
+        displayAvailableVenues(data, data.bookings[bookingHandle].eventDate,
+            data.bookings[bookingHandle].eventTime);
 
-        int venueIndex = selectAvailableVenue(data.venues, data.bookings[bookingIndex].eventDate,
-            data.bookings[bookingIndex].eventTime);
+        int venueIndex = selectAvailableVenue(data, data.bookings[bookingHandle].eventDate,
+            data.bookings[bookingHandle].eventTime);
+        if (!stillOpen()) {
+            return;
+        }
 
         if (venueIndex == -1) {
             cout << "No alternative venues available for the current date and time." << endl;
@@ -498,14 +561,14 @@ void updateEventBooking(SystemData& data) {
         }
 
         // Check if it's the same venue
-        if (data.venues[venueIndex].venueID == data.bookings[bookingIndex].venue.venueID) {
+        if (data.venues[venueIndex].venueID == data.bookings[bookingHandle].venue.venueID) {
             cout << "Selected venue is the same as current. No changes made." << endl;
             break;
         }
 
         // Check capacity
-        if (data.bookings[bookingIndex].eventReg.expectedGuests > data.venues[venueIndex].capacity) {
-            cout << "\nWARNING: Expected guests (" << data.bookings[bookingIndex].eventReg.expectedGuests
+        if (data.bookings[bookingHandle].eventReg.expectedGuests > data.venues[venueIndex].capacity) {
+            cout << "\nWARNING: Expected guests (" << data.bookings[bookingHandle].eventReg.expectedGuests
                 << ") exceeds new venue capacity (" << data.venues[venueIndex].capacity << ")!" << endl;
 
             vector<char> validChars = { 'Y', 'N' };
@@ -515,64 +578,94 @@ void updateEventBooking(SystemData& data) {
                 cout << "Venue change cancelled." << endl;
                 break;
             }
+            if (!stillOpen()) {
+                return;
+            }
+        }
+
+        // Claim the new venue first; if another session took it, keep the old one
+        if (reserveVenueSlot(data.venueIndex, data.venues[venueIndex].venueID, data.bookings[bookingHandle].eventDate,
+            data.bookings[bookingHandle].eventTime, bookingID) != ReserveResult::Claimed) {
+            cout << "ERROR: " << data.venues[venueIndex].venueName << " can't be booked for this date and time." << endl;
+            break;
         }
 
         // Remove old venue booking from schedule
         for (size_t i = 0; i < data.venues.size(); i++) {
-            if (data.venues[i].venueID == data.bookings[bookingIndex].venue.venueID) {
+            if (data.venues[i].venueID == data.bookings[bookingHandle].venue.venueID) {
                 for (size_t j = 0; j < data.venues[i].bookingSchedule.size(); j++) {
                     if (data.venues[i].bookingSchedule[j].eventID == bookingID) {
                         data.venues[i].bookingSchedule.erase(data.venues[i].bookingSchedule.begin() + j);
                         break;
                     }
                 }
+                releaseVenueSlot(data.venueIndex, data.venues[i].venueID, data.bookings[bookingHandle].eventDate,
+                    data.bookings[bookingHandle].eventTime, bookingID);
                 break;
             }
         }
 
+        string oldVenueID = data.bookings[bookingHandle].venue.venueID;
+
         // Calculate cost difference
-        double oldVenueCost = data.bookings[bookingIndex].venue.rentalCost;
-        double newVenueCost = data.venues[venueIndex].rentalCost;
-        double costDifference = newVenueCost - oldVenueCost;
+        Money oldVenueCost = data.bookings[bookingHandle].venue.rentalCost;
+        Money newVenueCost = data.venues[venueIndex].rentalCost;
+        Money costDifference = newVenueCost - oldVenueCost;
 
         // Update venue and recalculate final cost
-        data.bookings[bookingIndex].venue = data.venues[venueIndex];
-        data.bookings[bookingIndex].finalCost += costDifference;
+        data.bookings[bookingHandle].venue = venueDetails(data.venues[venueIndex]);
+        data.bookings[bookingHandle].finalCost += costDifference;
 
         // Add booking to new venue schedule
         TimeSlot newSlot;
-        newSlot.date = data.bookings[bookingIndex].eventDate;
-        newSlot.time = data.bookings[bookingIndex].eventTime;
+        newSlot.date = data.bookings[bookingHandle].eventDate;
+        newSlot.time = data.bookings[bookingHandle].eventTime;
         newSlot.eventID = bookingID;
         newSlot.isBooked = true;
         data.venues[venueIndex].bookingSchedule.push_back(newSlot);
 
         cout << "\n=== Venue Updated Successfully ===" << endl;
         cout << "New venue: " << data.venues[venueIndex].venueName << endl;
-        cout << "Old venue cost: RM " << fixed << setprecision(2) << oldVenueCost << endl;
-        cout << "New venue cost: RM " << fixed << setprecision(2) << newVenueCost << endl;
-        cout << "Cost difference: RM " << fixed << setprecision(2) << costDifference << endl;
-        cout << "Updated total cost: RM " << fixed << setprecision(2) << data.bookings[bookingIndex].finalCost << endl;
+        cout << "Old venue cost: RM " << oldVenueCost << endl;
+        cout << "New venue cost: RM " << newVenueCost << endl;
+        cout << "Cost difference: RM " << costDifference << endl;
+        cout << "Updated total cost: RM " << data.bookings[bookingHandle].finalCost << endl;
+        promoteFromWaitlist(data, oldVenueID, data.bookings[bookingHandle].eventDate,
+            data.bookings[bookingHandle].eventTime);
         break;
     }
     case 3: // Add/Update Logistics
     {
         cout << "\n=== UPDATE LOGISTICS ===" << endl;
         vector<string> selectedLogistics;
-        double additionalLogisticsCost = selectLogistics(selectedLogistics);
+        Money additionalLogisticsCost = selectLogistics(selectedLogistics);
+        if (!stillOpen()) {
+            return;
+        }
 
-        if (additionalLogisticsCost > 0) {
-            data.bookings[bookingIndex].finalCost += additionalLogisticsCost;
-            cout << "\nAdditional logistics cost: RM " << fixed << setprecision(2)
-                << additionalLogisticsCost << endl;
-            cout << "Updated total cost: RM " << fixed << setprecision(2)
-                << data.bookings[bookingIndex].finalCost << endl;
+        if (additionalLogisticsCost > Money()) {
+            data.bookings[bookingHandle].finalCost += additionalLogisticsCost;
+            data.bookings[bookingHandle].logisticsCost += additionalLogisticsCost;
+            cout << "\nAdditional logistics cost: RM " << additionalLogisticsCost << endl;
+            cout << "Updated total cost: RM " << data.bookings[bookingHandle].finalCost << endl;
         }
         break;
     }
     }
 
+    // Venue and cost changes move the booking (and its payments) between cells
+    recordBookingInCube(data.revenue, data.bookings[bookingHandle]);
+    for (const auto& payment : data.payments) {
+        if (payment.bookingID == bookingID) {
+            recordPaymentInCube(data.revenue, payment, data.bookings[bookingHandle]);
+        }
+    }
+
     saveBookingsToFile(data.bookings);
+    const EventBooking& updated = data.bookings[bookingHandle];
+    if (updated.eventTime != timeBefore || updated.venue.venueID != venueBefore || updated.finalCost != costBefore) {
+        data.changes.publish(ChangeKind::BookingUpdated, bookingID, updated.eventReg.organizer.userID, updated.finalCost);
+    }
     cout << "Event booking updated successfully!" << endl;
 }
 
@@ -613,46 +706,47 @@ void cancelEventBooking(SystemData& data) {
     bookingID = toUpperCase(bookingID);
 
     // Find booking using loop and verify ownership
-    int bookingIndex = -1;
-    for (size_t i = 0; i < data.bookings.size(); i++) {
-        string normalizedBookingUser = normalizeUserID(data.bookings[i].eventReg.organizer.userID);
-        if (data.bookings[i].bookingID == bookingID &&
+    RecordHandle bookingHandle;
+    for (auto it = data.bookings.begin(); it != data.bookings.end(); ++it) {
+        string normalizedBookingUser = normalizeUserID(it->eventReg.organizer.userID);
+        if (it->bookingID == bookingID &&
             normalizedBookingUser == normalizedCurrentUser) {
-            bookingIndex = static_cast<int>(i);
+            bookingHandle = it.handle();
             break;
         }
     }
 
-    if (bookingIndex == -1) {
+    if (!bookingHandle.valid()) {
         cout << "Event booking not found or you don't have permission to cancel/delete it!" << endl;
         return;
     }
 
     cout << "\n=== Booking Details ===" << endl;
-    cout << "Booking ID: " << data.bookings[bookingIndex].bookingID << endl;
-    cout << "Event: " << data.bookings[bookingIndex].eventReg.eventTitle
-        << " by " << data.bookings[bookingIndex].eventReg.manufacturer << endl;
-    cout << "Date: " << data.bookings[bookingIndex].eventDate.toString() << endl;
-    cout << "Time: " << data.bookings[bookingIndex].eventTime << endl;
-    cout << "Venue: " << data.bookings[bookingIndex].venue.venueName << endl;
-    cout << "Final Cost: RM " << fixed << setprecision(2) << data.bookings[bookingIndex].finalCost << endl;
-    cout << "Current Status: " << data.bookings[bookingIndex].bookingStatus << endl;
+    cout << "Booking ID: " << data.bookings[bookingHandle].bookingID << endl;
+    cout << "Event: " << data.bookings[bookingHandle].eventReg.eventTitle
+        << " by " << data.bookings[bookingHandle].eventReg.manufacturer << endl;
+    cout << "Date: " << data.bookings[bookingHandle].eventDate.toString() << endl;
+    cout << "Time: " << data.bookings[bookingHandle].eventTime << endl;
+    cout << "Venue: " << data.bookings[bookingHandle].venue.venueName << endl;
+    cout << "Final Cost: RM " << data.bookings[bookingHandle].finalCost << endl;
+    cout << "Current Status: " << data.bookings[bookingHandle].bookingStatus << endl;
 
     // Different handling based on current status
-    if (data.bookings[bookingIndex].bookingStatus == "Cancelled") {
+    if (data.bookings[bookingHandle].bookingStatus == "Cancelled") {
         cout << "\nThis booking is already cancelled." << endl;
         cout << "You can delete it to remove from your records." << endl;
 
         vector<char> validChars = { 'Y', 'N' };
         char confirm = getValidCharInput("Delete this cancelled booking record? (Y/N): ", validChars);
 
-        if (confirm == 'Y' || confirm == 'y') {
-            // Remove from venue schedule
-            removeBookingFromVenueSchedule(data.venues, bookingID);
-
-            // Remove booking
-            data.bookings.erase(data.bookings.begin() + bookingIndex);
-            saveBookingsToFile(data.bookings);
+        // Another session may have deleted it while we waited for the answer
+        if ((confirm == 'Y' || confirm == 'y') && data.bookings.find(bookingHandle) == nullptr) {
+            cout << "This booking record has already been deleted." << endl;
+        }
+        else if (confirm == 'Y' || confirm == 'y') {
+            CascadePlan plan;
+            plan.deleteBookings.insert(bookingID);
+            applyCascade(data, plan);
             cout << "Cancelled booking record deleted successfully!" << endl;
         }
         else {
@@ -664,52 +758,25 @@ void cancelEventBooking(SystemData& data) {
         vector<char> validChars = { 'Y', 'N' };
         char confirm = getValidCharInput("\nAre you sure you want to cancel this booking? (Y/N): ", validChars);
 
-        if (confirm == 'Y' || confirm == 'y') {
-            // Remove booking from venue schedule
-            removeBookingFromVenueSchedule(data.venues, bookingID);
-            for (auto& reg : data.registrations) {
-                if (reg.eventID == data.bookings[bookingIndex].eventReg.eventID && normalizedCurrentUser == data.bookings[bookingIndex].eventReg.organizer.userID) {
-                    reg.eventStatus = "UNSCHEDULED"; //change the event status
-                    break;
-                }
+        // Look the booking up again: another session may have cancelled or
+        // deleted it while we waited for the answer
+        const EventBooking* booking = data.bookings.find(bookingHandle);
+        if ((confirm == 'Y' || confirm == 'y') && (booking == nullptr || booking->bookingStatus == "Cancelled")) {
+            cout << "This booking has already been cancelled." << endl;
+        }
+        else if (confirm == 'Y' || confirm == 'y') {
+            // Every active booking of the event is cancelled and the event goes back to UNSCHEDULED
+            CascadePlan plan;
+            plan.unscheduleRegistrations.insert(booking->eventReg.eventID);
+            CascadeResult result = applyCascade(data, plan);
+            cout << "Event booking cancelled successfully!";
+            if (result.bookingsCancelled > 1) {
+                cout << " (" << result.bookingsCancelled << " bookings of this event)";
             }
-            for(auto& booking : data.bookings) {
-                if (booking.eventReg.eventID == data.bookings[bookingIndex].eventReg.eventID && normalizedCurrentUser == data.bookings[bookingIndex].eventReg.organizer.userID) {
-                    booking.bookingStatus = "Cancelled"; //change the booking status
-                }
-			}
-			saveRegistrationsToFile(data.registrations);
-            saveBookingsToFile(data.bookings);
-            cout << "Event booking cancelled successfully!" << endl;
+            cout << endl;
         }
         else {
             cout << "Cancellation cancelled." << endl;
         }
     }
-}
-
-void removeBookingFromVenueSchedule(vector<Venue>& venues, const string& bookingID) {
-    for (size_t i = 0; i < venues.size(); i++) {
-        for (size_t j = 0; j < venues[i].bookingSchedule.size(); j++) {
-            if (venues[i].bookingSchedule[j].eventID == bookingID) {
-                venues[i].bookingSchedule.erase(venues[i].bookingSchedule.begin() + j);
-                return; // Exit after finding and removing
-            }
-        }
-    }
-}
-
-void updateBookingsForCancelledEvent(vector<EventBooking>& bookings, const string& eventID) {
-    int updatedCount = 0;
-    for (auto& booking : bookings) {
-        if (booking.eventReg.eventID == eventID && booking.bookingStatus != "Cancelled") {
-            booking.bookingStatus = "Cancelled";
-            updatedCount++;
-        }
-    }
-
-    if (updatedCount > 0) {
-        saveBookingsToFile(bookings);
-        cout << "Updated " << updatedCount << " booking(s) to cancelled status." << endl;
-    }
 }
\ No newline at end of file
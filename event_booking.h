@@ -7,6 +7,8 @@
 #include "event_registration.h"
 #include "timeslot.h"
 #include "logistics.h"
+#include "money.h"
+#include "record_table.h"
 
 using namespace std;
 
@@ -18,11 +20,13 @@ struct EventBooking {
     string eventTime;
     Venue venue;
     string bookingStatus; // "Pending", "Confirmed", "Completed", "Cancelled"
-    double finalCost;
+    Money finalCost;
     vector<string> logisticsItems;
-    double logisticsCost;
+    Money logisticsCost;
 };
 
+using BookingTable = RecordTable<EventBooking>;
+
 // Booking Status Logic Clarification:
 // PENDING -> User created booking, waiting for payment
 // CONFIRMED -> Payment completed, booking is confirmed
@@ -36,7 +40,5 @@ void createEventBooking(SystemData& data);
 void viewEventBookings(const SystemData& data);
 void updateEventBooking(SystemData& data);
 void cancelEventBooking(SystemData& data);
-void removeBookingFromVenueSchedule(vector<Venue>& venues, const string& bookingID);
-void updateBookingsForCancelledEvent(vector<EventBooking>& bookings, const string& eventID);
 
 #endif
\ No newline at end of file
@@ -21,6 +21,8 @@
 #include "utility_fun.h"
 #include "input_validation.h"
 #include "file_operation.h"
+#include "worker_pool.h"
+#include "table_format.h"
 using namespace std;
 
 // Event Monitoring Module Implementation with User Restrictions and <format>
@@ -39,10 +41,11 @@ void eventMonitoringMenu(SystemData& data) {
         cout << "5. My Registration Statistics" << endl;
         cout << "6. Search My Events" << endl;
         cout << "7. Generate My Event Report" << endl;
-        cout << "8. Back to Main Menu" << endl;
+        cout << "8. My Revenue Drill-Down" << endl;
+        cout << "9. Back to Main Menu" << endl;
         cout << string(50, '=') << endl;
 
-        int choice = getValidIntegerInput("Enter your choice [1-8]: ", 1, 8);
+        int choice = getValidIntegerInput("Enter your choice [1-9]: ", 1, 9);
 
         switch (choice) {
         case 1:
@@ -67,11 +70,14 @@ void eventMonitoringMenu(SystemData& data) {
             generateEventReport(data);
             break;
         case 8:
+            displayRevenueDrillDown(data);
+            break;
+        case 9:
             exitMenu = true;
             break;
         }
 
-        if (choice != 8) {
+        if (choice != 9) {
             pauseScreen();
         }
     }
@@ -88,6 +94,9 @@ void displayEventSummary(const SystemData& data) {
         return;
     }
 
+    // Only reads, so other sessions' queries can run alongside
+    ReadOnlySection readOnly(REGISTRATIONS_DATA | BOOKINGS_DATA | VENUES_DATA, data.currentUser);
+
     // Filter user's data only
     string normalizedCurrentUser = normalizeUserID(data.currentUser);
     vector<EventRegistration> userRegistrations;
@@ -217,31 +226,23 @@ void displayFinancialReport(const SystemData& data) {
     }
 
     string normalizedCurrentUser = normalizeUserID(data.currentUser);
-    double myTotalSpent = 0.0;
-    double myTotalBudget = 0.0;
-    double myPendingCost = 0.0;
-    double myConfirmedCost = 0.0;
-    double myCompletedCost = 0.0;
+    Money myTotalBudget;
 
-    vector<EventBooking> myExpensiveEvents;
+    // Cost totals by booking status come from the revenue cube
+    RevenueFilter filter;
+    filter.organizerID = normalizedCurrentUser;
+    map<string, RevenueCell> costByStatus = rollupBookingRevenue(data.revenue, RevenueDimension::Status, filter);
+
+    Money myPendingCost = costByStatus["Pending"].total;
+    Money myConfirmedCost = costByStatus["Confirmed"].total;
+    Money myCompletedCost = costByStatus["Completed"].total;
+    Money myTotalSpent = myConfirmedCost + myCompletedCost;
 
-    // Calculate user's financial data
+    vector<EventBooking> myExpensiveEvents;
     for (const auto& booking : data.bookings) {
         string normalizedBookingUser = normalizeUserID(booking.eventReg.organizer.userID);
         if (normalizedBookingUser == normalizedCurrentUser) {
             myExpensiveEvents.push_back(booking);
-
-            if (booking.bookingStatus == "Completed") {
-                myCompletedCost += booking.finalCost;
-                myTotalSpent += booking.finalCost;
-            }
-            else if (booking.bookingStatus == "Confirmed") {
-                myConfirmedCost += booking.finalCost;
-                myTotalSpent += booking.finalCost;
-            }
-            else if (booking.bookingStatus == "Pending") {
-                myPendingCost += booking.finalCost;
-            }
         }
     }
 
@@ -254,11 +255,11 @@ void displayFinancialReport(const SystemData& data) {
 
     cout << format("User: {}\n", data.currentUser);
     cout << string(70, '-') << endl;
-    cout << format("{:<34}: RM {:.2f}\n", "My Total Budget (All Events)", myTotalBudget);
-    cout << format("{:<34}: RM {:.2f}\n", "My Total Spent (Bookings)", myTotalSpent);
-    cout << format("{:<34}: RM {:.2f}\n", "My Pending Costs", myPendingCost);
-    cout << format("{:<34}: RM {:.2f}\n", "My Confirmed Costs", myConfirmedCost);
-    cout << format("{:<34}: RM {:.2f}\n", "My Completed Costs", myCompletedCost);
+    cout << format("{:<34}: RM {}\n", "My Total Budget (All Events)", myTotalBudget.toString());
+    cout << format("{:<34}: RM {}\n", "My Total Spent (Bookings)", myTotalSpent.toString());
+    cout << format("{:<34}: RM {}\n", "My Pending Costs", myPendingCost.toString());
+    cout << format("{:<34}: RM {}\n", "My Confirmed Costs", myConfirmedCost.toString());
+    cout << format("{:<34}: RM {}\n", "My Completed Costs", myCompletedCost.toString());
     cout << endl;
 
     // User's top 5 most expensive events
@@ -271,9 +272,9 @@ void displayFinancialReport(const SystemData& data) {
     int count = 0;
     for (const auto& booking : myExpensiveEvents) {
         if (count++ >= 5) break;
-        cout << format("{:<29}: RM {:.2f} ({})\n",
+        cout << format("{:<29}: RM {} ({})\n",
             booking.eventReg.eventTitle,
-            booking.finalCost,
+            booking.finalCost.toString(),
             booking.bookingStatus);
     }
 
@@ -281,6 +282,84 @@ void displayFinancialReport(const SystemData& data) {
         cout << "No bookings found for your account." << endl;
     }
 
+    // Monthly trend of confirmed spending
+    map<string, RevenueCell> monthly = rollupBookingRevenue(data.revenue, RevenueDimension::Month, filter);
+    if (!monthly.empty()) {
+        cout << endl << "=== MY BOOKING COSTS BY MONTH ===" << endl;
+        for (const auto& month : monthly) {
+            cout << format("{:<12}: RM {:>12} ({} bookings)\n", month.first, month.second.total.toString(), month.second.count);
+        }
+    }
+
+    cout << string(70, '=') << endl;
+}
+
+void displayRevenueDrillDown(const SystemData& data) {
+    clearScreen();
+    cout << "=== MY REVENUE DRILL-DOWN ===" << endl;
+    cout << string(70, '=') << endl;
+
+    // Check if user is logged in
+    if (data.currentUser.empty()) {
+        cout << "Error: No user logged in!" << endl;
+        return;
+    }
+
+    RevenueFilter filter;
+    filter.organizerID = normalizeUserID(data.currentUser);
+
+    cout << "1. Payments" << endl;
+    cout << "2. Booking costs" << endl;
+    bool payments = getValidIntegerInput("Measure [1-2]: ", 1, 2) == 1;
+
+    // Optional slices, blank means all
+    cout << "\nLeave blank to include everything." << endl;
+    cout << "Month (YYYY-MM): ";
+    readInputLine(filter.month);
+    cout << "Venue ID: ";
+    readInputLine(filter.venueID);
+    filter.month = trimWhitespace(filter.month);
+    filter.venueID = toUpperCase(trimWhitespace(filter.venueID));
+
+    cout << "\nGroup by:" << endl;
+    cout << "1. Month" << endl;
+    cout << "2. Week" << endl;
+    cout << "3. Venue" << endl;
+    cout << "4. Manufacturer" << endl;
+    cout << "5. Payment Method" << endl;
+    cout << "6. Status" << endl;
+    int groupChoice = getValidIntegerInput("Enter your choice [1-6]: ", 1, 6);
+
+    const RevenueDimension dimensions[6] = {
+        RevenueDimension::Month, RevenueDimension::Week, RevenueDimension::Venue,
+        RevenueDimension::Manufacturer, RevenueDimension::PaymentMethod, RevenueDimension::Status
+    };
+    const string dimensionNames[6] = { "Month", "Week", "Venue", "Manufacturer", "Method", "Status" };
+
+    map<string, RevenueCell> groups = payments
+        ? rollupPaymentRevenue(data.revenue, dimensions[groupChoice - 1], filter)
+        : rollupBookingRevenue(data.revenue, dimensions[groupChoice - 1], filter);
+
+    cout << endl << string(70, '-') << endl;
+    cout << format("{:<24}{:>10}{:>20}\n", dimensionNames[groupChoice - 1], "Count", "Total (RM)");
+    cout << string(70, '-') << endl;
+
+    RevenueCell grandTotal;
+    for (const auto& group : groups) {
+        cout << format("{:<24}{:>10}{:>20}\n",
+            group.first.empty() ? "-" : group.first,
+            group.second.count,
+            group.second.total.toString());
+        grandTotal.count += group.second.count;
+        grandTotal.total += group.second.total;
+    }
+
+    if (groups.empty()) {
+        cout << "No revenue recorded for the selected slice." << endl;
+    }
+
+    cout << string(70, '-') << endl;
+    cout << format("{:<24}{:>10}{:>20}\n", "TOTAL", grandTotal.count, grandTotal.total.toString());
     cout << string(70, '=') << endl;
 }
 
@@ -300,10 +379,18 @@ void displayUpcomingEvents(const SystemData& data) {
     string normalizedCurrentUser = normalizeUserID(data.currentUser);
 
     cout << format("User: {}\n", data.currentUser);
-    cout << string(100, '-') << endl;
-    cout << format("{:<12}{:<15}{:<20}{:<15}{:<10}{:<15}\n",
-        "Date", "Time", "Event Title", "Venue", "Guests", "Status");
-    cout << string(100, '-') << endl;
+    static constexpr TableColumn columns[] = {
+        { "Date", 12 },
+        { "Time", 15 },
+        { "Event Title", 20, true },
+        { "Venue", 15, true },
+        { "Guests", 10 },
+        { "Status", 15 },
+    };
+    TableWriter table(columns);
+    table.rule('-', 100);
+    table.header();
+    table.rule('-', 100);
 
     for (const auto& booking : data.bookings) {
         string normalizedBookingUser = normalizeUserID(booking.eventReg.organizer.userID);
@@ -314,18 +401,14 @@ void displayUpcomingEvents(const SystemData& data) {
                 booking.eventDate.day >= currentDate.day &&
                 booking.bookingStatus != "Cancelled") {
 
-                cout << format("{:<12}{:<15}{:<20}{:<15}{:<10}{:<15}\n",
-                    booking.eventDate.toString(),
-                    booking.eventTime,
-                    booking.eventReg.eventTitle.substr(0, 19),
-                    booking.venue.venueName.substr(0, 14),
-                    booking.eventReg.expectedGuests,
-                    booking.bookingStatus);
-
+                // Still counted once the reader has stopped the listing
+                table.row(booking.eventDate, booking.eventTime, booking.eventReg.eventTitle,
+                    booking.venue.venueName, booking.eventReg.expectedGuests, booking.bookingStatus);
                 myUpcomingCount++;
             }
         }
     }
+    table.flush();
 
     if (myUpcomingCount == 0) {
         cout << "No upcoming events found for your account in the next 30 days." << endl;
@@ -396,6 +479,7 @@ void searchEvents(const SystemData& data) {
     }
 
     string searchTerm = getValidStringInput("Enter search term (event title, manufacturer, or organizer): ");
+    ReadOnlySection readOnly(REGISTRATIONS_DATA | BOOKINGS_DATA, data.currentUser);
     string upperSearchTerm = toUpperCase(searchTerm);
     string normalizedCurrentUser = normalizeUserID(data.currentUser);
 
@@ -469,19 +553,24 @@ void generateEventReport(const SystemData& data) {
         return;
     }
 
+    // Pin the user's records and write the report from them, so other
+    // sessions keep booking while the file is written
+    SnapshotPtr snapshot = takeSnapshot(data, REGISTRATIONS_DATA | BOOKINGS_DATA, data.currentUser);
+    UnlockedSection unlocked;
+
     string normalizedCurrentUser = normalizeUserID(data.currentUser);
     vector<EventRegistration> myRegistrations;
     vector<EventBooking> myBookings;
 
     // Filter user's data
-    for (const auto& reg : data.registrations) {
+    for (const auto& reg : snapshot->registrationsOf(data.currentUser)) {
         string normalizedRegUser = normalizeUserID(reg.organizer.userID);
         if (normalizedRegUser == normalizedCurrentUser) {
             myRegistrations.push_back(reg);
         }
     }
 
-    for (const auto& booking : data.bookings) {
+    for (const auto& booking : snapshot->bookingsOf(data.currentUser)) {
         string normalizedBookingUser = normalizeUserID(booking.eventReg.organizer.userID);
         if (normalizedBookingUser == normalizedCurrentUser) {
             myBookings.push_back(booking);
@@ -506,6 +595,55 @@ void generateEventReport(const SystemData& data) {
         return;
     }
 
+    // The detailed sections are formatted side by side on the background
+    // pool, behind any interactive work
+    WorkerPool& pool = backgroundPool();
+    auto registrationSection = pool.submit(TaskPriority::Bulk, "report registrations", [&myRegistrations] {
+        string section;
+        if (myRegistrations.empty()) {
+            return section;
+        }
+        section += "MY DETAILED REGISTRATIONS\n";
+        section += string(30, '-') + "\n";
+        for (const auto& reg : myRegistrations) {
+            section += format("Event ID: {}\n", reg.eventID);
+            section += format("Title: {}\n", reg.eventTitle);
+            section += format("Manufacturer: {}\n", reg.manufacturer);
+            section += format("Organizer: {}\n", reg.organizer.organizerName);
+            section += format("Status: {}\n", reg.eventStatus);
+            section += format("Expected Guests: {}\n", reg.expectedGuests);
+            section += format("Budget: RM {}\n", reg.estimatedBudget.toString());
+            section += format("Products: {}\n", reg.productQuantity);
+            for (const auto& product : reg.phoneInfo) {
+                section += format("  - {} ({}) RM {}\n",
+                    product.productName,
+                    product.productModel,
+                    product.productPrice.toString());
+            }
+            section += "\n";
+        }
+        return section;
+        });
+    auto bookingSection = pool.submit(TaskPriority::Bulk, "report bookings", [&myBookings] {
+        string section;
+        if (myBookings.empty()) {
+            return section;
+        }
+        section += "MY DETAILED BOOKINGS\n";
+        section += string(30, '-') + "\n";
+        for (const auto& booking : myBookings) {
+            section += format("Booking ID: {}\n", booking.bookingID);
+            section += format("Event: {}\n", booking.eventReg.eventTitle);
+            section += format("Date: {}\n", booking.eventDate.toString());
+            section += format("Time: {}\n", booking.eventTime);
+            section += format("Venue: {}\n", booking.venue.venueName);
+            section += format("Status: {}\n", booking.bookingStatus);
+            section += format("Cost: RM {}\n", booking.finalCost.toString());
+            section += "\n";
+        }
+        return section;
+        });
+
     // Generate personalized report using format
     reportFile << "PERSONAL EVENT MANAGEMENT REPORT" << endl;
     reportFile << format("User: {}\n", data.currentUser);
@@ -518,44 +656,9 @@ void generateEventReport(const SystemData& data) {
     reportFile << format("My Total Registrations: {}\n", myRegistrations.size());
     reportFile << format("My Total Bookings: {}\n", myBookings.size()) << endl;
 
-    // Personal detailed registrations
-    if (!myRegistrations.empty()) {
-        reportFile << "MY DETAILED REGISTRATIONS" << endl;
-        reportFile << string(30, '-') << endl;
-        for (const auto& reg : myRegistrations) {
-            reportFile << format("Event ID: {}\n", reg.eventID);
-            reportFile << format("Title: {}\n", reg.eventTitle);
-            reportFile << format("Manufacturer: {}\n", reg.manufacturer);
-            reportFile << format("Organizer: {}\n", reg.organizer.organizerName);
-            reportFile << format("Status: {}\n", reg.eventStatus); 
-            reportFile << format("Expected Guests: {}\n", reg.expectedGuests);
-            reportFile << format("Budget: RM {:.2f}\n", reg.estimatedBudget);
-            reportFile << format("Products: {}\n", reg.productQuantity);
-            for (const auto& product : reg.phoneInfo) {
-                reportFile << format("  - {} ({}) RM {:.2f}\n",
-                    product.productName,
-                    product.productModel,
-                    product.productPrice);
-            }
-            reportFile << endl;
-        }
-    }
-
-    // Personal detailed bookings
-    if (!myBookings.empty()) {
-        reportFile << "MY DETAILED BOOKINGS" << endl;
-        reportFile << string(30, '-') << endl;
-        for (const auto& booking : myBookings) {
-            reportFile << format("Booking ID: {}\n", booking.bookingID);
-            reportFile << format("Event: {}\n", booking.eventReg.eventTitle);
-            reportFile << format("Date: {}\n", booking.eventDate.toString());
-            reportFile << format("Time: {}\n", booking.eventTime);
-            reportFile << format("Venue: {}\n", booking.venue.venueName);
-            reportFile << format("Status: {}\n", booking.bookingStatus);
-            reportFile << format("Cost: RM {:.2f}\n", booking.finalCost);
-            reportFile << endl;
-        }
-    }
+    // Personal detailed registrations, then bookings
+    reportFile << registrationSection.get();
+    reportFile << bookingSection.get();
 
     reportFile.close();
     cout << format("Personal report generated successfully: {}\n", filename);
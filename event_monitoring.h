@@ -14,5 +14,6 @@ void displayUpcomingEvents(const SystemData& data);
 void displayRegistrationStatistics(const SystemData& data);
 void searchEvents(const SystemData& data);
 void generateEventReport(const SystemData& data);
+void displayRevenueDrillDown(const SystemData& data);
 
 #endif
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "utility_fun.h"
 #include "input_validation.h"
 #include "file_operation.h"
+#include "table_format.h"
 
 using namespace std;
 
@@ -22,6 +23,7 @@ void eventPaymentMenu(SystemData& data) {
     while (!exitMenu) {
         clearScreen();
         displayLogo();
+        runHousekeeping(data);
         cout << "=== MY EVENT PAYMENT ===" << endl;
         cout << format("{:=<50}", "") << endl;
         cout << "1. Make Payment" << endl;
@@ -57,9 +59,76 @@ void eventPaymentMenu(SystemData& data) {
     }
 }
 
-void makePayment(SystemData& data) {
-    const double PROMO_DISCOUNT = 0.10;
+bool applyPromoCode(const string& promoCode, Money& amount) {
+    const int PROMO_DISCOUNT_PERCENT = 10;
+
+    if (promoCode == "PROMO10") { // Example valid promo
+        amount -= amount.percentOf(PROMO_DISCOUNT_PERCENT);
+        return true;
+    }
+    return false;
+}
+
+bool confirmPayment(SystemData& data, Payment& payment) {
+    // The menu checked this before its prompts, but another session may
+    // have paid, cancelled or expired the booking since
+    auto it = data.bookings.begin();
+    while (it != data.bookings.end() && it->bookingID != payment.bookingID) {
+        ++it;
+    }
+    if (it == data.bookings.end() || it->bookingStatus != "Pending") {
+        return false;
+    }
+    for (const auto& existing : data.payments) {
+        if (existing.bookingID == payment.bookingID && existing.paymentStatus == "Completed") {
+            return false;
+        }
+    }
+
+    payment.transactionReference = generateTransactionReference();
+
+    // Update booking status to confirmed
+    EventBooking& booking = *it;
+    booking.bookingStatus = "Confirmed";
+    releaseBookingHold(data.holds, booking.bookingID);
+    trackConfirmedBooking(data.lifecycle, booking.bookingID, booking.eventDate.toDayNumber(), it.handle());
+    recordBookingInCube(data.revenue, booking);
+    recordPaymentInCube(data.revenue, payment, booking);
+
+    data.payments.push_back(payment);
+
+    // Save payment data
+    savePaymentsToFile(data.payments);
+    saveBookingsToFile(data.bookings);
+    saveHoldsToFile(data.holds);
+
+    string owner = booking.eventReg.organizer.userID;
+    data.changes.publish(ChangeKind::PaymentCompleted, payment.paymentID, owner, payment.amount);
+    data.changes.publish(ChangeKind::BookingConfirmed, booking.bookingID, owner, booking.finalCost);
+    return true;
+}
+
+bool refundPayment(SystemData& data, const string& paymentID) {
+    for (auto& payment : data.payments) {
+        if (payment.paymentID == paymentID && payment.paymentStatus == "Completed") {
+            payment.paymentStatus = "Refunded";
+            string owner;
+            for (const auto& booking : data.bookings) {
+                if (booking.bookingID == payment.bookingID) {
+                    recordPaymentInCube(data.revenue, payment, booking);
+                    owner = booking.eventReg.organizer.userID;
+                    break;
+                }
+            }
+            savePaymentsToFile(data.payments);
+            data.changes.publish(ChangeKind::PaymentRefunded, payment.paymentID, owner, payment.amount);
+            return true;
+        }
+    }
+    return false;
+}
 
+void makePayment(SystemData& data) {
     clearScreen();
     cout << "=== MAKE PAYMENT ===" << endl;
     cout << format("{:=<50}", "") << endl;
@@ -103,22 +172,28 @@ void makePayment(SystemData& data) {
 
     // Display unpaid bookings
     cout << "=== YOUR UNPAID BOOKINGS ===" << endl;
-    cout << format("{:=<100}", "") << endl;
-    cout << format("{:<4}{:<10}{:<20}{:<12}{:<15}{:<15}{:<12}",
-        "No.", "Book ID", "Event Title", "Date", "Venue", "Amount (RM)", "Status") << endl;
-    cout << format("{:=<100}", "") << endl;
-
+    static constexpr TableColumn unpaidColumns[] = {
+        { "No.", 4 },
+        { "Book ID", 10 },
+        { "Event Title", 20, true },
+        { "Date", 12 },
+        { "Venue", 15, true },
+        { .header = "Amount (RM)", .width = 15, .align = CellAlign::Right, .prefix = "RM " },
+        { "Status", 12 },
+    };
+    TableWriter table(unpaidColumns, unpaidBookings.size());
+    table.rule('=', 100);
+    table.header();
+    table.rule('=', 100);
     for (size_t i = 0; i < unpaidBookings.size(); i++) {
-        cout << format("{:<4}{:<10}{:<20}{:<12}{:<15}RM {:>12.2f}{:<12}",
-            i + 1,
-            unpaidBookings[i].bookingID,
-            unpaidBookings[i].eventReg.eventTitle.substr(0, 19),
-            unpaidBookings[i].eventDate.toString(),
-            unpaidBookings[i].venue.venueName.substr(0, 14),
-            unpaidBookings[i].finalCost,
-            unpaidBookings[i].bookingStatus) << endl;
+        const EventBooking& booking = unpaidBookings[i];
+        if (!table.row(i + 1, booking.bookingID, booking.eventReg.eventTitle, booking.eventDate,
+            booking.venue.venueName, booking.finalCost, booking.bookingStatus)) {
+            break;
+        }
     }
-    cout << format("{:=<100}", "") << endl;
+    table.rule('=', 100);
+    table.flush();
 
     int bookingChoice = getValidIntegerInput("Select booking to pay for: ", 1, static_cast<int>(unpaidBookings.size()));
     EventBooking selectedBooking = unpaidBookings[bookingChoice - 1];
@@ -126,13 +201,12 @@ void makePayment(SystemData& data) {
     // Promo code (optional)
     cout << "\nDo you have a promo code? (Enter or leave blank): ";
     string promoCode;
-    getline(cin, promoCode);
+    readInputLine(promoCode);
 
     // Apply discount if valid
     if (!promoCode.empty()) {
-        if (promoCode == "PROMO10") { // Example valid promo
+        if (applyPromoCode(promoCode, selectedBooking.finalCost)) {
             cout << "Promo code applied! You get 10% discount." << endl;
-            selectedBooking.finalCost *= (1.0 - PROMO_DISCOUNT);
         }
         else {
             cout << "Invalid promo code. No discount applied." << endl;
@@ -151,7 +225,7 @@ void makePayment(SystemData& data) {
     cout << format("Payment ID: {}", newPayment.paymentID) << endl;
     cout << format("Booking ID: {}", newPayment.bookingID) << endl;
     cout << format("Event: {}", selectedBooking.eventReg.eventTitle) << endl;
-    cout << format("Amount: RM {:.2f}", newPayment.amount) << endl;
+    cout << format("Amount: RM {}", newPayment.amount.toString()) << endl;
     cout << format("Date: {}", newPayment.paymentDate.toString()) << endl;
 
     // Payment method selection
@@ -178,7 +252,7 @@ void makePayment(SystemData& data) {
         string fullCardNumber;
         while (true) {
             cout << "Enter card number (16 digits): ";
-            getline(cin, fullCardNumber);
+            readInputLine(fullCardNumber);
 
             // Remove spaces
             string cleanCard = "";
@@ -201,6 +275,7 @@ void makePayment(SystemData& data) {
                 }
             }
             cout << "Invalid card number. Please enter 16 digits." << endl;
+            rejectScriptedAnswer();
         }
 
         newPayment.cardHolderName = getValidStringInput("Enter cardholder name: ", 2);
@@ -209,10 +284,11 @@ void makePayment(SystemData& data) {
         string expiryDate;
         while (true) {
             cout << "Enter expiry date (MM/YY): ";
-            getline(cin, expiryDate);
+            readInputLine(expiryDate);
 
             if (!regex_match(expiryDate, pattern)) {
                 cout << "Invalid format. Please use MM/YY (e.g., 05/27)." << endl;
+                rejectScriptedAnswer();
                 continue;
             }
 
@@ -220,12 +296,13 @@ void makePayment(SystemData& data) {
             int month = stoi(expiryDate.substr(0, 2));
             int year = stoi(expiryDate.substr(3, 2));
 
-            // demo to get current month/year
-            int currentYear = getCurrentDate().year;
+            // demo to get current month/year (two-digit year, as on the card)
+            int currentYear = getCurrentDate().year % 100;
             int currentMonth = getCurrentDate().month;
 
             if (year < currentYear || (year == currentYear && month < currentMonth)) {
                 cout << "Card expired. Please enter a valid expiry date." << endl;
+                rejectScriptedAnswer();
                 continue;
             }
 
@@ -235,7 +312,7 @@ void makePayment(SystemData& data) {
         string cvv;
         while (true) {
             cout << "Enter CVV (3 digits): ";
-            getline(cin, cvv);
+            readInputLine(cvv);
 
             // Remove spaces
             string cleanCvv = "";
@@ -257,27 +334,29 @@ void makePayment(SystemData& data) {
                 }
             }
             cout << "Invalid card number. Please enter 3 digits." << endl;
+            rejectScriptedAnswer();
         }
 
         cout << "\nProcessing card payment..." << endl;
     }
 
-    newPayment.transactionReference = generateTransactionReference();
-
-    // Update booking status to confirmed
-    for (auto& booking : data.bookings) {
-        if (booking.bookingID == selectedBooking.bookingID) {
-            booking.bookingStatus = "Confirmed";
-            break;
-        }
+    // Another session may have taken the ID shown above while we waited
+    newPayment.paymentID = generatePaymentID(data.payments);
+    if (!confirmPayment(data, newPayment)) {
+        cout << "\nPayment not taken: booking " << newPayment.bookingID
+            << " was paid, cancelled or expired in the meantime." << endl;
+        return;
+    }
+    // Only confirmed to the operator once it is on disk
+    {
+        UnlockedSection unlocked;
+        waitForSaves(data);
     }
-
-    data.payments.push_back(newPayment);
 
     cout << "\n=== PAYMENT SUCCESSFUL ===" << endl;
     cout << format("Payment ID: {}", newPayment.paymentID) << endl;
     cout << format("Transaction Reference: {}", newPayment.transactionReference) << endl;
-    cout << format("Amount Paid: RM {:.2f}", newPayment.amount) << endl;
+    cout << format("Amount Paid: RM {}", newPayment.amount.toString()) << endl;
     cout << format("Payment Method: {}", newPayment.paymentMethod) << endl;
     cout << format("Status: {}", newPayment.paymentStatus) << endl;
 
@@ -286,10 +365,6 @@ void makePayment(SystemData& data) {
     }
 
     cout << "\nYour booking is now confirmed!" << endl;
-
-    // Save payment data
-    savePaymentsToFile(data.payments);
-    saveBookingsToFile(data.bookings);
 }
 
 void viewPaymentHistory(const SystemData& data) {
@@ -300,8 +375,13 @@ void viewPaymentHistory(const SystemData& data) {
         cout << "Error: No user logged in!" << endl;
         return;
     }
+    // Everyone's payments are scanned, so work from a pinned copy and
+    // leave the tables to the other sessions
+    SnapshotPtr snapshot = takeSnapshot(data, PAYMENTS_DATA | BOOKINGS_DATA, data.currentUser);
+    UnlockedSection unlocked;
+    const vector<Payment>& payments = snapshot->allPayments();
 
-    if (data.payments.empty()) {
+    if (payments.empty()) {
         cout << "No payment records found." << endl;
         return;
     }
@@ -310,9 +390,9 @@ void viewPaymentHistory(const SystemData& data) {
     vector<Payment> userPayments;
     string normalizedCurrentUser = normalizeUserID(data.currentUser);
 
-    for (const auto& payment : data.payments) {
+    for (const auto& payment : payments) {
         // Find the corresponding booking to verify ownership
-        for (const auto& booking : data.bookings) {
+        for (const auto& booking : snapshot->bookingsOf(data.currentUser)) {
             if (booking.bookingID == payment.bookingID) {
                 string normalizedBookingUser = normalizeUserID(booking.eventReg.organizer.userID);
                 if (normalizedBookingUser == normalizedCurrentUser) {
@@ -328,33 +408,40 @@ void viewPaymentHistory(const SystemData& data) {
         return;
     }
 
-    cout << format("{:=<130}", "") << endl;
-    cout << format("{:<12}{:<12}{:<12}{:<12}{:<15}{:<12}{:<20}{:<12}",
-        "Payment ID", "Booking ID", "Amount", "Date", "Method", "Status", "Reference", "Card") << endl;
-    cout << format("{:=<130}", "") << endl;
-
-    double totalPaid = 0.0;
+    static constexpr TableColumn historyColumns[] = {
+        { "Payment ID", 12 },
+        { "Booking ID", 12 },
+        { .header = "Amount", .width = 12, .align = CellAlign::Right, .prefix = "RM " },
+        { "Date", 12 },
+        { "Method", 15, true },
+        { "Status", 12 },
+        { "Reference", 20, true },
+        { "Card", 12 },
+    };
+    TableWriter table(historyColumns, userPayments.size());
+    table.rule('=', 130);
+    table.header();
+    table.rule('=', 130);
+
+    Money totalPaid;
+    string cardDisplay;
     for (const auto& payment : userPayments) {
-        string cardDisplay = payment.cardNumber.empty() ? "N/A" : format("****{}", payment.cardNumber);
-
-        cout << format("{:<12}{:<12}RM {:>9.2f}{:<12}{:<15}{:<12}{:<20}{:<12}",
-            payment.paymentID,
-            payment.bookingID,
-            payment.amount,
-            payment.paymentDate.toString(),
-            payment.paymentMethod.substr(0, 14),
-            payment.paymentStatus,
-            payment.transactionReference.substr(0, 19),
-            cardDisplay) << endl;
+        cardDisplay = payment.cardNumber.empty() ? "N/A" : "****";
+        cardDisplay += payment.cardNumber;
+
+        // Still totalled once the reader has stopped the listing
+        table.row(payment.paymentID, payment.bookingID, payment.amount, payment.paymentDate,
+            payment.paymentMethod, payment.paymentStatus, payment.transactionReference, cardDisplay);
 
         if (payment.paymentStatus == "Completed") {
             totalPaid += payment.amount;
         }
     }
 
-    cout << format("{:=<130}", "") << endl;
+    table.rule('=', 130);
+    table.flush();
     cout << format("Total Payments: {}", userPayments.size()) << endl;
-    cout << format("Total Amount Paid: RM {:.2f}", totalPaid) << endl;
+    cout << format("Total Amount Paid: RM {}", totalPaid.toString()) << endl;
 }
 
 void processRefund(SystemData& data) {
@@ -399,11 +486,11 @@ void processRefund(SystemData& data) {
     cout << format("{:=<100}", "") << endl;
 
     for (size_t i = 0; i < refundablePayments.size(); i++) {
-        cout << format("{:<4}{:<12}{:<12}RM {:>12.2f}{:<15}{:<20}",
+        cout << format("{:<4}{:<12}{:<12}RM {:>12}{:<15}{:<20}",
             i + 1,
             refundablePayments[i].paymentID,
             refundablePayments[i].bookingID,
-            refundablePayments[i].amount,
+            refundablePayments[i].amount.toString(),
             refundablePayments[i].paymentMethod.substr(0, 14),
             refundablePayments[i].transactionReference) << endl;
     }
@@ -414,23 +501,21 @@ void processRefund(SystemData& data) {
 
     cout << "\n=== REFUND DETAILS ===" << endl;
     cout << format("Payment ID: {}", selectedPayment.paymentID) << endl;
-    cout << format("Amount to refund: RM {:.2f}", selectedPayment.amount) << endl;
+    cout << format("Amount to refund: RM {}", selectedPayment.amount.toString()) << endl;
     cout << format("Original payment method: {}", selectedPayment.paymentMethod) << endl;
 
     vector<char> validChars = { 'Y', 'N' };
     char confirm = getValidCharInput("\nConfirm refund processing? (Y/N): ", validChars);
 
     if (confirm == 'Y') {
-        // Update payment status to refunded
-        for (auto& payment : data.payments) {
-            if (payment.paymentID == selectedPayment.paymentID) {
-                payment.paymentStatus = "Refunded";
-                break;
-            }
+        // Another session may have refunded it while we waited for the answer
+        if (!refundPayment(data, selectedPayment.paymentID)) {
+            cout << format("\nPayment {} has already been refunded. Nothing was processed.", selectedPayment.paymentID) << endl;
+            return;
         }
 
         cout << "\n=== REFUND PROCESSED ===" << endl;
-        cout << format("Refund amount: RM {:.2f}", selectedPayment.amount) << endl;
+        cout << format("Refund amount: RM {}", selectedPayment.amount.toString()) << endl;
         cout << "Processing time: 5-7 business days" << endl;
         cout << "Refund method: Original payment method" << endl;
 
@@ -439,9 +524,6 @@ void processRefund(SystemData& data) {
         }
 
         cout << "\nYou will receive a refund confirmation email shortly." << endl;
-
-        // Save updated payment data
-        savePaymentsToFile(data.payments);
     }
     else {
         cout << "Refund cancelled." << endl;
@@ -457,75 +539,63 @@ void viewPaymentStatistics(const SystemData& data) {
         return;
     }
 
-    // Filter payments for current user
-    vector<Payment> userPayments;
-    string normalizedCurrentUser = normalizeUserID(data.currentUser);
+    // Statistics come straight from the user's slice of the revenue cube
+    RevenueFilter filter;
+    filter.organizerID = normalizeUserID(data.currentUser);
 
-    for (const auto& payment : data.payments) {
-        // Find the corresponding booking to verify ownership
-        for (const auto& booking : data.bookings) {
-            if (booking.bookingID == payment.bookingID) {
-                string normalizedBookingUser = normalizeUserID(booking.eventReg.organizer.userID);
-                if (normalizedBookingUser == normalizedCurrentUser) {
-                    userPayments.push_back(payment);
-                    break;
-                }
-            }
-        }
+    map<string, RevenueCell> byStatus = rollupPaymentRevenue(data.revenue, RevenueDimension::Status, filter);
+    map<string, RevenueCell> byMethod = rollupPaymentRevenue(data.revenue, RevenueDimension::PaymentMethod, filter);
+
+    int totalPayments = 0;
+    for (const auto& status : byStatus) {
+        totalPayments += status.second.count;
     }
 
-    if (userPayments.empty()) {
+    if (totalPayments == 0) {
         cout << "No payment statistics available." << endl;
         return;
     }
 
-    // Calculate statistics
-    double totalCompleted = 0.0, totalRefunded = 0.0;
-    int completedCount = 0, refundedCount = 0;
-    map<string, int> methodCount;
-    map<string, double> methodAmount;
-
-    for (const auto& payment : userPayments) {
-        methodCount[payment.paymentMethod]++;
-        methodAmount[payment.paymentMethod] += payment.amount;
-
-        if (payment.paymentStatus == "Completed") {
-            totalCompleted += payment.amount;
-            completedCount++;
-        }
-        else if (payment.paymentStatus == "Refunded") {
-            totalRefunded += payment.amount;
-            refundedCount++;
-        }
-    }
+    RevenueCell completed = byStatus["Completed"];
+    RevenueCell refunded = byStatus["Refunded"];
 
     cout << format("{:=<60}", "") << endl;
     cout << "PAYMENT SUMMARY:" << endl;
     cout << format("{:-<60}", "") << endl;
-    cout << format("{:<24}: {}", "Total Payments Made", userPayments.size()) << endl;
-    cout << format("{:<24}: {}", "Completed Payments", completedCount) << endl;
-    cout << format("{:<24}: {}", "Refunded Payments", refundedCount) << endl;
-    cout << format("{:<24}: RM {:.2f}", "Total Amount Paid", totalCompleted) << endl;
-    cout << format("{:<24}: RM {:.2f}", "Total Amount Refunded", totalRefunded) << endl;
-    cout << format("{:<24}: RM {:.2f}", "Net Amount", (totalCompleted - totalRefunded)) << endl;
+    cout << format("{:<24}: {}", "Total Payments Made", totalPayments) << endl;
+    cout << format("{:<24}: {}", "Completed Payments", completed.count) << endl;
+    cout << format("{:<24}: {}", "Refunded Payments", refunded.count) << endl;
+    cout << format("{:<24}: RM {}", "Total Amount Paid", completed.total.toString()) << endl;
+    cout << format("{:<24}: RM {}", "Total Amount Refunded", refunded.total.toString()) << endl;
+    cout << format("{:<24}: RM {}", "Net Amount", (completed.total - refunded.total).toString()) << endl;
 
     cout << "\nPAYMENT METHOD BREAKDOWN:" << endl;
     cout << format("{:-<60}", "") << endl;
     cout << format("{:<20}{:<10}{:<15}", "Method", "Count", "Amount") << endl;
     cout << format("{:-<60}", "") << endl;
 
-    for (const auto& method : methodCount) {
-        cout << format("{:<20}{:<10}RM {:.2f}",
+    for (const auto& method : byMethod) {
+        cout << format("{:<20}{:<10}RM {}",
             method.first,
-            method.second,
-            methodAmount[method.first]) << endl;
+            method.second.count,
+            method.second.total.toString()) << endl;
     }
 
     cout << format("{:=<60}", "") << endl;
 }
 
+// Seed once: reseeding from time(0) on every call hands every payment
+// made within the same second the same numbers
+static void seedPaymentRandom() {
+    static bool seeded = false;
+    if (!seeded) {
+        srand(static_cast<unsigned int>(time(0)));
+        seeded = true;
+    }
+}
+
 string generatePaymentID(const vector<Payment>& payments) {
-    srand(static_cast<unsigned int>(time(0)));
+    seedPaymentRandom();
     string paymentID;
     bool isUnique = false;
 
@@ -545,7 +615,7 @@ string generatePaymentID(const vector<Payment>& payments) {
 }
 
 string generateTransactionReference() {
-    srand(static_cast<unsigned int>(time(0)));
+    seedPaymentRandom();
     string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
     string reference = "TXN";
 
@@ -4,6 +4,7 @@
 
 #include "date.h"
 #include "event_booking.h"
+#include "money.h"
 #include <string>
 #include <vector>
 
@@ -13,7 +14,7 @@ using namespace std;
 struct Payment {
     string paymentID;
     string bookingID;
-    double amount;
+    Money amount;
     Date paymentDate;
     string paymentMethod; // "Credit Card", "Debit Card", "Bank Transfer", "Cash"
     string paymentStatus; // "Pending", "Completed", "Failed", "Refunded"
@@ -35,6 +36,13 @@ void makePayment(SystemData& data);
 void viewPaymentHistory(const SystemData& data);
 void processRefund(SystemData& data);
 void viewPaymentStatistics(const SystemData& data); 
+
+// Non-interactive cores shared by the menus and the JSON protocol
+bool applyPromoCode(const string& promoCode, Money& amount);       // false if not recognised
+// Records the payment, confirms the booking and saves. False, recording
+// nothing, when the booking is gone, no longer Pending or already paid.
+bool confirmPayment(SystemData& data, Payment& payment);
+bool refundPayment(SystemData& data, const string& paymentID);      // false unless a Completed payment
 string generatePaymentID(const vector<Payment>& payments);
 string generateTransactionReference();
 string maskCardNumber(const string& cardNumber);
@@ -9,6 +9,8 @@
 #include <sstream>
 #include <cstdlib>
 #include <regex>
+#include <format>
+#include <iterator>
 #include "date.h"
 #include "venue.h"
 #include "user.h"
@@ -16,9 +18,14 @@
 #include "utility_fun.h"
 #include "input_validation.h"
 #include "file_operation.h"
+#include "cascade.h"
+#include "table_format.h"
 
 using namespace std;
 
+// Each registration is a block of a dozen lines or more
+static const size_t REGISTRATION_PAGE_ITEMS = 5;
+
 // Event Registration System Functions
 void eventRegistrationMenu(SystemData& data) {
     bool exitMenu = false;
@@ -31,10 +38,11 @@ void eventRegistrationMenu(SystemData& data) {
         cout << "2. View My Event Registrations" << endl;
         cout << "3. Update Event Registration" << endl;
         cout << "4. Cancel / Delete Event Registration" << endl;
-        cout << "5. Back to Main Menu" << endl;
+        cout << "5. Withdraw a Manufacturer From a Season" << endl;
+        cout << "6. Back to Main Menu" << endl;
         cout << setfill('=') << setw(50) << "=" << setfill(' ') << endl;
 
-        int choice = getValidIntegerInput("Enter your choice [1-5]: ", 1, 5);
+        int choice = getValidIntegerInput("Enter your choice [1-6]: ", 1, 6);
 
         switch (choice) {
         case 1:
@@ -50,11 +58,14 @@ void eventRegistrationMenu(SystemData& data) {
             deleteEventRegistration(data);
             break;
         case 5:
+            withdrawManufacturerSeason(data);
+            break;
+        case 6:
             exitMenu = true;
             break;
         }
 
-        if (choice != 5) {
+        if (choice != 6) {
             pauseScreen();
         }
     }
@@ -201,7 +212,7 @@ void createEventRegistration(SystemData& data) {
             return;
         }
 
-        newReg.phoneInfo[i] = { productName, productModel, productPrice };
+        newReg.phoneInfo[i] = { productName, productModel, Money::fromDouble(productPrice) };
     }
 
     // Additional details section
@@ -221,11 +232,12 @@ void createEventRegistration(SystemData& data) {
         return;
     }
 
-    newReg.estimatedBudget = getValidDoubleInputWithExit("Enter Estimated Budget (RM): ", 2500);
-    if (newReg.estimatedBudget == -1.0) {
+    double estimatedBudget = getValidDoubleInputWithExit("Enter Estimated Budget (RM): ", 2500);
+    if (estimatedBudget == -1.0) {
         confirmExit();
         return;
     }
+    newReg.estimatedBudget = Money::fromDouble(estimatedBudget);
 
     newReg.eventStatus = "UNSCHEDULED";
 
@@ -261,10 +273,11 @@ void createEventRegistration(SystemData& data) {
     cout << "Contact No: " << newReg.organizer.organizerContact << endl;
     cout << "Email Address: " << newReg.organizer.organizerEmail << endl;
     cout << "Expected Guests: " << newReg.expectedGuests << endl;
-    cout << "Estimated Budget: RM " << fixed << setprecision(2) << newReg.estimatedBudget << endl;
+    cout << "Estimated Budget: RM " << newReg.estimatedBudget << endl;
     cout << "Status: " << newReg.eventStatus << endl;
 
     saveRegistrationsToFile(data.registrations);
+    data.changes.publish(ChangeKind::RegistrationCreated, newReg.eventID, newReg.organizer.userID);
 }
 
 void viewEventRegistrations(const SystemData& data) {
@@ -298,31 +311,32 @@ void viewEventRegistrations(const SystemData& data) {
         return;
     }
 
-    //Display user's registrations only
+    //Display user's registrations only, a few blocks to a page
+    PagedOutput pages(REGISTRATION_PAGE_ITEMS, userRegistrations.size());
+    string& out = pages.buffer();
     for (const auto& reg : userRegistrations) {
-        cout << left << '+' << setfill('=') << setw(100) << '+' << endl;
-        cout << "Event ID: " << reg.eventID << endl;
-        cout << "Event Title: " << reg.eventTitle << endl;
-        cout << "Manufacturer: " << reg.manufacturer << endl;
-        cout << "Product launched quantity: " << reg.productQuantity << endl;
+        if (!pages.beginItem()) {
+            break;
+        }
+        out += "++";
+        out.append(99, '=');
+        format_to(back_inserter(out), "\nEvent ID: {}\nEvent Title: {}\nManufacturer: {}\nProduct launched quantity: {}\n",
+            reg.eventID, reg.eventTitle, reg.manufacturer, reg.productQuantity);
 
         for (int i = 0; i < reg.productQuantity; i++) {
-            cout << "Product " << i + 1 << ": " << endl;
-            cout << "  Product Name: " << reg.phoneInfo[i].productName << endl;
-            cout << "  Product Model: " << reg.phoneInfo[i].productModel << endl;
-            cout << "  Product Price (RM): " << fixed << setprecision(2) << reg.phoneInfo[i].productPrice << endl;
+            format_to(back_inserter(out), "Product {}: \n  Product Name: {}\n  Product Model: {}\n  Product Price (RM): {}\n",
+                i + 1, reg.phoneInfo[i].productName, reg.phoneInfo[i].productModel, reg.phoneInfo[i].productPrice.toString());
         }
 
-        cout << "Event Description: " << reg.description << endl;
-        cout << "Organizer Name: " << reg.organizer.organizerName << " (" << reg.organizer.position << ")" << endl;
-        cout << "Organizer Contact No: " << reg.organizer.organizerContact << endl;
-        cout << "Organizer Email Address: " << reg.organizer.organizerEmail << endl;
-        cout << "Maximum Participants: " << reg.expectedGuests << endl;
-        cout << "Budget: RM " << fixed << setprecision(2) << reg.estimatedBudget << endl;
-        cout << "Status: " << reg.eventStatus << endl;
+        format_to(back_inserter(out), "Event Description: {}\nOrganizer Name: {} ({})\nOrganizer Contact No: {}\n"
+            "Organizer Email Address: {}\nMaximum Participants: {}\nBudget: RM {}\nStatus: {}\n",
+            reg.description, reg.organizer.organizerName, reg.organizer.position, reg.organizer.organizerContact,
+            reg.organizer.organizerEmail, reg.expectedGuests, reg.estimatedBudget.toString(), reg.eventStatus);
     }
-
-    cout << left << '+' << setfill('=') << setw(100) << '+' << endl;
+    out += "++";
+    out.append(99, '=');
+    out += '\n';
+    pages.flush();
     cout << "Total Your Registrations: " << userRegistrations.size() << endl;
 }
 
@@ -434,7 +448,7 @@ void editPhoneInfo(EventRegistration* regPtr) {
             cout << "Phone " << i << ": " << endl;
             cout << "  Name : " << phone.productName << endl;
             cout << "  Model: " << phone.productModel << endl;
-            cout << "  Price: RM " << fixed << setprecision(2) << phone.productPrice << endl;
+            cout << "  Price: RM " << phone.productPrice << endl;
             i++;
         }
 
@@ -471,7 +485,7 @@ void editPhoneInfo(EventRegistration* regPtr) {
                 return;
             }
 
-            regPtr->phoneInfo.push_back({ productName, productModel, productPrice });
+            regPtr->phoneInfo.push_back({ productName, productModel, Money::fromDouble(productPrice) });
 
             regPtr->productQuantity = regPtr->phoneInfo.size();
             cout << "Phone added successfully!" << endl;
@@ -500,12 +514,12 @@ void editPhoneInfo(EventRegistration* regPtr) {
             // Price
             string newPrice;
             cout << endl << "Enter new price (or press Enter to keep current): ";
-            getline(cin, newPrice);
+            readInputLine(newPrice);
             if (!newPrice.empty()) {
                 try {
-                    double newPriceDouble = stod(newPrice);
-                    if (newPriceDouble > 0) {
-                        phone.productPrice = newPriceDouble;
+                    Money newPriceMoney = Money::parse(newPrice);
+                    if (newPriceMoney > Money()) {
+                        phone.productPrice = newPriceMoney;
                         cout << "Price updated successfully!" << endl;
                     }
                     else {
@@ -567,12 +581,13 @@ void updateEventRegistration(SystemData& data) {
         cout << "Normalized Current User: '" << normalizedCurrentUser << "'" << endl;
         cout << "Total Registrations: " << data.registrations.size() << endl;
 
-        for (size_t i = 0; i < data.registrations.size(); i++) {
-            cout << "Registration " << (i + 1) << ":" << endl;
-            cout << "  Event ID: " << data.registrations[i].eventID << endl;
-            cout << "  Organizer User ID: '" << data.registrations[i].organizer.userID << "'" << endl;
-            cout << "  Normalized: '" << normalizeUserID(data.registrations[i].organizer.userID) << "'" << endl;
-            cout << "  Match: " << (normalizeUserID(data.registrations[i].organizer.userID) == normalizedCurrentUser ? "YES" : "NO") << endl;
+        size_t number = 0;
+        for (const auto& reg : data.registrations) {
+            cout << "Registration " << ++number << ":" << endl;
+            cout << "  Event ID: " << reg.eventID << endl;
+            cout << "  Organizer User ID: '" << reg.organizer.userID << "'" << endl;
+            cout << "  Normalized: '" << normalizeUserID(reg.organizer.userID) << "'" << endl;
+            cout << "  Match: " << (normalizeUserID(reg.organizer.userID) == normalizedCurrentUser ? "YES" : "NO") << endl;
         }
         return;
     }
@@ -609,7 +624,7 @@ void updateEventRegistration(SystemData& data) {
         cout << "Phone " << i << ": " << endl;
         cout << "Phone Name: " << phone.productName << endl;
         cout << "Phone Model: " << phone.productModel << endl;
-        cout << "Phone Price: " << fixed << setprecision(2) << phone.productPrice << endl;
+        cout << "Phone Price: " << phone.productPrice << endl;
         i++;
     }
     cout << "Manufacturer: " << regPtr->manufacturer << endl;
@@ -617,7 +632,7 @@ void updateEventRegistration(SystemData& data) {
     cout << "Organizer: " << regPtr->organizer.organizerName << endl;
     cout << "Contact: " << regPtr->organizer.organizerContact << endl;
     cout << "Maximum Participants: " << regPtr->expectedGuests << endl;
-    cout << "Budget: RM " << fixed << setprecision(2) << regPtr->estimatedBudget << endl;
+    cout << "Budget: RM " << regPtr->estimatedBudget << endl;
     cout << "Status: " << regPtr->eventStatus << endl;
 
     cout << "\nWhat would you like to update?" << endl;
@@ -658,13 +673,16 @@ void updateEventRegistration(SystemData& data) {
         regPtr->expectedGuests = getValidIntegerInput("Enter new Expected Guests (100-1200): ", 100, 1200);
         break;
     case 6:
-        regPtr->estimatedBudget = getValidDoubleInput("Enter new Estimated Budget (RM): ");
+        regPtr->estimatedBudget = Money::fromDouble(getValidDoubleInput("Enter new Estimated Budget (RM): "));
         break;
     case 7:
         break;
     }
 
     saveRegistrationsToFile(data.registrations);
+    if (choice != 7) {
+        data.changes.publish(ChangeKind::RegistrationUpdated, regPtr->eventID, regPtr->organizer.userID);
+    }
     cout << "Event registration updated successfully!" << endl;
 }
 
@@ -700,51 +718,38 @@ void deleteEventRegistration(SystemData& data) {
     eventID = toUpperCase(eventID);
 
     // Find registration and verify ownership - FIXED WITH NORMALIZATION
-    int regIndex = -1;
-    for (size_t i = 0; i < data.registrations.size(); i++) {
-        string normalizedRegUser = normalizeUserID(data.registrations[i].organizer.userID);
-        if (data.registrations[i].eventID == eventID &&
+    RecordHandle regHandle;
+    for (auto it = data.registrations.begin(); it != data.registrations.end(); ++it) {
+        string normalizedRegUser = normalizeUserID(it->organizer.userID);
+        if (it->eventID == eventID &&
             normalizedRegUser == normalizedCurrentUser) {
-            regIndex = i;
+            regHandle = it.handle();
             break;
         }
     }
 
-    if (regIndex == -1) {
+    if (!regHandle.valid()) {
         cout << "Event registration not found or you don't have permission to cancel/delete it!" << endl;
         return;
     }
 
     cout << "\n=== Registration Details to Cancel ===" << endl;
-    cout << "Event ID: " << data.registrations[regIndex].eventID << endl;
-    cout << "Event Title: " << data.registrations[regIndex].eventTitle << endl;
-    cout << "Manufacturer: " << data.registrations[regIndex].manufacturer << endl;
-    cout << "Organizer: " << data.registrations[regIndex].organizer.organizerName << endl;
-    cout << "Current Status: " << data.registrations[regIndex].eventStatus << endl;
+    cout << "Event ID: " << data.registrations[regHandle].eventID << endl;
+    cout << "Event Title: " << data.registrations[regHandle].eventTitle << endl;
+    cout << "Manufacturer: " << data.registrations[regHandle].manufacturer << endl;
+    cout << "Organizer: " << data.registrations[regHandle].organizer.organizerName << endl;
+    cout << "Current Status: " << data.registrations[regHandle].eventStatus << endl;
 
-    if (data.registrations[regIndex].eventStatus == "CANCELLED") {
+    if (data.registrations[regHandle].eventStatus == "CANCELLED") {
         cout << "This event is already CANCELLED. " << endl;
         vector<char> validChars = { 'Y', 'N' };
         char confirmDel = getValidCharInput("Do you want to permanently delete this event? (Y/N): ", validChars);
 
         if (confirmDel == 'Y') {
-            string eventIDToDelete = data.registrations[regIndex].eventID;
-
-            // delete event
-            data.registrations.erase(data.registrations.begin() + regIndex);
-
-            // delete related bookings
-            for (size_t i = 0; i < data.bookings.size(); ) {
-                if (data.bookings[i].eventReg.eventID == eventIDToDelete) {
-                    data.bookings.erase(data.bookings.begin() + i);
-                }
-                else {
-                    i++;
-                }
-            }
-
-            saveRegistrationsToFile(data.registrations);
-            saveBookingsToFile(data.bookings);
+            // delete event and related bookings
+            CascadePlan plan;
+            plan.deleteRegistrations.insert(data.registrations[regHandle].eventID);
+            applyCascade(data, plan);
 
             cout << "Event and all related bookings deleted permanently!" << endl;
         }
@@ -754,11 +759,11 @@ void deleteEventRegistration(SystemData& data) {
         return;
     }
     // Check if registration has active bookings
-    vector<int> affectedBookings;
-    for (size_t i = 0; i < data.bookings.size(); i++) {
-        if (data.bookings[i].eventReg.eventID == eventID &&
-            data.bookings[i].bookingStatus != "Cancelled") {
-            affectedBookings.push_back(i);
+    vector<RecordHandle> affectedBookings;
+    for (auto it = data.bookings.begin(); it != data.bookings.end(); ++it) {
+        if (it->eventReg.eventID == eventID &&
+            it->bookingStatus != "Cancelled") {
+            affectedBookings.push_back(it.handle());
         }
     }
 
@@ -774,20 +779,10 @@ void deleteEventRegistration(SystemData& data) {
 
     // Cancel event process
     if (confirm == 'Y') {
-        // Cancel the event registration
-        data.registrations[regIndex].eventStatus = "CANCELLED";
-
-        // Cancel all active bookings for this event
-        int cancelledBookings = 0;
-        for (int bookingIndex : affectedBookings) {
-            data.bookings[bookingIndex].bookingStatus = "Cancelled";
-            removeBookingFromVenueSchedule(data.venues, data.bookings[bookingIndex].bookingID);
-            cancelledBookings++;
-        }
-
-        // Save changes to files
-        saveRegistrationsToFile(data.registrations);
-        saveBookingsToFile(data.bookings);
+        // Cancel the event, all its active bookings and its waitlist entries
+        CascadePlan plan;
+        plan.cancelRegistrations.insert(eventID);
+        int cancelledBookings = applyCascade(data, plan).bookingsCancelled;
 
         cout << "\nEvent registration cancelled successfully!" << endl;
         if (cancelledBookings > 0) {
@@ -812,4 +807,53 @@ void deleteEventRegistration(SystemData& data) {
     else {
         cout << "Cancellation aborted." << endl;
     }
+}
+
+void withdrawManufacturerSeason(SystemData& data) {
+    clearScreen();
+    cout << "=== WITHDRAW MANUFACTURER FROM A SEASON ===" << endl;
+
+    if (data.currentUser.empty()) {
+        cout << "Error: No user logged in!" << endl;
+        return;
+    }
+
+    string manufacturer = getValidStringInputWithExit("\nManufacturer to withdraw ");
+    if (manufacturer.empty()) return;
+
+    cout << "\nSeason start:" << endl;
+    Date from = getValidDateInput();
+    cout << "\nSeason end:" << endl;
+    Date to = getValidDateInput();
+    if (to.toDayNumber() < from.toDayNumber()) {
+        swap(from, to);
+    }
+
+    CascadePlan plan;
+    int events = planManufacturerWithdrawal(data, plan, data.currentUser, manufacturer, from, to);
+    if (events == 0) {
+        cout << "No active " << manufacturer << " bookings of yours between " << from.toString()
+            << " and " << to.toString() << "." << endl;
+        return;
+    }
+
+    cout << "\n" << events << " event(s) with active bookings in this season will be CANCELLED:" << endl;
+    for (const auto& eventID : plan.cancelRegistrations) {
+        cout << "  - " << eventID << endl;
+    }
+
+    vector<char> validChars = { 'Y', 'N' };
+    char confirm = getValidCharInput("Cancel all of them? (Y/N): ", validChars);
+    if (confirm != 'Y') {
+        cout << "Withdrawal aborted." << endl;
+        return;
+    }
+
+    CascadeResult result = applyCascade(data, plan);
+    cout << "\nCancelled " << result.registrationsCancelled << " event(s) and "
+        << result.bookingsCancelled << " booking(s); " << result.slotsReleased << " venue slot(s) released";
+    if (result.waitlistPromotions > 0) {
+        cout << ", " << result.waitlistPromotions << " given to waitlisted events";
+    }
+    cout << "." << endl;
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <string>
 #include "product.h"
 #include "user.h"
+#include "money.h"
+#include "record_table.h"
 using namespace std;
 
 struct EventRegistration {
@@ -16,11 +18,13 @@ struct EventRegistration {
     vector<Product> phoneInfo;   // one or many phone models
     string description;          // describe the event activity
     int expectedGuests;          // how many people attend
-    double estimatedBudget;
+    Money estimatedBudget;
     string eventStatus;          // "REGISTERED", "SCHEDULED", "UNSCHEDULED"
     Organizer organizer;
 };
 
+using RegistrationTable = RecordTable<EventRegistration>;
+
 // Function prototypes - Event Registration System
 class SystemData;
 struct EventBooking;
@@ -30,4 +34,5 @@ void viewEventRegistrations(const SystemData& data);
 void editPhoneInfo(EventRegistration* regPtr);
 void updateEventRegistration(SystemData& data);
 void deleteEventRegistration(SystemData& data);
+void withdrawManufacturerSeason(SystemData& data);
 #endif
\ No newline at end of file
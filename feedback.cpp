@@ -1,9 +1,12 @@
 #include "feedback.h"
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include "utility_fun.h"
 #include "system_data.h"
 #include "input_validation.h"
 #include "file_operation.h"
+#include "booking_lifecycle.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -21,28 +24,41 @@ void feedbackMenu(SystemData& data) {
         cout << "2. View My Feedback" << endl;
         cout << "3. View My Feedback Statistics" << endl;
         cout << "4. Delete My Feedback" << endl;
-        cout << "5. Back to Main Menu" << endl;
+        cout << "5. Search Feedback Comments" << endl;
+        cout << "6. Back to Main Menu" << endl;
         cout << setfill('=') << setw(60) << "=" << setfill(' ') << endl;
 
-        int choice = getValidIntegerInput("Enter your choice [1-5]: ", 1, 5);
+        int choice = getValidIntegerInput("Enter your choice [1-6]: ", 1, 6);
 
         switch (choice) {
         case 1:  submitEventFeedback(data); break;
         case 2:  viewAllFeedback(data); break;
         case 3:  viewFeedbackStatistics(data); break;
         case 4:  deleteFeedback(data); break;
-        case 5:  exitMenu = true; break;
+        case 5:  searchFeedbackComments(data); break;
+        case 6:  exitMenu = true; break;
         }
 
-        if (choice != 5) {
+        if (choice != 6) {
             pauseScreen();
         }
     }
 }
 
-// Generate unique feedback ID
+// Generate unique feedback ID (one past the highest in use, so IDs are not reused after a delete)
 string generateFeedbackID(const SystemData& data) {
-    return "FB" + to_string(1000 + data.feedbacks.size());
+    int highest = 999;
+    for (const auto& feedback : data.feedbacks) {
+        if (feedback.feedbackID.size() > 2 && feedback.feedbackID.compare(0, 2, "FB") == 0) {
+            try {
+                highest = max(highest, stoi(feedback.feedbackID.substr(2)));
+            }
+            catch (const exception&) {
+                // Ignore IDs that are not FB<number>
+            }
+        }
+    }
+    return "FB" + to_string(highest + 1);
 }
 
 // Submit new event feedback
@@ -58,14 +74,24 @@ void submitEventFeedback(SystemData& data) {
         return;
     }
 
-    // Check if there are any completed bookings for current user
+    // Check if there are any completed bookings for current user. Completed
+    // also covers events that simply took place, so those already reviewed
+    // are left out by their feedback, not their status.
     vector<EventBooking*> userCompletedBookings;
     string normalizedCurrentUser = normalizeUserID(data.currentUser);
 
+    unordered_set<string> reviewed;
+    for (const auto& feedback : data.feedbacks) {
+        if (normalizeUserID(feedback.submittedBy) == normalizedCurrentUser) {
+            reviewed.insert(feedback.bookingID);
+        }
+    }
+
     for (auto& booking : data.bookings) {
         string normalizedBookingUser = normalizeUserID(booking.eventReg.organizer.userID);
         if (normalizedBookingUser == normalizedCurrentUser &&
-            (booking.bookingStatus == "Confirmed")) {
+            (booking.bookingStatus == "Confirmed" || booking.bookingStatus == "Completed") &&
+            !reviewed.contains(booking.bookingID)) {
             userCompletedBookings.push_back(&booking);
         }
     }
@@ -172,20 +198,19 @@ void submitEventFeedback(SystemData& data) {
     // Get comments
     cout << "\nPlease provide your comments:" << endl;
     cout << "Venue Comments: ";
-    cin.ignore();
-    getline(cin, newFeedback.venueComments);
+    readInputLine(newFeedback.venueComments);
 
     cout << "Organization Comments: ";
-    getline(cin, newFeedback.organizationComments);
+    readInputLine(newFeedback.organizationComments);
 
     cout << "Logistics Comments: ";
-    getline(cin, newFeedback.logisticsComments);
+    readInputLine(newFeedback.logisticsComments);
 
     cout << "General Comments: ";
-    getline(cin, newFeedback.generalComments);
+    readInputLine(newFeedback.generalComments);
 
     cout << "Suggestions for improvement: ";
-    getline(cin, newFeedback.suggestions);
+    readInputLine(newFeedback.suggestions);
 
     // Set submitter as current user
     newFeedback.submittedBy = data.currentUser;
@@ -199,12 +224,19 @@ void submitEventFeedback(SystemData& data) {
     newFeedback.submissionDate = getCurrentDate();
 
     // Add to system
-    data.feedbacks.push_back(newFeedback);
+    RecordHandle feedbackHandle = data.feedbacks.insert(newFeedback);
+    addFeedbackToStore(data.feedbackRatings, newFeedback);
+    addFeedbackToTrends(data.ratingTrends, newFeedback);
+    addFeedbackToSearch(data.feedbackSearch, newFeedback, feedbackHandle);
     saveFeedbackToFile(data.feedbacks);
 
 	//update status of booking to "Completed"
 	selectedBooking->bookingStatus = "Completed";
+    recordBookingInCube(data.revenue, *selectedBooking);
 	saveBookingsToFile(data.bookings); // In case booking status needs update
+    data.changes.publish(ChangeKind::FeedbackSubmitted, newFeedback.feedbackID, newFeedback.submittedBy);
+    data.changes.publish(ChangeKind::BookingCompleted, selectedBooking->bookingID,
+        selectedBooking->eventReg.organizer.userID, selectedBooking->finalCost);
     cout << "\nFeedback submitted successfully!" << endl;
     cout << "Feedback ID: " << newFeedback.feedbackID << endl;
 }
@@ -288,70 +320,47 @@ void viewFeedbackStatistics(const SystemData& data) {
         return;
     }
 
-    if (data.feedbacks.empty()) {
+    // Work from a pinned copy, so feedback keeps coming in meanwhile
+    SnapshotPtr snapshot = takeSnapshot(data, FEEDBACK_DATA);
+    UnlockedSection unlocked;
+    const FeedbackSnapshot& feedback = *snapshot->feedback;
+
+    if (feedback.feedbackCount == 0) {
         cout << "No feedback data available for statistics." << endl;
         return;
     }
 
-    // Filter user's feedback only
-    vector<EventFeedback> userFeedbacks;
-    string normalizedCurrentUser = normalizeUserID(data.currentUser);
-
-    for (const auto& feedback : data.feedbacks) {
-        if (normalizeUserID(feedback.submittedBy) == normalizedCurrentUser) {
-            userFeedbacks.push_back(feedback);
-        }
-    }
-
-    if (userFeedbacks.empty()) {
+    // User's ratings are already held column by column in the store
+    const FeedbackPartition* partition = findFeedbackPartition(feedback.ratings, data.currentUser);
+    if (partition == nullptr) {
         cout << "No feedback data available for your account." << endl;
         cout << "Please submit feedback for your events first." << endl;
         return;
     }
 
-    size_t totalFeedback = userFeedbacks.size();
-
-    // Calculate user's statistics using 2D array
-    const int NUM_CATEGORIES = 4;
-    const int RATING_SCALE = 5;
-
-    // 2D array for rating frequency analysis
+    // Single pass per column for frequencies, sums and recommendations
     // Rows: categories (venue, org, logistics, overall)
     // Columns: rating values (1-5)
-    int ratingFrequency[NUM_CATEGORIES][RATING_SCALE + 1];
-
-    // Initialize frequency matrix
-    for (int i = 0; i < NUM_CATEGORIES; i++) {
-        for (int j = 0; j <= RATING_SCALE; j++) {
-            ratingFrequency[i][j] = 0;
-        }
-    }
-
-    // Count frequencies from user's feedback
-    for (const auto& feedback : userFeedbacks) {
-        ratingFrequency[0][feedback.venueRating]++;
-        ratingFrequency[1][feedback.organizationRating]++;
-        ratingFrequency[2][feedback.logisticsRating]++;
-        ratingFrequency[3][feedback.overallRating]++;
-    }
+    RatingHistogram histogram = computeRatingHistogram(partition->columns);
+    size_t totalFeedback = histogram.total;
 
     // Category names
-    string categoryNames[NUM_CATEGORIES] = {
+    string categoryNames[NUM_RATING_CATEGORIES] = {
         "Venue", "Organization", "Logistics", "Overall"
     };
 
     cout << "User: " << data.currentUser << endl;
     cout << setfill('-') << setw(60) << "-" << setfill(' ') << endl;
 
-    // Display detailed rating breakdown using the 2D array
+    // Display detailed rating breakdown from the histogram
     cout << "DETAILED RATING BREAKDOWN" << endl;
     cout << setfill('-') << setw(50) << "-" << setfill(' ') << endl;
 
-    for (int category = 0; category < NUM_CATEGORIES; category++) {
+    for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
         cout << categoryNames[category] << " Ratings:" << endl;
 
-        for (int rating = 5; rating >= 1; rating--) {
-            int count = ratingFrequency[category][rating];
+        for (int rating = RATING_SCALE; rating >= 1; rating--) {
+            int count = histogram.frequency[category][rating];
             double percentage = (count * 100.0) / totalFeedback;
 
             cout << "  " << rating << " stars: " << count
@@ -360,80 +369,88 @@ void viewFeedbackStatistics(const SystemData& data) {
         cout << endl;
     }
 
-    // Calculate and display averages using the matrix
+    // Display averages from the column sums
     cout << "CATEGORY AVERAGES" << endl;
     cout << setfill('-') << setw(30) << "-" << setfill(' ') << endl;
 
-    for (int category = 0; category < NUM_CATEGORIES; category++) {
-        double total = 0;
-        int count = 0;
-
-        for (int rating = 1; rating <= RATING_SCALE; rating++) {
-            total += rating * ratingFrequency[category][rating];
-            count += ratingFrequency[category][rating];
-        }
-
-        double average = (count > 0) ? total / count : 0;
+    for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
         cout << categoryNames[category] << " Average: "
-            << fixed << setprecision(2) << average << "/5" << endl;
+            << fixed << setprecision(2) << histogram.average(category) << "/5" << endl;
     }
+    cout << "Would Recommend: " << histogram.recommendCount << " of " << totalFeedback << endl;
 
     // Display the comparison matrices
-    displayRatingComparisonMatrix(userFeedbacks);
-    displayVenuePerformanceMatrix(userFeedbacks);
+    const TrendSeries* myTrend = findOrganizerTrend(feedback.trends, data.currentUser);
+    if (myTrend != nullptr) {
+        displayRatingComparisonMatrix(*myTrend);
+    }
+    displayVenuePerformanceMatrix(*partition);
 
-    // User's venue performance (existing code)
+    // User's venue performance from the per-venue totals
     cout << "\nMY VENUE EXPERIENCES" << endl;
     cout << setfill('-') << setw(40) << "-" << setfill(' ') << endl;
 
-    map<string, vector<int>> venueRatings;
-    for (const auto& feedback : userFeedbacks) {
-        venueRatings[feedback.venueName].push_back(feedback.venueRating);
+    vector<pair<string, VenueScore>> rankedVenues = rankVenueScores(*partition);
+    for (const auto& venue : rankedVenues) {
+        double avg = static_cast<double>(venue.second.venueRatingSum) / venue.second.count;
+        cout << venue.first << ": " << fixed << setprecision(2) << avg << "/5 "
+            << "(" << venue.second.count << " feedback)" << endl;
     }
 
-    vector<pair<string, double>> venueAvgs;
-    for (const auto& venue : venueRatings) {
-        double avg = accumulate(venue.second.begin(), venue.second.end(), 0.0) / venue.second.size();
-        venueAvgs.push_back({ venue.first, avg });
-    }
+    // User's recent feedback trends, by event date rather than submission order
+    cout << "\nMY RECENT FEEDBACK TRENDS" << endl;
+    cout << setfill('-') << setw(40) << "-" << setfill(' ') << endl;
 
-    // Sort by average rating
-    sort(venueAvgs.begin(), venueAvgs.end(),
-        [](const pair<string, double>& a, const pair<string, double>& b) {
-            return a.second > b.second;
-        });
+    if (myTrend != nullptr && totalFeedback >= 3) {
+        TrendReport byEvents = eventTrend(*myTrend, 3);
+        cout << "My Recent Average Rating (last " << byEvents.recentCount
+            << " feedback): " << fixed << setprecision(2) << byEvents.recentMean << "/5"
+            << " (std dev " << byEvents.recentStdDev << ")" << endl;
+        if (byEvents.priorCount > 0) {
+            cout << "Previous " << byEvents.priorCount << " feedback: "
+                << byEvents.priorMean << "/5 -> " << trendLabel(byEvents.direction) << endl;
+        }
 
-    for (const auto& venue : venueAvgs) {
-        cout << venue.first << ": " << fixed << setprecision(2) << venue.second << "/5 "
-            << "(" << venueRatings[venue.first].size() << " feedback)" << endl;
+        TrendReport byDays = dayTrend(*myTrend, 3);
+        cout << "Last " << feedback.trends.windowDays << " days: ";
+        if (byDays.recentCount > 0) {
+            cout << byDays.recentMean << "/5 over " << byDays.recentCount << " event(s)";
+        }
+        else {
+            cout << "no events";
+        }
+        cout << " -> " << trendLabel(byDays.direction) << endl;
     }
 
-    // User's recent feedback trends
-    cout << "\nMY RECENT FEEDBACK TRENDS" << endl;
-    cout << setfill('-') << setw(40) << "-" << setfill(' ') << endl;
-
-    if (userFeedbacks.size() >= 3) {
-        auto recent = userFeedbacks.end() - min(size_t(5), userFeedbacks.size());
-        double recentAvg = 0;
-        for (auto it = recent; it != userFeedbacks.end(); ++it) {
-            recentAvg += it->overallRating;
+    // Venue score trends across everyone's feedback, for the venues this user has used
+    cout << "\nVENUE SCORE TRENDS" << endl;
+    cout << setfill('-') << setw(60) << "-" << setfill(' ') << endl;
+    cout << left << setw(20) << "Venue"
+        << setw(10) << "Recent"
+        << setw(10) << "Before"
+        << setw(20) << "Trend" << endl;
+
+    for (const auto& venue : rankedVenues) {
+        const TrendSeries* venueTrend = findVenueTrend(feedback.trends, venue.first);
+        if (venueTrend == nullptr) {
+            continue;
         }
-        recentAvg /= min(size_t(5), userFeedbacks.size());
-        cout << "My Recent Average Rating (last " << min(size_t(5), userFeedbacks.size())
-            << " feedback): " << fixed << setprecision(2) << recentAvg << "/5" << endl;
+        TrendReport report = eventTrend(*venueTrend, 0);
+        cout << left << setw(20) << venue.first.substr(0, 19)
+            << setw(10) << fixed << setprecision(2) << report.recentMean
+            << setw(10) << report.priorMean
+            << setw(20) << trendLabel(report.direction) << endl;
     }
 
-    // User's feedback themes
+    // User's feedback themes, read off the overall rating histogram
     cout << "\nMY FEEDBACK THEMES" << endl;
     cout << setfill('-') << setw(40) << "-" << setfill(' ') << endl;
 
-    int excellentCount = 0, goodCount = 0, averageCount = 0, poorCount = 0;
-    for (const auto& feedback : userFeedbacks) {
-        if (feedback.overallRating >= 5) excellentCount++;
-        else if (feedback.overallRating >= 4) goodCount++;
-        else if (feedback.overallRating >= 3) averageCount++;
-        else poorCount++;
-    }
+    const int* overall = histogram.frequency[3];
+    int excellentCount = overall[5];
+    int goodCount = overall[4];
+    int averageCount = overall[3];
+    int poorCount = static_cast<int>(totalFeedback) - excellentCount - goodCount - averageCount;
 
     cout << "My Excellent Ratings (5 stars): " << excellentCount << endl;
     cout << "My Good Ratings (4+ stars): " << goodCount << endl;
@@ -441,6 +458,61 @@ void viewFeedbackStatistics(const SystemData& data) {
     cout << "My Critical Ratings (<3 stars): " << poorCount << endl;
 }
 
+// Search the comments of all feedback, best matches first
+void searchFeedbackComments(const SystemData& data) {
+    clearScreen();
+    displayLogo();
+    cout << "=== SEARCH FEEDBACK COMMENTS ===" << endl;
+    cout << setfill('=') << setw(80) << "=" << setfill(' ') << endl;
+
+    if (data.feedbacks.empty()) {
+        cout << "No feedback records found." << endl;
+        return;
+    }
+
+    string query = getValidStringInputWithExit("Enter search words (e.g. sound system failed) ");
+    if (query.empty()) {
+        return;
+    }
+
+    const size_t MAX_RESULTS = 10;
+    vector<SearchHit> hits = searchFeedback(data.feedbackSearch, query, MAX_RESULTS);
+    if (hits.empty()) {
+        cout << "No feedback comments match \"" << query << "\"." << endl;
+        return;
+    }
+
+    cout << "Top " << hits.size() << " match(es) for \"" << query << "\":" << endl;
+    cout << setfill('-') << setw(80) << "-" << setfill(' ') << endl;
+
+    int rank = 1;
+    for (const auto& hit : hits) {
+        const EventFeedback* feedback = data.feedbacks.find(hit.feedback);
+        if (feedback == nullptr || feedback->feedbackID != hit.feedbackID) {
+            continue;
+        }
+        cout << rank++ << ". " << feedback->feedbackID
+            << " | Score: " << fixed << setprecision(2) << hit.score
+            << " | Matched in: " << fieldNames(hit.fields) << endl;
+        cout << "   Event: " << feedback->eventTitle << " (" << feedback->eventDate.toString() << ")" << endl;
+        cout << "   Venue: " << feedback->venueName << " | Overall: " << feedback->overallRating << "/5" << endl;
+
+        const pair<uint8_t, const string*> fields[] = {
+            { FIELD_VENUE, &feedback->venueComments },
+            { FIELD_ORGANIZATION, &feedback->organizationComments },
+            { FIELD_LOGISTICS, &feedback->logisticsComments },
+            { FIELD_GENERAL, &feedback->generalComments },
+            { FIELD_SUGGESTIONS, &feedback->suggestions }
+        };
+        for (const auto& field : fields) {
+            if (hit.fields & field.first) {
+                cout << "   " << fieldNames(field.first) << ": " << field.second->substr(0, 70) << endl;
+            }
+        }
+        cout << setfill('-') << setw(80) << "-" << setfill(' ') << endl;
+    }
+}
+
 // Delete user's feedback only
 void deleteFeedback(SystemData& data) {
     clearScreen();
@@ -460,7 +532,7 @@ void deleteFeedback(SystemData& data) {
     }
 
     // Filter and display user's feedback only
-    vector<int> userFeedbackIndices;
+    vector<RecordHandle> userFeedbackHandles;
     string normalizedCurrentUser = normalizeUserID(data.currentUser);
 
     cout << "User: " << data.currentUser << endl;
@@ -468,10 +540,10 @@ void deleteFeedback(SystemData& data) {
     cout << "Your Feedback Records:" << endl;
 
     int displayCount = 1;
-    for (size_t i = 0; i < data.feedbacks.size(); i++) {
-        if (normalizeUserID(data.feedbacks[i].submittedBy) == normalizedCurrentUser) {
-            userFeedbackIndices.push_back(static_cast<int>(i));
-            const auto& feedback = data.feedbacks[i];
+    for (auto it = data.feedbacks.begin(); it != data.feedbacks.end(); ++it) {
+        if (normalizeUserID(it->submittedBy) == normalizedCurrentUser) {
+            userFeedbackHandles.push_back(it.handle());
+            const auto& feedback = *it;
             cout << displayCount << ". ID: " << feedback.feedbackID
                 << " | Event: " << feedback.eventTitle
                 << " | Rating: " << feedback.overallRating << "/5"
@@ -480,25 +552,24 @@ void deleteFeedback(SystemData& data) {
         }
     }
 
-    if (userFeedbackIndices.empty()) {
+    if (userFeedbackHandles.empty()) {
         cout << "No feedback records found for your account." << endl;
         return;
     }
 
     int choice = getValidIntegerInput("Select feedback to delete [1-" +
-        to_string(userFeedbackIndices.size()) + "] (0 to cancel): ",
-        0, userFeedbackIndices.size());
+        to_string(userFeedbackHandles.size()) + "] (0 to cancel): ",
+        0, userFeedbackHandles.size());
 
     if (choice == 0) {
         cout << "Delete operation cancelled." << endl;
         return;
     }
 
-    // Get the actual index in the main feedbacks vector
-    int actualIndex = userFeedbackIndices[choice - 1];
+    RecordHandle selected = userFeedbackHandles[choice - 1];
 
-    // Confirm deletion
-    const auto& toDelete = data.feedbacks[actualIndex];
+    // Confirm deletion (copied, the record is erased below)
+    const EventFeedback toDelete = data.feedbacks[selected];
     cout << "\nConfirm deletion of your feedback:" << endl;
     cout << "Feedback ID: " << toDelete.feedbackID << endl;
     cout << "Event: " << toDelete.eventTitle << endl;
@@ -509,15 +580,30 @@ void deleteFeedback(SystemData& data) {
     char confirm = getValidCharInput("Are you sure you want to delete this feedback? (Y/N): ", validChars);
 
     if (confirm == 'Y') {
-        data.feedbacks.erase(data.feedbacks.begin() + actualIndex);
+        data.feedbacks.erase(selected);
+        removeFeedbackFromStore(data.feedbackRatings, toDelete);
+        removeFeedbackFromTrends(data.ratingTrends, toDelete);
+        removeFeedbackFromSearch(data.feedbackSearch, toDelete);
         saveFeedbackToFile(data.feedbacks);
-		//change status of booking back to "Confirmed"
-        for (auto& booking : data.bookings) {
+        data.changes.publish(ChangeKind::FeedbackDeleted, toDelete.feedbackID, toDelete.submittedBy);
+        // Change status of booking back to "Confirmed", unless the event has
+        // already taken place: then it stays Completed without the feedback
+        int today = getCurrentDate().toDayNumber();
+        for (auto it = data.bookings.begin(); it != data.bookings.end(); ++it) {
+            EventBooking& booking = *it;
             if (booking.bookingID == toDelete.bookingID) {
-                booking.bookingStatus = "Confirmed";
+                int eventDay = booking.eventDate.toDayNumber();
+                if (booking.bookingStatus == "Completed" && eventDay >= today) {
+                    booking.bookingStatus = "Confirmed";
+                    trackConfirmedBooking(data.lifecycle, booking.bookingID, eventDay, it.handle());
+                    recordBookingInCube(data.revenue, booking);
+                    saveBookingsToFile(data.bookings);
+                    data.changes.publish(ChangeKind::BookingUpdated, booking.bookingID,
+                        booking.eventReg.organizer.userID, booking.finalCost);
+                }
                 break;
             }
-		}
+        }
         cout << "Your feedback deleted successfully." << endl;
     }
     else {
@@ -525,34 +611,13 @@ void deleteFeedback(SystemData& data) {
     }
 }
 
-void displayRatingComparisonMatrix(const vector<EventFeedback>& userFeedbacks) {
-    const int NUM_CATEGORIES = 4;
-    const int MAX_EVENTS = 10; // Display last 10 events
-
-    // 2D array for rating comparison
-    // Rows: recent events, Columns: rating categories
-    int recentRatings[MAX_EVENTS][NUM_CATEGORIES];
-    string eventTitles[MAX_EVENTS];
-
-    // Initialize arrays
-    for (int i = 0; i < MAX_EVENTS; i++) {
-        eventTitles[i] = "";
-        for (int j = 0; j < NUM_CATEGORIES; j++) {
-            recentRatings[i][j] = 0;
-        }
-    }
-
-    // Fill with recent feedback data
-    int eventCount = min(MAX_EVENTS, (int)userFeedbacks.size());
-    int startIndex = max(0, (int)userFeedbacks.size() - MAX_EVENTS);
-
-    for (int i = 0; i < eventCount; i++) {
-        const auto& feedback = userFeedbacks[startIndex + i];
-        eventTitles[i] = feedback.eventTitle.substr(0, 20); // Truncate for display
-        recentRatings[i][0] = feedback.venueRating;
-        recentRatings[i][1] = feedback.organizationRating;
-        recentRatings[i][2] = feedback.logisticsRating;
-        recentRatings[i][3] = feedback.overallRating;
+void displayRatingComparisonMatrix(const TrendSeries& series) {
+    // The latest and prior count windows together hold the most recent
+    // events by event date, and their running sums give the column averages
+    WindowStats shown = series.recent;
+    shown.count += series.prior.count;
+    for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
+        shown.sums[category] += series.prior.sums[category];
     }
 
     // Display comparison matrix
@@ -565,77 +630,28 @@ void displayRatingComparisonMatrix(const vector<EventFeedback>& userFeedbacks) {
         << setw(8) << "Overall" << endl;
     cout << setfill('-') << setw(70) << "-" << setfill(' ') << endl;
 
-    for (int i = 0; i < eventCount; i++) {
-        cout << left << setw(22) << eventTitles[i];
-        for (int j = 0; j < NUM_CATEGORIES; j++) {
-            cout << setw(8) << recentRatings[i][j];
+    for (auto it = series.priorStart; it != series.samples.end(); ++it) {
+        cout << left << setw(22) << it->eventTitle.substr(0, 20); // Truncate for display
+        for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
+            cout << setw(8) << it->ratings[category];
         }
         cout << endl;
     }
 
-    // Calculate column averages
+    // Column averages
     cout << setfill('-') << setw(70) << "-" << setfill(' ') << endl;
     cout << left << setw(22) << "Average:";
 
-    for (int category = 0; category < NUM_CATEGORIES; category++) {
-        double total = 0;
-        for (int event = 0; event < eventCount; event++) {
-            total += recentRatings[event][category];
-        }
-        double average = (eventCount > 0) ? total / eventCount : 0;
-        cout << setw(8) << fixed << setprecision(1) << average;
+    for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
+        cout << setw(8) << fixed << setprecision(1) << shown.mean(category);
     }
     cout << endl;
 }
 
-void displayVenuePerformanceMatrix(const vector<EventFeedback>& userFeedbacks) {
-    const int MAX_VENUES = 5;
-    const int NUM_METRICS = 3; // venue rating, overall rating, recommendation count
-
-    // 2D array for venue performance data
-    double venueMatrix[MAX_VENUES][NUM_METRICS];
-    string venueNames[MAX_VENUES];
-    int venueCounts[MAX_VENUES];
-
-    // Initialize arrays
-    for (int i = 0; i < MAX_VENUES; i++) {
-        venueNames[i] = "";
-        venueCounts[i] = 0;
-        for (int j = 0; j < NUM_METRICS; j++) {
-            venueMatrix[i][j] = 0.0;
-        }
-    }
-
-    // Collect unique venues and their data
-    vector<string> uniqueVenues;
-    for (const auto& feedback : userFeedbacks) {
-        if (find(uniqueVenues.begin(), uniqueVenues.end(), feedback.venueName) == uniqueVenues.end()) {
-            uniqueVenues.push_back(feedback.venueName);
-        }
-    }
-
-    int venueCount = min(MAX_VENUES, (int)uniqueVenues.size());
-
-    // Calculate metrics for each venue
-    for (int i = 0; i < venueCount; i++) {
-        venueNames[i] = uniqueVenues[i];
-        double totalVenueRating = 0, totalOverallRating = 0;
-        int recommendCount = 0, feedbackCount = 0;
-
-        for (const auto& feedback : userFeedbacks) {
-            if (feedback.venueName == uniqueVenues[i]) {
-                totalVenueRating += feedback.venueRating;
-                totalOverallRating += feedback.overallRating;
-                if (feedback.wouldRecommend) recommendCount++;
-                feedbackCount++;
-            }
-        }
-
-        venueCounts[i] = feedbackCount;
-        venueMatrix[i][0] = (feedbackCount > 0) ? totalVenueRating / feedbackCount : 0;
-        venueMatrix[i][1] = (feedbackCount > 0) ? totalOverallRating / feedbackCount : 0;
-        venueMatrix[i][2] = (feedbackCount > 0) ? (recommendCount * 100.0 / feedbackCount) : 0;
-    }
+void displayVenuePerformanceMatrix(const FeedbackPartition& partition) {
+    // Per-venue totals are kept up to date by the store, so every venue is
+    // listed and nothing here walks the feedback records
+    vector<pair<string, VenueScore>> venues = rankVenueScores(partition);
 
     // Display venue performance matrix
     cout << "\nVENUE PERFORMANCE MATRIX" << endl;
@@ -647,11 +663,16 @@ void displayVenuePerformanceMatrix(const vector<EventFeedback>& userFeedbacks) {
         << setw(9) << "Count" << endl;
     cout << setfill('-') << setw(65) << "-" << setfill(' ') << endl;
 
-    for (int i = 0; i < venueCount; i++) {
-        cout << left << setw(20) << venueNames[i].substr(0, 19)
-            << setw(12) << fixed << setprecision(1) << venueMatrix[i][0]
-            << setw(12) << venueMatrix[i][1]
-            << setw(12) << venueMatrix[i][2] << "%"
-            << setw(9) << venueCounts[i] << endl;
+    for (const auto& venue : venues) {
+        const VenueScore& score = venue.second;
+        double venueAvg = (score.count > 0) ? static_cast<double>(score.venueRatingSum) / score.count : 0;
+        double overallAvg = (score.count > 0) ? static_cast<double>(score.overallRatingSum) / score.count : 0;
+        double recommendRate = (score.count > 0) ? (score.recommendCount * 100.0 / score.count) : 0;
+
+        cout << left << setw(20) << venue.first.substr(0, 19)
+            << setw(12) << fixed << setprecision(1) << venueAvg
+            << setw(12) << overallAvg
+            << setw(12) << recommendRate << "%"
+            << setw(9) << score.count << endl;
     }
 }
\ No newline at end of file
@@ -12,6 +12,9 @@
 #include "event_booking.h"
 #include "utility_fun.h"
 #include "input_validation.h"
+#include "feedback_store.h"
+#include "rating_trends.h"
+#include "feedback_search.h"
 using namespace std;
 // Feedback structure
 struct EventFeedback {
@@ -41,6 +44,8 @@ struct EventFeedback {
     bool wouldRecommend;
 };
 
+using FeedbackTable = RecordTable<EventFeedback>;
+
 //feedback menu
 void feedbackMenu(SystemData& data);
 
@@ -53,13 +58,16 @@ void viewAllFeedback(const SystemData& data);
 // View feedback statistics
 void viewFeedbackStatistics(const SystemData& data);
 
+// Ranked search over the comment fields of all feedback
+void searchFeedbackComments(const SystemData& data);
+
 // Delete feedback (admin function)
 void deleteFeedback(SystemData& data);
 
-// Display rating comparison matrix
-void displayRatingComparisonMatrix(const vector<EventFeedback>& userFeedbacks);
+// Display rating comparison matrix for the user's most recent events
+void displayRatingComparisonMatrix(const TrendSeries& series);
 
-// Display venue performance matrix  
-void displayVenuePerformanceMatrix(const vector<EventFeedback>& userFeedbacks);
+// Display venue performance matrix for every venue the user has rated
+void displayVenuePerformanceMatrix(const FeedbackPartition& partition);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "feedback_search.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <unordered_set>
+#include "feedback.h"
+#include "system_data.h"
+
+using namespace std;
+
+// Standard BM25 tuning
+static const double BM25_K1 = 1.2;
+static const double BM25_B = 0.75;
+
+static const unordered_set<string> STOP_WORDS = {
+    "a", "an", "and", "are", "as", "at", "be", "but", "by", "for", "from", "had", "has",
+    "have", "i", "in", "is", "it", "its", "of", "on", "or", "so", "that", "the", "this",
+    "to", "very", "was", "we", "were", "with"
+};
+
+static string stemWord(const string& word) {
+    size_t length = word.size();
+    if (length >= 7 && word.compare(length - 3, 3, "ing") == 0) {
+        return word.substr(0, length - 3);
+    }
+    if (length >= 6 && word.compare(length - 2, 2, "ed") == 0) {
+        return word.substr(0, length - 2);
+    }
+    if (length >= 4 && word[length - 1] == 's' && word[length - 2] != 's') {
+        return word.substr(0, length - 1);
+    }
+    return word;
+}
+
+vector<string> tokenizeText(const string& text) {
+    vector<string> tokens;
+    string word;
+    for (size_t i = 0; i <= text.size(); i++) {
+        unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+        if (isalnum(c)) {
+            word += static_cast<char>(tolower(c));
+        }
+        else if (!word.empty()) {
+            if (STOP_WORDS.count(word) == 0) {
+                tokens.push_back(stemWord(word));
+            }
+            word.clear();
+        }
+    }
+    return tokens;
+}
+
+// Term -> (frequency, fields) for one feedback's comments
+static unordered_map<string, Posting> collectTerms(const EventFeedback& feedback, int& length) {
+    const pair<const string*, uint8_t> fields[] = {
+        { &feedback.venueComments, FIELD_VENUE },
+        { &feedback.organizationComments, FIELD_ORGANIZATION },
+        { &feedback.logisticsComments, FIELD_LOGISTICS },
+        { &feedback.generalComments, FIELD_GENERAL },
+        { &feedback.suggestions, FIELD_SUGGESTIONS }
+    };
+
+    unordered_map<string, Posting> terms;
+    length = 0;
+    for (const auto& field : fields) {
+        for (const auto& token : tokenizeText(*field.first)) {
+            Posting& posting = terms.try_emplace(token, Posting{ 0, 0, 0 }).first->second;
+            posting.termFrequency++;
+            posting.fields |= field.second;
+            length++;
+        }
+    }
+    return terms;
+}
+
+// Drop postings of deleted documents and renumber the rest
+static void compactIndex(FeedbackSearchIndex& index) {
+    vector<int> newID(index.documents.size(), -1);
+    vector<SearchDocument> kept;
+    kept.reserve(index.liveCount);
+    for (size_t i = 0; i < index.documents.size(); i++) {
+        if (index.documents[i].alive) {
+            newID[i] = static_cast<int>(kept.size());
+            index.docOf[index.documents[i].feedbackID] = newID[i];
+            kept.push_back(index.documents[i]);
+        }
+    }
+    index.documents = move(kept);
+
+    for (auto it = index.postings.begin(); it != index.postings.end();) {
+        vector<Posting>& list = it->second;
+        size_t out = 0;
+        for (const auto& posting : list) {
+            if (newID[posting.docID] >= 0) {
+                list[out] = posting;
+                list[out].docID = newID[posting.docID];
+                out++;
+            }
+        }
+        list.resize(out);
+        it = list.empty() ? index.postings.erase(it) : next(it);
+    }
+}
+
+void addFeedbackToSearch(FeedbackSearchIndex& index, const EventFeedback& feedback, RecordHandle handle) {
+    if (index.docOf.count(feedback.feedbackID) > 0) {
+        return;
+    }
+
+    SearchDocument document;
+    document.feedbackID = feedback.feedbackID;
+    document.feedback = handle;
+    unordered_map<string, Posting> terms = collectTerms(feedback, document.length);
+
+    int docID = static_cast<int>(index.documents.size());
+    index.documents.push_back(document);
+    index.docOf[feedback.feedbackID] = docID;
+    index.totalLength += document.length;
+    index.liveCount++;
+
+    for (auto& term : terms) {
+        term.second.docID = docID;
+        index.postings[term.first].push_back(term.second); // docIDs only grow, lists stay sorted
+        index.documentFrequency[term.first]++;
+    }
+}
+
+void removeFeedbackFromSearch(FeedbackSearchIndex& index, const EventFeedback& feedback) {
+    auto found = index.docOf.find(feedback.feedbackID);
+    if (found == index.docOf.end()) {
+        return;
+    }
+
+    SearchDocument& document = index.documents[found->second];
+    document.alive = false;
+    index.totalLength -= document.length;
+    index.liveCount--;
+    index.docOf.erase(found);
+
+    int length = 0;
+    for (const auto& term : collectTerms(feedback, length)) {
+        auto frequency = index.documentFrequency.find(term.first);
+        if (frequency != index.documentFrequency.end() && --frequency->second <= 0) {
+            index.documentFrequency.erase(frequency);
+        }
+    }
+
+    // Rebuild postings once deleted documents outnumber live ones
+    int deadCount = static_cast<int>(index.documents.size()) - index.liveCount;
+    if (deadCount >= 64 && deadCount > index.liveCount) {
+        compactIndex(index);
+    }
+}
+
+void rebuildFeedbackSearch(SystemData& data) {
+    data.feedbackSearch = FeedbackSearchIndex();
+    for (auto it = data.feedbacks.begin(); it != data.feedbacks.end(); ++it) {
+        addFeedbackToSearch(data.feedbackSearch, *it, it.handle());
+    }
+}
+
+vector<SearchHit> searchFeedback(const FeedbackSearchIndex& index, const string& query, size_t maxResults) {
+    vector<SearchHit> hits;
+    if (index.liveCount == 0) {
+        return hits;
+    }
+
+    vector<string> terms = tokenizeText(query);
+    sort(terms.begin(), terms.end());
+    terms.erase(unique(terms.begin(), terms.end()), terms.end());
+
+    double averageLength = static_cast<double>(index.totalLength) / index.liveCount;
+    if (averageLength <= 0.0) {
+        averageLength = 1.0;
+    }
+
+    // Score accumulators indexed by docID; touched remembers which ones are in use
+    vector<double> scores(index.documents.size(), 0.0);
+    vector<uint8_t> matched(index.documents.size(), 0);
+    vector<int> touched;
+
+    for (const auto& term : terms) {
+        auto list = index.postings.find(term);
+        auto frequency = index.documentFrequency.find(term);
+        if (list == index.postings.end() || frequency == index.documentFrequency.end()) {
+            continue;
+        }
+
+        double df = frequency->second;
+        double idf = log(1.0 + (index.liveCount - df + 0.5) / (df + 0.5));
+
+        for (const auto& posting : list->second) {
+            const SearchDocument& document = index.documents[posting.docID];
+            if (!document.alive) {
+                continue;
+            }
+            double tf = posting.termFrequency;
+            double norm = BM25_K1 * (1.0 - BM25_B + BM25_B * document.length / averageLength);
+            if (matched[posting.docID] == 0) {
+                touched.push_back(posting.docID);
+            }
+            scores[posting.docID] += idf * (tf * (BM25_K1 + 1.0)) / (tf + norm);
+            matched[posting.docID] |= posting.fields;
+        }
+    }
+
+    hits.reserve(touched.size());
+    for (int docID : touched) {
+        hits.push_back({ index.documents[docID].feedbackID, index.documents[docID].feedback, scores[docID], matched[docID] });
+    }
+
+    size_t keep = min(maxResults, hits.size());
+    partial_sort(hits.begin(), hits.begin() + keep, hits.end(),
+        [](const SearchHit& a, const SearchHit& b) {
+            if (a.score != b.score) {
+                return a.score > b.score;
+            }
+            return a.feedbackID < b.feedbackID;
+        });
+    hits.resize(keep);
+    return hits;
+}
+
+string fieldNames(uint8_t fields) {
+    const pair<uint8_t, const char*> names[] = {
+        { FIELD_VENUE, "Venue" },
+        { FIELD_ORGANIZATION, "Organization" },
+        { FIELD_LOGISTICS, "Logistics" },
+        { FIELD_GENERAL, "General" },
+        { FIELD_SUGGESTIONS, "Suggestions" }
+    };
+
+    string result;
+    for (const auto& name : names) {
+        if (fields & name.first) {
+            result += (result.empty() ? "" : ", ");
+            result += name.second;
+        }
+    }
+    return result;
+}
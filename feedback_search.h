@@ -0,0 +1,70 @@
+#pragma once
+#ifndef FEEDBACK_SEARCH_H
+#define FEEDBACK_SEARCH_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "record_table.h"
+using namespace std;
+
+// Comment fields covered by the index, in bit order for Posting::fields
+enum FeedbackField : uint8_t {
+    FIELD_VENUE = 1,
+    FIELD_ORGANIZATION = 2,
+    FIELD_LOGISTICS = 4,
+    FIELD_GENERAL = 8,
+    FIELD_SUGGESTIONS = 16
+};
+
+struct Posting {
+    int docID;
+    int termFrequency;   // occurrences across all comment fields
+    uint8_t fields;      // FeedbackField bits the term appears in
+};
+
+struct SearchDocument {
+    string feedbackID;
+    RecordHandle feedback;   // into data.feedbacks
+    int length = 0;      // token count, for BM25 length normalization
+    bool alive = true;
+};
+
+// Inverted index over the free-text comments of every feedback. Deleted
+// documents are only flagged; their postings are skipped while scoring
+// and dropped when enough of them pile up.
+struct FeedbackSearchIndex {
+    vector<SearchDocument> documents;                  // docID -> document
+    unordered_map<string, int> docOf;                  // feedbackID -> docID
+    unordered_map<string, vector<Posting>> postings;   // term -> postings, in docID order
+    unordered_map<string, int> documentFrequency;      // term -> live documents containing it
+    long long totalLength = 0;                         // token count over live documents
+    int liveCount = 0;
+};
+
+struct SearchHit {
+    string feedbackID;
+    RecordHandle feedback;   // resolve with data.feedbacks.find()
+    double score;
+    uint8_t fields;      // fields that matched any query term
+};
+
+// Forward declarations
+struct EventFeedback;
+class SystemData;
+
+// Lowercase words with light suffix stripping, so "failed" also finds "fail"
+vector<string> tokenizeText(const string& text);
+
+// Incremental maintenance - call alongside changes to data.feedbacks
+void addFeedbackToSearch(FeedbackSearchIndex& index, const EventFeedback& feedback, RecordHandle handle);
+void removeFeedbackFromSearch(FeedbackSearchIndex& index, const EventFeedback& feedback);
+void rebuildFeedbackSearch(SystemData& data);
+
+// BM25 ranked search, best first
+vector<SearchHit> searchFeedback(const FeedbackSearchIndex& index, const string& query, size_t maxResults);
+
+string fieldNames(uint8_t fields);
+
+#endif
@@ -0,0 +1,167 @@
+#include "feedback_store.h"
+#include <algorithm>
+#include <bit>
+#include "feedback.h"
+#include "system_data.h"
+#include "utility_fun.h"
+
+using namespace std;
+
+static bool recommendBit(const RatingColumns& columns, size_t row) {
+    return (columns.recommendBits[row / 64] >> (row % 64)) & 1ULL;
+}
+
+static void setRecommendBit(RatingColumns& columns, size_t row, bool value) {
+    uint64_t mask = 1ULL << (row % 64);
+    if (value) {
+        columns.recommendBits[row / 64] |= mask;
+    }
+    else {
+        columns.recommendBits[row / 64] &= ~mask;
+    }
+}
+
+static uint8_t ratingOf(const EventFeedback& feedback, int category) {
+    int rating = 0;
+    switch (category) {
+    case 0: rating = feedback.venueRating; break;
+    case 1: rating = feedback.organizationRating; break;
+    case 2: rating = feedback.logisticsRating; break;
+    case 3: rating = feedback.overallRating; break;
+    }
+    // Out-of-range values from hand-edited files land in bucket 0 and are not counted
+    return (rating >= 1 && rating <= RATING_SCALE) ? static_cast<uint8_t>(rating) : 0;
+}
+
+void addFeedbackToStore(FeedbackRatingStore& store, const EventFeedback& feedback) {
+    FeedbackPartition& partition = store.byUser[normalizeUserID(feedback.submittedBy)];
+    RatingColumns& columns = partition.columns;
+
+    size_t row = columns.rows();
+    for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
+        columns.ratings[category].push_back(ratingOf(feedback, category));
+    }
+    if (row / 64 >= columns.recommendBits.size()) {
+        columns.recommendBits.push_back(0);
+    }
+    setRecommendBit(columns, row, feedback.wouldRecommend);
+    columns.feedbackIDs.push_back(feedback.feedbackID);
+    store.rowOf[feedback.feedbackID] = row;
+
+    VenueScore& score = partition.venues[feedback.venueName];
+    score.count++;
+    score.venueRatingSum += ratingOf(feedback, 0);
+    score.overallRatingSum += ratingOf(feedback, 3);
+    if (feedback.wouldRecommend) {
+        score.recommendCount++;
+    }
+}
+
+void removeFeedbackFromStore(FeedbackRatingStore& store, const EventFeedback& feedback) {
+    auto rowIt = store.rowOf.find(feedback.feedbackID);
+    auto partitionIt = store.byUser.find(normalizeUserID(feedback.submittedBy));
+    if (rowIt == store.rowOf.end() || partitionIt == store.byUser.end()) {
+        return;
+    }
+
+    FeedbackPartition& partition = partitionIt->second;
+    RatingColumns& columns = partition.columns;
+    size_t row = rowIt->second;
+    size_t last = columns.rows() - 1;
+
+    // Fill the hole with the last row so the columns stay dense
+    if (row != last) {
+        for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
+            columns.ratings[category][row] = columns.ratings[category][last];
+        }
+        setRecommendBit(columns, row, recommendBit(columns, last));
+        columns.feedbackIDs[row] = columns.feedbackIDs[last];
+        store.rowOf[columns.feedbackIDs[row]] = row;
+    }
+    for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
+        columns.ratings[category].pop_back();
+    }
+    setRecommendBit(columns, last, false);
+    columns.feedbackIDs.pop_back();
+    columns.recommendBits.resize((columns.rows() + 63) / 64);
+    store.rowOf.erase(feedback.feedbackID);
+
+    auto venueIt = partition.venues.find(feedback.venueName);
+    if (venueIt != partition.venues.end()) {
+        VenueScore& score = venueIt->second;
+        score.count--;
+        score.venueRatingSum -= ratingOf(feedback, 0);
+        score.overallRatingSum -= ratingOf(feedback, 3);
+        if (feedback.wouldRecommend) {
+            score.recommendCount--;
+        }
+        if (score.count <= 0) {
+            partition.venues.erase(venueIt);
+        }
+    }
+
+    if (columns.rows() == 0) {
+        store.byUser.erase(partitionIt);
+    }
+}
+
+void rebuildFeedbackStore(SystemData& data) {
+    data.feedbackRatings = FeedbackRatingStore();
+    for (const auto& feedback : data.feedbacks) {
+        addFeedbackToStore(data.feedbackRatings, feedback);
+    }
+}
+
+const FeedbackPartition* findFeedbackPartition(const FeedbackRatingStore& store, const string& userID) {
+    auto it = store.byUser.find(normalizeUserID(userID));
+    return it == store.byUser.end() ? nullptr : &it->second;
+}
+
+// Count and sum one column. Each inner loop is a branch-free compare and add
+// over bytes, which the optimizer turns into packed SIMD instructions.
+static void scanColumn(const vector<uint8_t>& column, int frequency[RATING_SCALE + 1], long long& sum) {
+    const uint8_t* values = column.data();
+    size_t size = column.size();
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < size; i++) {
+        total += values[i];
+    }
+    sum = static_cast<long long>(total);
+
+    for (int rating = 0; rating <= RATING_SCALE; rating++) {
+        const uint8_t target = static_cast<uint8_t>(rating);
+        size_t count = 0;
+        for (size_t i = 0; i < size; i++) {
+            count += (values[i] == target);
+        }
+        frequency[rating] = static_cast<int>(count);
+    }
+}
+
+RatingHistogram computeRatingHistogram(const RatingColumns& columns) {
+    RatingHistogram histogram;
+    histogram.total = columns.rows();
+    for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
+        scanColumn(columns.ratings[category], histogram.frequency[category], histogram.sums[category]);
+    }
+    for (uint64_t word : columns.recommendBits) {
+        histogram.recommendCount += popcount(word);
+    }
+    return histogram;
+}
+
+vector<pair<string, VenueScore>> rankVenueScores(const FeedbackPartition& partition) {
+    vector<pair<string, VenueScore>> ranked(partition.venues.begin(), partition.venues.end());
+    sort(ranked.begin(), ranked.end(),
+        [](const pair<string, VenueScore>& a, const pair<string, VenueScore>& b) {
+            // Compare a.sum/a.count against b.sum/b.count without dividing
+            long long left = a.second.venueRatingSum * b.second.count;
+            long long right = b.second.venueRatingSum * a.second.count;
+            if (left != right) {
+                return left > right;
+            }
+            return a.first < b.first;
+        });
+    return ranked;
+}
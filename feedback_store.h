@@ -0,0 +1,70 @@
+#pragma once
+#ifndef FEEDBACK_STORE_H
+#define FEEDBACK_STORE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+using namespace std;
+
+const int NUM_RATING_CATEGORIES = 4;   // venue, organization, logistics, overall
+const int RATING_SCALE = 5;
+
+// Ratings of one submitter held column by column. Each rating fits in a
+// byte, so the statistics loops run over tightly packed arrays that the
+// compiler can vectorize instead of striding over whole EventFeedback rows.
+struct RatingColumns {
+    vector<uint8_t> ratings[NUM_RATING_CATEGORIES];
+    vector<uint64_t> recommendBits;     // bit i set = row i would recommend
+    vector<string> feedbackIDs;         // row -> feedbackID
+
+    size_t rows() const { return feedbackIDs.size(); }
+};
+
+// Running totals for one venue, updated as feedback comes and goes
+struct VenueScore {
+    int count = 0;
+    long long venueRatingSum = 0;
+    long long overallRatingSum = 0;
+    int recommendCount = 0;
+};
+
+struct FeedbackPartition {
+    RatingColumns columns;
+    unordered_map<string, VenueScore> venues; // venueName -> totals
+};
+
+struct FeedbackRatingStore {
+    unordered_map<string, FeedbackPartition> byUser; // normalized submittedBy -> partition
+    unordered_map<string, size_t> rowOf;             // feedbackID -> row in its partition
+};
+
+// Result of one pass over a partition
+struct RatingHistogram {
+    int frequency[NUM_RATING_CATEGORIES][RATING_SCALE + 1] = {};
+    long long sums[NUM_RATING_CATEGORIES] = {};
+    size_t total = 0;
+    int recommendCount = 0;
+
+    double average(int category) const { return total > 0 ? static_cast<double>(sums[category]) / total : 0.0; }
+};
+
+// Forward declarations
+struct EventFeedback;
+class SystemData;
+
+// Incremental maintenance - call alongside changes to data.feedbacks
+void addFeedbackToStore(FeedbackRatingStore& store, const EventFeedback& feedback);
+void removeFeedbackFromStore(FeedbackRatingStore& store, const EventFeedback& feedback);
+void rebuildFeedbackStore(SystemData& data);
+
+// Returns nullptr when the user has no feedback
+const FeedbackPartition* findFeedbackPartition(const FeedbackRatingStore& store, const string& userID);
+
+RatingHistogram computeRatingHistogram(const RatingColumns& columns);
+
+// Venues of a partition ordered by venue average, best first
+vector<pair<string, VenueScore>> rankVenueScores(const FeedbackPartition& partition);
+
+#endif
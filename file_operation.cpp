@@ -8,6 +8,10 @@
 #include <sstream>
 #include <cstdlib>
 #include <regex>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "date.h"
 #include "venue.h"
 #include "event_registration.h"
@@ -18,6 +22,7 @@
 #include "product.h"
 #include "utility_fun.h"
 #include "input_validation.h"
+#include "worker_pool.h"
 
 string formatToTwoDecimals(double value) {
     ostringstream stream;
@@ -25,8 +30,202 @@ string formatToTwoDecimals(double value) {
     return stream.str();
 }
 
+// While saves are deferred each save only remembers the latest collection
+// it was given; flushDeferredSaves then writes every touched file once.
+// Saves may come from several threads; flushes run one at a time, and the
+// thread doing one writes straight through.
+static atomic<bool> savesDeferred{ false };
+static thread_local bool flushing = false;
+static mutex pendingLock;
+static mutex flushLock;
+static atomic<uint64_t> savesRequested{ 0 };     // deferred saves so far
+
+// The persistence thread, when running, and how far the files have got
+static struct Persister {
+    thread worker;
+    mutex lock;
+    condition_variable signal;  // a save was deferred or written, or stop
+    uint64_t written = 0;       // savesRequested as of the last flush
+    bool running = false;
+    bool stopping = false;
+} persister;
+
+// Set on the persistence thread: it writes while the operator is at a
+// prompt, so it reports only failures
+static thread_local bool writingInBackground = false;
+static struct PendingSaves {
+    const vector<Organizer>* users = nullptr;
+    const vector<Venue>* venues = nullptr;
+    const RegistrationTable* registrations = nullptr;
+    const BookingTable* bookings = nullptr;
+    const FeedbackTable* feedbacks = nullptr;
+    const vector<Payment>* payments = nullptr;
+    const WaitlistBook* waitlist = nullptr;
+    const HoldBook* holds = nullptr;
+} pendingSaves;
+
+template <typename Collection>
+static bool deferSave(const Collection*& pending, const Collection& collection) {
+    if (!savesDeferred || flushing) {
+        return false;
+    }
+    {
+        lock_guard<mutex> guard(pendingLock);
+        pending = &collection;
+        savesRequested++;
+    }
+    lock_guard<mutex> guard(persister.lock);
+    if (persister.running) {
+        persister.signal.notify_all();
+    }
+    return true;
+}
+
+// Everything requested up to covered is on disk
+static void markWritten(uint64_t covered) {
+    {
+        lock_guard<mutex> guard(persister.lock);
+        persister.written = max(persister.written, covered);
+    }
+    persister.signal.notify_all();
+}
+
+void setSavesDeferred(bool deferred) {
+    if (!deferred) {
+        flushDeferredSaves();
+    }
+    savesDeferred = deferred;
+}
+
+// The files are independent, so each is written by its own task on the
+// background pool. writeThrough carries the caller's flushing over to the
+// task's thread; the caller must keep the collection readable until the
+// task is done.
+template <typename Collection>
+static void saveInBackground(vector<TaskFuture<void>>& writes, const char* name,
+    void (*save)(const Collection&), const Collection* collection, bool writeThrough) {
+    if (collection == nullptr) {
+        return;
+    }
+    writes.push_back(backgroundPool().submit(TaskPriority::Normal, name, [=] {
+        bool previous = flushing;   // may run inline on the caller's thread
+        flushing = writeThrough;
+        save(*collection);
+        flushing = previous;
+        }));
+}
+
+int flushDeferredSaves() {
+    lock_guard<mutex> flushGuard(flushLock);
+    PendingSaves pending;
+    uint64_t covered;
+    {
+        lock_guard<mutex> guard(pendingLock);
+        pending = pendingSaves;
+        pendingSaves = PendingSaves();
+        covered = savesRequested;
+    }
+    flushing = true;
+
+    vector<TaskFuture<void>> writes;
+    saveInBackground(writes, "save venues", saveVenuesToFile, pending.venues, true);
+    saveInBackground(writes, "save registrations", saveRegistrationsToFile, pending.registrations, true);
+    saveInBackground(writes, "save bookings", saveBookingsToFile, pending.bookings, true);
+    saveInBackground(writes, "save feedback", saveFeedbackToFile, pending.feedbacks, true);
+    saveInBackground(writes, "save payments", savePaymentsToFile, pending.payments, true);
+    saveInBackground(writes, "save waitlist", saveWaitlistToFile, pending.waitlist, true);
+    saveInBackground(writes, "save holds", saveHoldsToFile, pending.holds, true);
+    // Written here, as it is the one that reports success
+    if (pending.users) {
+        saveUsersToFile(*pending.users);
+    }
+    for (auto& write : writes) {
+        write.get();
+    }
+
+    flushing = false;
+    markWritten(covered);
+    return static_cast<int>(writes.size()) + (pending.users ? 1 : 0);
+}
+
+void discardDeferredSaves() {
+    uint64_t covered;
+    {
+        lock_guard<mutex> guard(pendingLock);
+        pendingSaves = PendingSaves();
+        covered = savesRequested;
+    }
+    markWritten(covered);
+}
+
+// Sleeps until saves are waiting, then writes them all once it can read
+// the data. Saves made meanwhile pile up on the pending set, so a burst of
+// them costs one write per file.
+static void persistSaves(SystemData& data) {
+    writingInBackground = true;
+    unique_lock<mutex> guard(persister.lock);
+    while (true) {
+        persister.signal.wait(guard, [] { return persister.stopping || savesRequested > persister.written; });
+        if (savesRequested == persister.written) {
+            return;     // stopping, and everything is written
+        }
+        guard.unlock();
+        {
+            DataLockSet reading(data.locks, LockPlan().reads(ALL_DATA).readsAllPartitions());
+            flushDeferredSaves();
+        }
+        guard.lock();
+    }
+}
+
+void startBackgroundSaves(SystemData& data) {
+    lock_guard<mutex> guard(persister.lock);
+    if (persister.running) {
+        return;
+    }
+    savesDeferred = true;
+    persister.running = true;
+    persister.stopping = false;
+    persister.worker = thread(persistSaves, ref(data));
+}
+
+void stopBackgroundSaves() {
+    {
+        lock_guard<mutex> guard(persister.lock);
+        if (!persister.running) {
+            return;
+        }
+        persister.stopping = true;
+    }
+    persister.signal.notify_all();
+    persister.worker.join();
+    {
+        lock_guard<mutex> guard(persister.lock);
+        persister.running = false;
+    }
+    setSavesDeferred(false);
+}
+
+void waitForSaves(SystemData& data) {
+    if (!savesDeferred) {
+        return;     // every save was written as it was made
+    }
+    unique_lock<mutex> guard(persister.lock);
+    if (persister.running) {
+        uint64_t target = savesRequested;
+        persister.signal.wait(guard, [target] { return persister.written >= target; });
+        return;
+    }
+    guard.unlock();
+    DataLockSet reading(data.locks, LockPlan().reads(ALL_DATA).readsAllPartitions());
+    flushDeferredSaves();
+}
+
 // File operations implementation
 void saveUsersToFile(const vector<Organizer>& users) {
+    if (deferSave(pendingSaves.users, users)) {
+        return;
+    }
     ofstream file("userInfo.txt");
     if (!file.is_open()) {
         cout << "Error: Could not save user data to file!" << endl;
@@ -46,16 +245,24 @@ void saveUsersToFile(const vector<Organizer>& users) {
     }
 
     file.close();
-    cout << "User data saved successfully." << endl;
+    if (!writingInBackground) {
+        cout << "User data saved successfully." << endl;
+    }
 }
 
 void saveDataToFiles(const SystemData& data) {
+    vector<TaskFuture<void>> writes;
+    saveInBackground(writes, "save venues", saveVenuesToFile, &data.venues, flushing);
+    saveInBackground(writes, "save registrations", saveRegistrationsToFile, &data.registrations, flushing);
+    saveInBackground(writes, "save bookings", saveBookingsToFile, &data.bookings, flushing);
+    saveInBackground(writes, "save payments", savePaymentsToFile, &data.payments, flushing);
+    saveInBackground(writes, "save feedback", saveFeedbackToFile, &data.feedbacks, flushing);
+    saveInBackground(writes, "save waitlist", saveWaitlistToFile, &data.waitlist, flushing);
+    saveInBackground(writes, "save holds", saveHoldsToFile, &data.holds, flushing);
     saveUsersToFile(data.organizer);
-    saveVenuesToFile(data.venues);
-    saveRegistrationsToFile(data.registrations);
-    saveBookingsToFile(data.bookings);
-    savePaymentsToFile(data.payments);
-    saveFeedbackToFile(data.feedbacks);
+    for (auto& write : writes) {
+        write.get();
+    }
     cout << "Data saved successfully to files." << endl;
 }
 
@@ -66,9 +273,16 @@ void loadDataFromFiles(SystemData& data) {
     loadBookingsFromFile(data.bookings);
     loadPaymentsFromFile(data.payments);
     loadFeedbackFromFile(data.feedbacks);
+    loadWaitlistFromFile(data.waitlist);
+    linkWaitlistRegistrations(data);
+    loadHoldsFromFile(data.holds);
+    loadTimeSlotConfig(data.timeConfig);
 }
 
 void saveVenuesToFile(const vector<Venue>& venues) {
+    if (deferSave(pendingSaves.venues, venues)) {
+        return;
+    }
     ofstream file("venues.txt");
     if (file.is_open()) {
         for (const auto& venue : venues) {
@@ -129,7 +343,10 @@ void loadUserFromFile(vector<Organizer>& users) {
     file.close();
 }
 
-void saveRegistrationsToFile(const vector<EventRegistration>& registrations) {
+void saveRegistrationsToFile(const RegistrationTable& registrations) {
+    if (deferSave(pendingSaves.registrations, registrations)) {
+        return;
+    }
     ofstream outFile("registrations.txt");
     if (!outFile) {
         cerr << "Error opening file for saving: " << "registrations.txt" << endl;
@@ -167,7 +384,10 @@ void saveRegistrationsToFile(const vector<EventRegistration>& registrations) {
     outFile.close();
 }
 
-void saveBookingsToFile(const vector<EventBooking>& bookings) {
+void saveBookingsToFile(const BookingTable& bookings) {
+    if (deferSave(pendingSaves.bookings, bookings)) {
+        return;
+    }
     ofstream file("bookings.txt");
     if (file.is_open()) {
         for (const auto& booking : bookings) {
@@ -248,7 +468,7 @@ void loadVenuesFromFile(vector<Venue>& venues) {
                 getline(ss, token, '|');
                 venue.capacity = stoi(token);
                 getline(ss, token, '|');
-                venue.rentalCost = stod(token);
+                venue.rentalCost = Money::parse(token);
                 getline(ss, venue.contactPerson, '|');
                 getline(ss, venue.phoneNumber, '|');
 
@@ -259,7 +479,7 @@ void loadVenuesFromFile(vector<Venue>& venues) {
     }
 }
 
-void loadRegistrationsFromFile(vector<EventRegistration>& registrations) {
+void loadRegistrationsFromFile(RegistrationTable& registrations) {
     ifstream inFile("registrations.txt");
     if (!inFile) {
         cerr << "Error: Cannot open file for loading registrations." << endl;
@@ -295,7 +515,7 @@ void loadRegistrationsFromFile(vector<EventRegistration>& registrations) {
                 getline(phoneDetails, model, ',');
                 getline(phoneDetails, priceStr, ',');
                 if (!name.empty() && !model.empty() && !priceStr.empty()) {
-                    Product p{ name, model, stod(priceStr) };
+                    Product p{ name, model, Money::parse(priceStr) };
                     reg.phoneInfo.push_back(p);
                 }
             }
@@ -307,7 +527,7 @@ void loadRegistrationsFromFile(vector<EventRegistration>& registrations) {
         reg.expectedGuests = stoi(temp);
 
         getline(ss, temp, '|');
-        reg.estimatedBudget = stod(temp);
+        reg.estimatedBudget = Money::parse(temp);
 
         getline(ss, reg.eventStatus, '|');
 
@@ -324,7 +544,7 @@ void loadRegistrationsFromFile(vector<EventRegistration>& registrations) {
     inFile.close();
 }
 
-void loadBookingsFromFile(vector<EventBooking>& bookings) {
+void loadBookingsFromFile(BookingTable& bookings) {
     ifstream file("bookings.txt");
     string line;
     int lineNumber = 0;
@@ -376,7 +596,7 @@ void loadBookingsFromFile(vector<EventBooking>& bookings) {
                 errorCount++;
                 continue;
             }
-            booking.eventReg.estimatedBudget = stod(token);
+            booking.eventReg.estimatedBudget = Money::parse(token);
 
             // Parse event status and organizer info (including userID)
             if (!getline(ss, booking.eventReg.eventStatus, '|') ||
@@ -438,7 +658,7 @@ void loadBookingsFromFile(vector<EventBooking>& bookings) {
                 errorCount++;
                 continue;
             }
-            booking.venue.rentalCost = stod(token);
+            booking.venue.rentalCost = Money::parse(token);
 
             if (!getline(ss, booking.venue.contactPerson, '|') ||
                 !getline(ss, booking.venue.phoneNumber, '|') ||
@@ -453,7 +673,7 @@ void loadBookingsFromFile(vector<EventBooking>& bookings) {
                 errorCount++;
                 continue;
             }
-            booking.finalCost = stod(token);
+            booking.finalCost = Money::parse(token);
 
             // If we get here, parsing was successful
             bookings.push_back(booking);
@@ -473,7 +693,10 @@ void loadBookingsFromFile(vector<EventBooking>& bookings) {
     cout << "Booking loading completed: " << successCount << " successful, " << errorCount << " errors." << endl;
 }
 
-void saveFeedbackToFile(const vector<EventFeedback>& feedbacks) {
+void saveFeedbackToFile(const FeedbackTable& feedbacks) {
+    if (deferSave(pendingSaves.feedbacks, feedbacks)) {
+        return;
+    }
     ofstream file("feedback.txt");
     if (!file.is_open()) {
         cout << "Error: Unable to open feedback file for saving! Kindly try again!" << endl;
@@ -503,7 +726,7 @@ void saveFeedbackToFile(const vector<EventFeedback>& feedbacks) {
     file.close();
 }
 
-void loadFeedbackFromFile(vector<EventFeedback>& feedbacks) {
+void loadFeedbackFromFile(FeedbackTable& feedbacks) {
     ifstream file("feedback.txt");
     string line;
 
@@ -575,6 +798,9 @@ void loadFeedbackFromFile(vector<EventFeedback>& feedbacks) {
 }
 
 void savePaymentsToFile(const vector<Payment>& payments) {
+    if (deferSave(pendingSaves.payments, payments)) {
+        return;
+    }
     ofstream file("payments.txt");
     if (file.is_open()) {
         for (const auto& payment : payments) {
@@ -641,7 +867,7 @@ void loadPaymentsFromFile(vector<Payment>& payments) {
                 errorCount++;
                 continue;
             }
-            payment.amount = stod(token);
+            payment.amount = Money::parse(token);
 
             // Parse payment date (format: day/month/year)
             if (!getline(ss, token, '|')) {
@@ -724,4 +950,294 @@ void loadPaymentsFromFile(vector<Payment>& payments) {
 
     file.close();
     cout << "Payment loading completed: " << successCount << " successful, " << errorCount << " errors." << endl;
-}
\ No newline at end of file
+}
+
+// Waitlist file: an ORDER line (TIME or BUDGET), then one entry per line.
+// ORDER is the system's queue order for every venue; the operator sets it
+// by editing the file while the program is stopped.
+void saveWaitlistToFile(const WaitlistBook& waitlist) {
+    if (deferSave(pendingSaves.waitlist, waitlist)) {
+        return;
+    }
+    ofstream file("waitlist.txt");
+    if (file.is_open()) {
+        file << "ORDER|" << (waitlist.rankByBudget ? "BUDGET" : "TIME") << endl;
+        for (const auto& item : waitlist.entries) {
+            const WaitlistEntry& entry = item.second;
+            file << entry.number << "|"
+                << entry.eventID << "|"
+                << entry.venueID << "|"
+                << entry.date.toString() << "|"
+                << entry.time << "|"
+                << entry.requestedAt << "|"
+                << entry.budget << "|"
+                << (entry.allowOverCapacity ? "1" : "0") << endl;
+        }
+        file.close();
+    }
+}
+
+void loadWaitlistFromFile(WaitlistBook& waitlist) {
+    ifstream file("waitlist.txt");
+    string line;
+    int lineNumber = 0;
+    int errorCount = 0;
+
+    waitlist = WaitlistBook();
+    if (!file.is_open()) {
+        cout << "No existing waitlist file found. Starting with empty waitlists." << endl;
+        return;
+    }
+
+    bool rankByBudget = false;
+
+    while (getline(file, line)) {
+        lineNumber++;
+
+        if (line.empty()) {
+            continue;
+        }
+        if (line.rfind("ORDER|", 0) == 0) {
+            rankByBudget = line.substr(6) == "BUDGET";
+            continue;
+        }
+
+        stringstream ss(line);
+        string token;
+        WaitlistEntry entry;
+
+        try {
+            string number, date, requestedAt, budget, overCapacity;
+            if (!getline(ss, number, '|') ||
+                !getline(ss, entry.eventID, '|') ||
+                !getline(ss, entry.venueID, '|') ||
+                !getline(ss, date, '|') ||
+                !getline(ss, entry.time, '|') ||
+                !getline(ss, requestedAt, '|') ||
+                !getline(ss, budget, '|') ||
+                !getline(ss, overCapacity)) {
+                cout << "Error: Incomplete waitlist entry at line " << lineNumber << endl;
+                errorCount++;
+                continue;
+            }
+
+            // Date is stored as YYYY-MM-DD
+            stringstream dateStream(date);
+            getline(dateStream, token, '-');
+            entry.date.year = stoi(token);
+            getline(dateStream, token, '-');
+            entry.date.month = stoi(token);
+            getline(dateStream, token);
+            entry.date.day = stoi(token);
+
+            entry.number = stoi(number);
+            entry.requestedAt = stoll(requestedAt);
+            entry.budget = Money::parse(budget);
+            entry.allowOverCapacity = overCapacity == "1";
+            addWaitlistEntry(waitlist, entry);
+        }
+        catch (const std::exception& e) {
+            cout << "Error loading waitlist entry at line " << lineNumber << ": " << e.what() << endl;
+            errorCount++;
+        }
+    }
+
+    // Ranks the entries read so far, wherever the ORDER line was
+    setWaitlistBudgetPriority(waitlist, rankByBudget);
+
+    file.close();
+    cout << "Waitlist loading completed: " << waitlist.entries.size() << " entries, " << errorCount << " errors." << endl;
+}
+
+// Holds file: a TTL line (seconds), then bookingID|expiresAt per live hold
+void saveHoldsToFile(const HoldBook& holds) {
+    if (deferSave(pendingSaves.holds, holds)) {
+        return;
+    }
+    ofstream file("holds.txt");
+    if (file.is_open()) {
+        file << "TTL|" << holds.holdSeconds << endl;
+        for (const auto& hold : holds.live) {
+            file << hold.first << "|" << hold.second.expiresAt << endl;
+        }
+        file.close();
+    }
+}
+
+void loadHoldsFromFile(HoldBook& holds) {
+    ifstream file("holds.txt");
+    string line;
+    int lineNumber = 0;
+    int errorCount = 0;
+
+    holds = HoldBook();
+    if (!file.is_open()) {
+        cout << "No existing holds file found. Pending bookings get a fresh payment window." << endl;
+        return;
+    }
+
+    while (getline(file, line)) {
+        lineNumber++;
+
+        if (line.empty()) {
+            continue;
+        }
+
+        stringstream ss(line);
+        string key, value;
+        if (!getline(ss, key, '|') || !getline(ss, value)) {
+            cout << "Error: Incomplete hold at line " << lineNumber << endl;
+            errorCount++;
+            continue;
+        }
+
+        try {
+            if (key == "TTL") {
+                holds.holdSeconds = stoll(value);
+                continue;
+            }
+            // Handles are filled in once bookings are matched up
+            long long expiresAt = stoll(value);
+            holds.live[key] = { expiresAt, RecordHandle(), RecordHandle() };
+            holds.deadlines.push({ expiresAt, key });
+        }
+        catch (const std::exception& e) {
+            cout << "Error loading hold at line " << lineNumber << ": " << e.what() << endl;
+            errorCount++;
+        }
+    }
+
+    file.close();
+    cout << "Hold loading completed: " << holds.live.size() << " holds, " << errorCount << " errors." << endl;
+}
+
+// Time slot file. Replaces the default sessions when it has SLOT lines:
+//   SLOT|09:00-13:00|Morning Session (9AM - 1PM)
+//   HOURS|V002|09:00-13:00,17:00-21:00|MON,TUE,WED,THU,FRI
+//   CLOSED|V003|2026-11-02|2026-11-06|*|Maintenance
+//   CLOSED|*|2026-12-25|2026-12-25|*|Christmas Day
+// HOURS lists the slots a venue runs and its open weekdays (ALL = every
+// day); * in CLOSED means every venue or every slot.
+static bool parseFileDate(const string& text, Date& date) {
+    stringstream dateStream(text);
+    char dash1 = 0, dash2 = 0;
+    return static_cast<bool>(dateStream >> date.year >> dash1 >> date.month >> dash2 >> date.day) &&
+        dash1 == '-' && dash2 == '-' && date.month >= 1 && date.month <= 12 && date.day >= 1 && date.day <= 31;
+}
+
+static bool parseWeekdays(const string& text, uint8_t& days) {
+    static const string NAMES[7] = { "SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT" };
+    if (toUpperCase(text) == "ALL") {
+        days = EVERY_WEEKDAY;
+        return true;
+    }
+    days = 0;
+    stringstream ss(text);
+    string name;
+    while (getline(ss, name, ',')) {
+        auto found = find(begin(NAMES), end(NAMES), toUpperCase(name));
+        if (found == end(NAMES)) {
+            return false;
+        }
+        days |= static_cast<uint8_t>(1 << (found - begin(NAMES)));
+    }
+    return true;
+}
+
+void loadTimeSlotConfig(TimeSlotConfig& config) {
+    ifstream file("timeslots.txt");
+    string line;
+    int lineNumber = 0;
+    int errorCount = 0;
+
+    config = TimeSlotConfig();
+    if (!file.is_open()) {
+        cout << "No time slot file found. Using the default sessions for every venue." << endl;
+        return;
+    }
+
+    vector<string> timeSlots;
+    vector<string> timeSlotNames;
+    vector<int> hoursLines;
+    while (getline(file, line)) {
+        lineNumber++;
+
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        stringstream ss(line);
+        string kind;
+        getline(ss, kind, '|');
+
+        if (kind == "SLOT") {
+            string time, name;
+            if (!getline(ss, time, '|') || !getline(ss, name) || time.empty()) {
+                cout << "Error: Incomplete time slot at line " << lineNumber << endl;
+                errorCount++;
+                continue;
+            }
+            timeSlots.push_back(time);
+            timeSlotNames.push_back(name);
+        }
+        else if (kind == "HOURS") {
+            VenueHours hours;
+            string slots, days;
+            if (!getline(ss, hours.venueID, '|') || !getline(ss, slots, '|') || !getline(ss, days) ||
+                !parseWeekdays(days, hours.openDays)) {
+                cout << "Error: Invalid venue hours at line " << lineNumber << endl;
+                errorCount++;
+                continue;
+            }
+            stringstream slotStream(slots);
+            string time;
+            while (getline(slotStream, time, ',')) {
+                hours.slots.push_back(time);
+            }
+            config.venueHours.push_back(hours);
+            hoursLines.push_back(lineNumber);
+        }
+        else if (kind == "CLOSED") {
+            SlotClosure closure;
+            string from, to;
+            if (!getline(ss, closure.venueID, '|') || !getline(ss, from, '|') || !getline(ss, to, '|') ||
+                !getline(ss, closure.time, '|') || !parseFileDate(from, closure.from) || !parseFileDate(to, closure.to)) {
+                cout << "Error: Invalid closure at line " << lineNumber << endl;
+                errorCount++;
+                continue;
+            }
+            getline(ss, closure.reason);
+            if (closure.venueID == "*") {
+                closure.venueID.clear();
+            }
+            if (closure.time == "*") {
+                closure.time.clear();
+            }
+            config.closures.push_back(closure);
+        }
+        else {
+            cout << "Error: Unknown time slot entry at line " << lineNumber << endl;
+            errorCount++;
+        }
+    }
+
+    if (!timeSlots.empty()) {
+        config.timeSlots = timeSlots;
+        config.timeSlotNames = timeSlotNames;
+    }
+
+    // SLOT lines may come after HOURS, so slot times are checked once all are read
+    for (size_t i = 0; i < config.venueHours.size(); i++) {
+        for (const auto& time : config.venueHours[i].slots) {
+            if (find(config.timeSlots.begin(), config.timeSlots.end(), time) == config.timeSlots.end()) {
+                cout << "Error: Unknown time slot " << time << " in venue hours at line " << hoursLines[i] << endl;
+                errorCount++;
+            }
+        }
+    }
+
+    file.close();
+    cout << "Time slot loading completed: " << config.timeSlots.size() << " slots, "
+        << config.venueHours.size() << " venue calendars, " << config.closures.size() << " closures, "
+        << errorCount << " errors." << endl;
+}
@@ -8,16 +8,43 @@ using namespace std;
 // Function prototypes - File Operations
 void saveUsersToFile(const vector<Organizer>& users);
 void loadUserFromFile(vector<Organizer>& users);
-void saveDataToFiles(const SystemData& data);
+void saveDataToFiles(const SystemData& data);    // files written side by side on the background pool
 void loadDataFromFiles(SystemData& data);
 void saveVenuesToFile(const vector<Venue>& venues);
-void saveRegistrationsToFile(const vector<EventRegistration>& registrations);
-void saveBookingsToFile(const vector<EventBooking>& bookings);
+void saveRegistrationsToFile(const RegistrationTable& registrations);
+void saveBookingsToFile(const BookingTable& bookings);
 void loadVenuesFromFile(vector<Venue>& venues);
-void loadRegistrationsFromFile(vector<EventRegistration>& registrations);
-void loadBookingsFromFile(vector<EventBooking>& bookings);
-void saveFeedbackToFile(const vector<EventFeedback>& feedbacks);
-void loadFeedbackFromFile(vector<EventFeedback>& feedbacks);
+void loadRegistrationsFromFile(RegistrationTable& registrations);
+void loadBookingsFromFile(BookingTable& bookings);
+void saveFeedbackToFile(const FeedbackTable& feedbacks);
+void loadFeedbackFromFile(FeedbackTable& feedbacks);
 void savePaymentsToFile(const vector<Payment>& payments);
 void loadPaymentsFromFile(vector<Payment>& payments);
+void saveWaitlistToFile(const WaitlistBook& waitlist);
+void loadWaitlistFromFile(WaitlistBook& waitlist);
+void saveHoldsToFile(const HoldBook& holds);
+void loadHoldsFromFile(HoldBook& holds);
+void loadTimeSlotConfig(TimeSlotConfig& config);
+
+// Batch mode: saves made while deferred are coalesced until flushed.
+// Turning deferral off flushes; returns the number of files written.
+// A flush only reads the collections, so with several sessions it needs
+// shared locks on all of them (see data_locks.h).
+void setSavesDeferred(bool deferred);
+int flushDeferredSaves();
+void discardDeferredSaves();    // forget pending saves of throwaway data
+
+// Background saves for the interactive console: saves are deferred and a
+// persistence thread writes them as soon as it can take shared locks on
+// the data, which a console session gives up at every prompt (see
+// setPromptWaitHook). Stopping writes whatever is still pending and
+// needs the caller to hold no data locks.
+void startBackgroundSaves(SystemData& data);
+void stopBackgroundSaves();
+
+// Durability barrier: returns once every save requested before the call
+// is on disk, e.g. before a payment is confirmed. Without a persistence
+// thread it writes them itself. Call it holding no data locks (inside an
+// UnlockedSection in a session).
+void waitForSaves(SystemData& data);
 #endif
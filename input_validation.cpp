@@ -29,6 +29,7 @@ string toUpperCase(const string& str) {
 //prompt user to exit some function if user want back to the previous function
 bool getExit() {
     char choice;
+    string input;
     bool validInput = false;
 
     cout << "\n=== RETURN CONFIRMATION ===" << endl;
@@ -36,8 +37,9 @@ bool getExit() {
 
     while (!validInput) {
         cout << "Enter 'Y' for Yes or 'N' for No: ";
-        cin >> choice;
-        cin.ignore(); // Clear the input buffer
+        readInputLine(input);
+        size_t first = input.find_first_not_of(" \t");
+        choice = first == string::npos ? '\0' : input[first];
 
         // Convert the user input to uppercase
         choice = toupper(choice);
@@ -54,6 +56,7 @@ bool getExit() {
         }
         else {
             cout << "Invalid input. Please enter 'Y' for Yes or 'N' for No." << endl;
+            rejectScriptedAnswer();
         }
     }
 
@@ -68,11 +71,12 @@ int getValidIntegerInput(const string& prompt, int minVal, int maxVal) {
     while (true) {
         if (!firstAttempt) {
             cout << "Invalid input. Please try again." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
         cout << prompt;
-        getline(cin, input);
+        readInputLine(input);
 
         // Check for empty input
         if (input.empty()) {
@@ -133,11 +137,12 @@ int getValidIntegerInputWithExit(const string& prompt, int minVal, int maxVal) {
     while (true) {
         if (!firstAttempt) {
             cout << "Invalid input. Please try again." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
         cout << prompt;
-        getline(cin, input);
+        readInputLine(input);
 
         //Check whether user enter '0' or not
         if (input == "0")
@@ -207,11 +212,12 @@ string getValidStringInput(const string& prompt, int minLength) {
     while (true) {
         if (!firstAttempt) {
             cout << "Invalid input. Please try again." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
         cout << prompt;
-        getline(cin, input);
+        readInputLine(input);
 
         // Remove leading and trailing whitespace
         size_t start = input.find_first_not_of(" \t");
@@ -261,7 +267,7 @@ string getValidStringInputWithExit(const string& prompt, int minLength) { //defa
 
         cout << prompt << "(Enter '0' to return previous menu)" << endl;
         cout << " -> ";
-        getline(cin, input);
+        readInputLine(input);
 
         //Check whether user enter '0' or not
         if (input == "0")
@@ -286,12 +292,14 @@ string getValidStringInputWithExit(const string& prompt, int minLength) { //defa
         // Check for empty input after trimming
         if (input.empty()) {
             cout << "Error: Input cannot be empty or contain only spaces." << endl;
+            rejectScriptedAnswer();
             continue;
         }
 
         // Check minimum length
         if ((int)input.length() < minLength) {
             cout << "Error: Input must be at least " << minLength << " characters long." << endl;
+            rejectScriptedAnswer();
             continue;
         }
 
@@ -307,6 +315,7 @@ string getValidStringInputWithExit(const string& prompt, int minLength) { //defa
 
         if (!hasAlpha) {
             cout << "Error: Input must contain at least one letter." << endl;
+            rejectScriptedAnswer();
             continue;
         }
 
@@ -318,7 +327,7 @@ string getValidStringInputOrKeepCurrent(const string& prompt, int minLength) {
     string input;
 
     cout << prompt << " (Enter '0' to return to previous menu, press Enter to keep current value): ";
-    getline(cin, input);
+    readInputLine(input);
 
     // check if user enter 0
     if (input == "0") {
@@ -368,6 +377,7 @@ string getValidStringInputOrKeepCurrent(const string& prompt, int minLength) {
     }
 
     if (!isValid) {
+        rejectScriptedAnswer();
         return getValidStringInputOrKeepCurrent(prompt, minLength);
     }
 
@@ -382,11 +392,12 @@ double getValidDoubleInput(const string& prompt, double minVal) {
     while (true) {
         if (!firstAttempt) {
             cout << "Invalid input. Please try again." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
         cout << prompt;
-        getline(cin, input);
+        readInputLine(input);
 
         // Check for empty input
         if (input.empty()) {
@@ -463,11 +474,12 @@ double getValidDoubleInputWithExit(const string& prompt, double minVal) {
     while (true) {
         if (!firstAttempt) {
             cout << "Invalid input. Please try again." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
         cout << prompt;
-        getline(cin, input);
+        readInputLine(input);
 
 
         //Check whether user enter '0' or not
@@ -555,11 +567,12 @@ char getValidCharInput(const string& prompt, const vector<char>& validChars) {
     while (true) {
         if (!firstAttempt) {
             cout << "Invalid choice. Please try again." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
         cout << prompt;
-        getline(cin, input);
+        readInputLine(input);
 
         // Remove whitespace
         size_t start = input.find_first_not_of(" \t");
@@ -640,6 +653,7 @@ Date getValidDateInput() {
     while (true) {
         if (!firstAttempt) {
             cout << "Please enter a valid year." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
@@ -661,6 +675,7 @@ Date getValidDateInput() {
     while (true) {
         if (!firstAttempt) {
             cout << "Please enter a valid month." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
@@ -696,6 +711,7 @@ Date getValidDateInput() {
     while (true) {
         if (!firstAttempt) {
             cout << "Please enter a valid day." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
@@ -727,6 +743,7 @@ string getValidPhoneNumber(const string& prompt) {
     while (true) {
         if (!firstAttempt) {
             cout << "Invalid phone number format. Please try again." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
@@ -741,7 +758,7 @@ string getValidPhoneNumber(const string& prompt) {
         }
 
         cout << prompt;
-        getline(cin, input);
+        readInputLine(input);
 
         // Remove whitespace and dashes
         string cleanNumber = "";
@@ -800,7 +817,7 @@ string getValidEmailAddress(const string& prompt) {
 
     while (true) {
         cout << prompt;
-        getline(cin, input);
+        readInputLine(input);
 
         //Check whether user enter '0' or not
         if (input == "0")
@@ -814,6 +831,7 @@ string getValidEmailAddress(const string& prompt) {
 
         if (input.empty()) {
             cout << "Error: Email address cannot be empty." << endl;
+            rejectScriptedAnswer();
             continue;
         }
 
@@ -824,6 +842,7 @@ string getValidEmailAddress(const string& prompt) {
         else
         {
             cout << "Error: Invalid email format. Kindly try again!!! (must small capital letter with @XXX.com or @XXX.my): " << endl;
+            rejectScriptedAnswer();
         }
     }
 }
@@ -836,7 +855,11 @@ string getValidPassword(const string& prompt) {
     while (true)
     {
         cout << prompt;
-        cin >> password;
+        // First word of the line, as the old cin >> read it
+        readInputLine(password);
+        stringstream words(password);
+        password.clear();
+        words >> password;
 
         //Check whether user enter '0' or not
         if (password == "0")
@@ -850,6 +873,7 @@ string getValidPassword(const string& prompt) {
 
         if (password.empty()) {
             cout << "Error: Password cannot be empty." << endl;
+            rejectScriptedAnswer();
             continue;
         }
 
@@ -857,6 +881,7 @@ string getValidPassword(const string& prompt) {
         {
             cout << "Error: Password is invalid! " << endl;
             cout << "Please make sure no less than 8 and more than 20 characters" << endl;
+            rejectScriptedAnswer();
             continue;
         }
 
@@ -868,6 +893,7 @@ string getValidPassword(const string& prompt) {
         {
             cout << "Error: Password wrong format. Kindly try again! " << endl;
             cout << "Error: Password must include at least one uppercase letter, one lowercase letter, and one digit." << endl;
+            rejectScriptedAnswer();
         }
 
     }
@@ -888,11 +914,12 @@ string getValidEventStatus(const string& prompt) {
     while (true) {
         if (!firstAttempt) {
             cout << "Invalid status. Please try again." << endl;
+            rejectScriptedAnswer();
         }
         firstAttempt = false;
 
         cout << prompt;
-        getline(cin, input);
+        readInputLine(input);
 
         // Remove whitespace and convert to uppercase
         size_t start = input.find_first_not_of(" \t");
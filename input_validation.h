@@ -16,6 +16,7 @@
 #include "event_registration.h"
 #include "event_booking.h"
 #include "timeslot.h"
+#include "console_input.h"
 
 using namespace std;
 
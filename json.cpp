@@ -0,0 +1,466 @@
+#include "json.h"
+#include <charconv>
+#include <cstdlib>
+
+using namespace std;
+
+// ---- Parsing ----
+
+const JsonValue* JsonValue::find(string_view key) const {
+    for (const auto& member : members) {
+        if (member.first == key) {
+            return &member.second;
+        }
+    }
+    return nullptr;
+}
+
+string JsonValue::getString(string_view key, const string& fallback) const {
+    const JsonValue* member = find(key);
+    if (member == nullptr) {
+        return fallback;
+    }
+    // Numbers are accepted where text is expected, e.g. "slot": 1
+    return member->isString() || member->isNumber() ? member->text : fallback;
+}
+
+long long JsonValue::getInteger(string_view key, long long fallback) const {
+    const JsonValue* member = find(key);
+    if (member == nullptr || !member->isNumber()) {
+        return fallback;
+    }
+    return static_cast<long long>(member->number);
+}
+
+bool JsonValue::getBool(string_view key, bool fallback) const {
+    const JsonValue* member = find(key);
+    if (member == nullptr || member->type != Type::Bool) {
+        return fallback;
+    }
+    return member->boolean;
+}
+
+namespace {
+
+const int MAX_DEPTH = 32;
+
+struct JsonParser {
+    string_view text;
+    size_t position = 0;
+    string error;
+
+    explicit JsonParser(string_view text) : text(text) {}
+
+    bool fail(const string& message) {
+        if (error.empty()) {
+            error = message + " at offset " + to_string(position);
+        }
+        return false;
+    }
+
+    void skipSpace() {
+        while (position < text.size() &&
+            (text[position] == ' ' || text[position] == '\t' || text[position] == '\r' || text[position] == '\n')) {
+            position++;
+        }
+    }
+
+    bool literal(string_view word) {
+        if (text.compare(position, word.size(), word) != 0) {
+            return fail("unexpected token");
+        }
+        position += word.size();
+        return true;
+    }
+
+    static void appendUtf8(string& out, unsigned codePoint) {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        }
+        else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    bool hex4(unsigned& codePoint) {
+        if (position + 4 > text.size()) {
+            return fail("truncated \\u escape");
+        }
+        auto result = from_chars(text.data() + position, text.data() + position + 4, codePoint, 16);
+        if (result.ec != errc() || result.ptr != text.data() + position + 4) {
+            return fail("bad \\u escape");
+        }
+        position += 4;
+        return true;
+    }
+
+    bool parseString(string& out) {
+        position++; // opening quote
+        while (true) {
+            // Copy the plain run in one go
+            size_t start = position;
+            while (position < text.size() && text[position] != '"' && text[position] != '\\' &&
+                static_cast<unsigned char>(text[position]) >= 0x20) {
+                position++;
+            }
+            out.append(text.substr(start, position - start));
+
+            if (position >= text.size()) {
+                return fail("unterminated string");
+            }
+            char c = text[position];
+            if (c == '"') {
+                position++;
+                return true;
+            }
+            if (c != '\\') {
+                return fail("control character in string");
+            }
+            if (++position >= text.size()) {
+                return fail("unterminated string");
+            }
+            char escape = text[position++];
+            switch (escape) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                unsigned codePoint = 0;
+                if (!hex4(codePoint)) {
+                    return false;
+                }
+                // Join a surrogate pair
+                if (codePoint >= 0xD800 && codePoint < 0xDC00 &&
+                    text.compare(position, 2, "\\u") == 0) {
+                    position += 2;
+                    unsigned low = 0;
+                    if (!hex4(low)) {
+                        return false;
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, codePoint);
+                break;
+            }
+            default:
+                return fail("bad escape");
+            }
+        }
+    }
+
+    bool parseNumber(JsonValue& value) {
+        size_t start = position;
+        if (position < text.size() && text[position] == '-') {
+            position++;
+        }
+        while (position < text.size() &&
+            ((text[position] >= '0' && text[position] <= '9') || text[position] == '.' ||
+                text[position] == 'e' || text[position] == 'E' || text[position] == '+' || text[position] == '-')) {
+            position++;
+        }
+        value.type = JsonValue::Type::Number;
+        value.text = string(text.substr(start, position - start));
+        char* end = nullptr;
+        value.number = strtod(value.text.c_str(), &end);
+        if (value.text.empty() || end != value.text.c_str() + value.text.size()) {
+            return fail("bad number");
+        }
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, int depth) {
+        if (depth > MAX_DEPTH) {
+            return fail("nested too deeply");
+        }
+        skipSpace();
+        if (position >= text.size()) {
+            return fail("unexpected end of input");
+        }
+
+        char c = text[position];
+        if (c == '{') {
+            value.type = JsonValue::Type::Object;
+            position++;
+            skipSpace();
+            if (position < text.size() && text[position] == '}') {
+                position++;
+                return true;
+            }
+            while (true) {
+                skipSpace();
+                if (position >= text.size() || text[position] != '"') {
+                    return fail("expected member name");
+                }
+                value.members.emplace_back();
+                if (!parseString(value.members.back().first)) {
+                    return false;
+                }
+                skipSpace();
+                if (position >= text.size() || text[position] != ':') {
+                    return fail("expected ':'");
+                }
+                position++;
+                if (!parseValue(value.members.back().second, depth + 1)) {
+                    return false;
+                }
+                skipSpace();
+                if (position < text.size() && text[position] == ',') {
+                    position++;
+                    continue;
+                }
+                if (position < text.size() && text[position] == '}') {
+                    position++;
+                    return true;
+                }
+                return fail("expected ',' or '}'");
+            }
+        }
+        if (c == '[') {
+            value.type = JsonValue::Type::Array;
+            position++;
+            skipSpace();
+            if (position < text.size() && text[position] == ']') {
+                position++;
+                return true;
+            }
+            while (true) {
+                value.items.emplace_back();
+                if (!parseValue(value.items.back(), depth + 1)) {
+                    return false;
+                }
+                skipSpace();
+                if (position < text.size() && text[position] == ',') {
+                    position++;
+                    continue;
+                }
+                if (position < text.size() && text[position] == ']') {
+                    position++;
+                    return true;
+                }
+                return fail("expected ',' or ']'");
+            }
+        }
+        if (c == '"') {
+            value.type = JsonValue::Type::String;
+            return parseString(value.text);
+        }
+        if (c == 't') {
+            value.type = JsonValue::Type::Bool;
+            value.boolean = true;
+            return literal("true");
+        }
+        if (c == 'f') {
+            value.type = JsonValue::Type::Bool;
+            return literal("false");
+        }
+        if (c == 'n') {
+            return literal("null");
+        }
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            return parseNumber(value);
+        }
+        return fail("unexpected character");
+    }
+};
+
+}
+
+bool parseJson(string_view text, JsonValue& value, string& error) {
+    JsonParser parser(text);
+    value = JsonValue();
+    if (!parser.parseValue(value, 0)) {
+        error = parser.error;
+        return false;
+    }
+    parser.skipSpace();
+    if (parser.position != text.size()) {
+        parser.fail("trailing characters");
+        error = parser.error;
+        return false;
+    }
+    return true;
+}
+
+// ---- Writing ----
+
+void JsonWriter::rewind(Mark at) {
+    out.resize(at.size);
+    needComma = at.needComma;
+}
+
+void JsonWriter::separate() {
+    if (needComma) {
+        out += ',';
+    }
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    separate();
+    out += '{';
+    needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    out += '}';
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    separate();
+    out += '[';
+    needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    out += ']';
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(string_view name) {
+    value(name);
+    out += ':';
+    needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+    separate();
+    out += '"';
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(text.substr(start, i - start));
+        start = i + 1;
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            out += "\\u00";
+            out += HEX[c >> 4];
+            out += HEX[c & 0xF];
+        }
+    }
+    out.append(text.substr(start));
+    out += '"';
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(long long number) {
+    separate();
+    char buffer[24];
+    char* end = to_chars(buffer, buffer + sizeof(buffer), number).ptr;
+    out.append(buffer, end);
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    separate();
+    char buffer[32];
+    char* end = to_chars(buffer, buffer + sizeof(buffer), number).ptr;
+    out.append(buffer, end);
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    separate();
+    out += flag ? "true" : "false";
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(Money amount) {
+    separate();
+    char buffer[26];
+    buffer[0] = '"';
+    char* end = amount.formatTo(buffer + 1);
+    *end++ = '"';
+    out.append(buffer, end);
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const Date& date) {
+    separate();
+    char buffer[16];
+    char* cursor = buffer;
+    *cursor++ = '"';
+    cursor = to_chars(cursor, buffer + sizeof(buffer), date.year).ptr;
+    *cursor++ = '-';
+    *cursor++ = static_cast<char>('0' + date.month / 10);
+    *cursor++ = static_cast<char>('0' + date.month % 10);
+    *cursor++ = '-';
+    *cursor++ = static_cast<char>('0' + date.day / 10);
+    *cursor++ = static_cast<char>('0' + date.day % 10);
+    *cursor++ = '"';
+    out.append(buffer, cursor);
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const JsonValue& parsed) {
+    switch (parsed.type) {
+    case JsonValue::Type::Null:
+        return null();
+    case JsonValue::Type::Bool:
+        return value(parsed.boolean);
+    case JsonValue::Type::Number:
+        // Echo it as the client wrote it
+        separate();
+        out += parsed.text;
+        needComma = true;
+        return *this;
+    case JsonValue::Type::String:
+        return value(string_view(parsed.text));
+    case JsonValue::Type::Array:
+        beginArray();
+        for (const auto& item : parsed.items) {
+            value(item);
+        }
+        return endArray();
+    case JsonValue::Type::Object:
+        beginObject();
+        for (const auto& member : parsed.members) {
+            key(member.first).value(member.second);
+        }
+        return endObject();
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    separate();
+    out += "null";
+    needComma = true;
+    return *this;
+}
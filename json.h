@@ -0,0 +1,84 @@
+#pragma once
+#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include "date.h"
+#include "money.h"
+using namespace std;
+
+// Parsed request value. Objects keep their members in document order;
+// requests are small, so lookups just scan them.
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0;
+    string text;                                // String contents, or a Number as written
+    vector<JsonValue> items;                    // Array
+    vector<pair<string, JsonValue>> members;    // Object
+
+    const JsonValue* find(string_view key) const;
+    bool isString() const { return type == Type::String; }
+    bool isNumber() const { return type == Type::Number; }
+
+    // Member lookups with a fallback when missing or of another type
+    string getString(string_view key, const string& fallback = "") const;
+    long long getInteger(string_view key, long long fallback = 0) const;
+    bool getBool(string_view key, bool fallback = false) const;
+};
+
+// Parses one complete JSON document; on failure error says where
+bool parseJson(string_view text, JsonValue& value, string& error);
+
+// Streaming writer that appends straight onto a caller-owned buffer, so a
+// response is built without temporaries and sent with a single write.
+// Commas are inserted automatically.
+class JsonWriter {
+public:
+    explicit JsonWriter(string& buffer) : out(buffer) {}
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    JsonWriter& key(string_view name);
+
+    JsonWriter& value(string_view text);
+    JsonWriter& value(const char* text) { return value(string_view(text)); }
+    JsonWriter& value(const string& text) { return value(string_view(text)); }
+    JsonWriter& value(long long number);
+    JsonWriter& value(int number) { return value(static_cast<long long>(number)); }
+    JsonWriter& value(size_t number) { return value(static_cast<long long>(number)); }
+    JsonWriter& value(double number);
+    JsonWriter& value(bool flag);
+    JsonWriter& value(Money amount);            // as a string, "1234.50", so no precision is lost
+    JsonWriter& value(const Date& date);        // "YYYY-MM-DD"
+    JsonWriter& value(const JsonValue& parsed);
+    JsonWriter& null();
+
+    // key(name).value(v) in one call
+    template <typename T>
+    JsonWriter& field(string_view name, const T& v) { return key(name).value(v); }
+
+    // A point to drop back to, e.g. to replace a partly written result.
+    // Only valid within the object or array it was taken in.
+    struct Mark {
+        size_t size;
+        bool needComma;
+    };
+    Mark mark() const { return { out.size(), needComma }; }
+    void rewind(Mark at);
+
+private:
+    string& out;
+    bool needComma = false;
+
+    void separate();
+};
+
+#endif
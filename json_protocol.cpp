@@ -0,0 +1,673 @@
+#include "json_protocol.h"
+#include <algorithm>
+#include <regex>
+#include <vector>
+#include "json.h"
+#include "system_data.h"
+#include "console_input.h"
+#include "file_operation.h"
+#include "user.h"
+#include "event_payment.h"
+#include "booking_transaction.h"
+#include "booking_lifecycle.h"
+#include "feedback_search.h"
+#include "revenue_cube.h"
+#include "utility_fun.h"
+#include "input_validation.h"
+#include "data_locks.h"
+#include "worker_pool.h"
+
+using namespace std;
+
+// A handler writes its result fields, or sets error and returns false
+using JsonHandler = bool (*)(SystemData& data, ProtocolSession& session, const JsonValue& request, JsonWriter& out, string& error);
+
+// What an operation does with the session user's partition
+enum class ShardAccess { None, Read, Write, All };
+
+// Each operation declares its locks up front; see data_locks.h
+struct JsonOperation {
+    const char* name;
+    bool needsLogin;
+    JsonHandler handler;
+    DataMask reads;         // collections it looks at
+    DataMask writes;        // collections it adds to or rearranges
+    ShardAccess organizer;  // the user's records: read, changed in place, or everyone's
+    ShardAccess venue;      // the schedule of the request's venueID
+};
+
+static char upper(char c) {
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 32) : c;
+}
+
+// Queries scan every record, so these compare in place rather than
+// building normalized copies the way the menu screens do
+static bool containsUpper(string_view text, string_view upperTerm) {
+    if (upperTerm.size() > text.size()) {
+        return false;
+    }
+    for (size_t start = 0; start + upperTerm.size() <= text.size(); start++) {
+        size_t i = 0;
+        while (i < upperTerm.size() && upper(text[start + i]) == upperTerm[i]) {
+            i++;
+        }
+        if (i == upperTerm.size()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Same result as normalizeUserID(userID) == normalizedUser
+static bool isUser(string_view userID, const string& normalizedUser) {
+    size_t first = userID.find_first_not_of(" \t\n\r");
+    size_t last = userID.find_last_not_of(" \t\n\r");
+    userID = first == string_view::npos ? string_view() : userID.substr(first, last - first + 1);
+    if (userID.size() != normalizedUser.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < userID.size(); i++) {
+        if (upper(userID[i]) != normalizedUser[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool ownedBy(const EventRegistration& registration, const string& normalizedUser) {
+    return isUser(registration.organizer.userID, normalizedUser);
+}
+
+static bool parseRequestDate(const string& text, Date& date) {
+    static const regex pattern(R"(^(\d{4})-(\d{2})-(\d{2})$)");
+    smatch match;
+    if (!regex_match(text, match, pattern)) {
+        return false;
+    }
+    date = Date{ stoi(match[1]), stoi(match[2]), stoi(match[3]) };
+    // Reject days that don't exist by round-tripping the calendar
+    Date check = Date::fromDayNumber(date.toDayNumber());
+    return check.year == date.year && check.month == date.month && check.day == date.day;
+}
+
+static bool allDigits(const string& text, size_t length) {
+    return text.size() == length && text.find_first_not_of("0123456789") == string::npos;
+}
+
+static string withoutSpaces(const string& text) {
+    string result;
+    for (char c : text) {
+        if (c != ' ') result += c;
+    }
+    return result;
+}
+
+static void writeBooking(JsonWriter& out, const EventBooking& booking) {
+    out.beginObject()
+        .field("bookingID", booking.bookingID)
+        .field("eventID", booking.eventReg.eventID)
+        .field("eventTitle", booking.eventReg.eventTitle)
+        .field("date", booking.eventDate)
+        .field("time", booking.eventTime)
+        .field("venueID", booking.venue.venueID)
+        .field("venueName", booking.venue.venueName)
+        .field("status", booking.bookingStatus)
+        .field("finalCost", booking.finalCost)
+        .endObject();
+}
+
+// ---- Operations ----
+
+static bool opPing(SystemData&, ProtocolSession&, const JsonValue&, JsonWriter& out, string&) {
+    out.field("pong", true);
+    return true;
+}
+
+static bool opLogin(SystemData& data, ProtocolSession& session, const JsonValue& request, JsonWriter& out, string& error) {
+    Organizer* user = findLoginUser(data.organizer, request.getString("user"), request.getString("password"));
+    if (user == nullptr) {
+        error = "Invalid User ID or Password";
+        return false;
+    }
+    user->isLoggedIn = true;
+    session.user = user->userID;
+    saveUsersToFile(data.organizer);
+    out.field("user", user->userID).field("name", user->organizerName);
+    return true;
+}
+
+static bool opLogout(SystemData&, ProtocolSession& session, const JsonValue&, JsonWriter&, string&) {
+    session.user.clear();
+    return true;
+}
+
+static bool opBookings(SystemData& data, ProtocolSession& session, const JsonValue& request, JsonWriter& out, string&) {
+    string status = request.getString("status");
+    string eventID = request.getString("eventID");
+    long long limit = request.getInteger("limit", -1);
+    const string me = normalizeUserID(session.user);
+
+    out.key("bookings").beginArray();
+    long long count = 0;
+    for (const auto& booking : data.bookings) {
+        if (count == limit) {
+            break;
+        }
+        // Owner first: other organizers' statuses may be changing under us
+        if (!ownedBy(booking.eventReg, me) ||
+            (!eventID.empty() && booking.eventReg.eventID != eventID) ||
+            (!status.empty() && booking.bookingStatus != status)) {
+            continue;
+        }
+        writeBooking(out, booking);
+        count++;
+    }
+    out.endArray().field("count", count);
+    return true;
+}
+
+static bool opCreateBooking(SystemData& data, ProtocolSession& session, const JsonValue& request, JsonWriter& out, string& error) {
+    // Registration: the current user's, not yet scheduled
+    string eventID = request.getString("eventID");
+    const string me = normalizeUserID(session.user);
+    RecordHandle registration;
+    for (auto it = data.registrations.begin(); it != data.registrations.end(); ++it) {
+        if (it->eventID == eventID && ownedBy(*it, me)) {
+            registration = it.handle();
+            break;
+        }
+    }
+    if (!registration.valid()) {
+        error = "No registration " + eventID + " under your account";
+        return false;
+    }
+    const EventRegistration& reg = data.registrations[registration];
+    if (reg.eventStatus != "UNSCHEDULED") {
+        error = "Registration " + eventID + " is " + reg.eventStatus + ", not UNSCHEDULED";
+        return false;
+    }
+
+    Date date{};
+    if (!parseRequestDate(request.getString("date"), date)) {
+        error = "date must be a valid YYYY-MM-DD";
+        return false;
+    }
+
+    // Time slot by its time or by its 1-based number
+    const vector<string>& slots = data.timeConfig.timeSlots;
+    string time = request.getString("time");
+    long long slot = request.getInteger("slot", 0);
+    if (time.empty() && slot >= 1 && slot <= static_cast<long long>(slots.size())) {
+        time = slots[slot - 1];
+    }
+    if (find(slots.begin(), slots.end(), time) == slots.end()) {
+        error = "time must be one of the configured time slots";
+        return false;
+    }
+
+    string venueID = request.getString("venueID");
+    int venue = -1;
+    for (size_t i = 0; i < data.venues.size(); i++) {
+        if (data.venues[i].venueID == venueID) {
+            venue = static_cast<int>(i);
+            break;
+        }
+    }
+    if (venue == -1) {
+        error = "Unknown venue " + venueID;
+        return false;
+    }
+    for (const auto& existing : data.bookings) {
+        if (existing.eventReg.eventID == eventID && existing.eventTime == time &&
+            existing.eventDate.toDayNumber() == date.toDayNumber() && existing.bookingStatus != "Cancelled") {
+            error = "Duplicate booking: " + existing.bookingID + " already covers this date and time";
+            return false;
+        }
+    }
+
+    bool overCapacity = reg.expectedGuests > data.venues[venue].capacity;
+    if (overCapacity && !request.getBool("allowOverCapacity")) {
+        error = "Expected guests exceed the venue capacity (set allowOverCapacity to book anyway)";
+        return false;
+    }
+
+    BookingTransaction transaction;
+    size_t part = stageBooking(transaction, registration, venue, date, time);
+    transaction.staged[part].allowOverCapacity = overCapacity;
+
+    TransactionResult result = commitTransaction(data, transaction);
+    if (!result.committed) {
+        error = result.conflicts.empty() ? "Booking could not be created" : result.conflicts.front().reason;
+        return false;
+    }
+
+    const EventBooking& booking = data.bookings.back();
+    out.key("booking");
+    writeBooking(out, booking);
+    return true;
+}
+
+static bool opPay(SystemData& data, ProtocolSession& session, const JsonValue& request, JsonWriter& out, string& error) {
+    string bookingID = request.getString("bookingID");
+    const string me = normalizeUserID(session.user);
+    const EventBooking* booking = nullptr;
+    for (const auto& candidate : data.bookings) {
+        if (candidate.bookingID == bookingID && ownedBy(candidate.eventReg, me)) {
+            booking = &candidate;
+            break;
+        }
+    }
+    if (booking == nullptr) {
+        error = "No booking " + bookingID + " under your account";
+        return false;
+    }
+    if (booking->bookingStatus != "Pending") {
+        error = "Booking " + bookingID + " is " + booking->bookingStatus + ", only Pending bookings can be paid";
+        return false;
+    }
+
+    static const vector<string> METHODS = { "Credit Card", "Debit Card", "Bank Transfer", "Cash" };
+    string method = toUpperCase(request.getString("method"));
+    Payment payment;
+    for (const auto& name : METHODS) {
+        if (toUpperCase(name) == method) {
+            payment.paymentMethod = name;
+        }
+    }
+    if (payment.paymentMethod.empty()) {
+        error = "method must be Credit Card, Debit Card, Bank Transfer or Cash";
+        return false;
+    }
+
+    if (payment.paymentMethod == "Credit Card" || payment.paymentMethod == "Debit Card") {
+        string card = withoutSpaces(request.getString("card"));
+        if (!allDigits(card, 16)) {
+            error = "card must be 16 digits";
+            return false;
+        }
+        payment.cardNumber = card.substr(12, 4); // last 4 digits only
+        payment.cardHolderName = request.getString("holder");
+        if (payment.cardHolderName.size() < 2) {
+            error = "holder is required for card payments";
+            return false;
+        }
+
+        static const regex expiryPattern(R"(^(0[1-9]|1[0-2])\/([0-9]{2})$)");
+        string expiry = request.getString("expiry");
+        if (!regex_match(expiry, expiryPattern)) {
+            error = "expiry must be MM/YY";
+            return false;
+        }
+        int month = stoi(expiry.substr(0, 2));
+        int year = stoi(expiry.substr(3, 2));
+        Date today = getCurrentDate();
+        if (year < today.year % 100 || (year == today.year % 100 && month < today.month)) {
+            error = "Card expired";
+            return false;
+        }
+        if (!allDigits(withoutSpaces(request.getString("cvv")), 3)) {
+            error = "cvv must be 3 digits";
+            return false;
+        }
+    }
+
+    payment.amount = booking->finalCost;
+    string promo = request.getString("promo");
+    bool promoApplied = !promo.empty() && applyPromoCode(promo, payment.amount);
+
+    payment.paymentID = generatePaymentID(data.payments);
+    payment.bookingID = booking->bookingID;
+    payment.paymentDate = getCurrentDate();
+    payment.paymentStatus = "Completed";
+    if (!confirmPayment(data, payment)) {
+        error = "Booking " + bookingID + " has already been paid";
+        return false;
+    }
+
+    out.field("paymentID", payment.paymentID)
+        .field("bookingID", payment.bookingID)
+        .field("amount", payment.amount)
+        .field("method", payment.paymentMethod)
+        .field("transactionReference", payment.transactionReference)
+        .field("promoApplied", promoApplied);
+    return true;
+}
+
+static bool opRefund(SystemData& data, ProtocolSession& session, const JsonValue& request, JsonWriter& out, string& error) {
+    string paymentID = request.getString("paymentID");
+    const string me = normalizeUserID(session.user);
+    const Payment* payment = nullptr;
+    for (const auto& candidate : data.payments) {
+        if (candidate.paymentID == paymentID) {
+            payment = &candidate;
+            break;
+        }
+    }
+    const EventBooking* booking = nullptr;
+    if (payment != nullptr) {
+        for (const auto& candidate : data.bookings) {
+            if (candidate.bookingID == payment->bookingID) {
+                booking = &candidate;
+                break;
+            }
+        }
+    }
+    if (payment == nullptr || booking == nullptr || !ownedBy(booking->eventReg, me)) {
+        error = "No payment " + paymentID + " under your account";
+        return false;
+    }
+    // Same rule as the refund screen
+    if (payment->paymentStatus != "Completed" || booking->bookingStatus != "Cancelled") {
+        error = "Only completed payments for cancelled bookings can be refunded";
+        return false;
+    }
+
+    Money amount = payment->amount;
+    refundPayment(data, paymentID);
+    out.field("paymentID", paymentID).field("amount", amount).field("status", "Refunded");
+    return true;
+}
+
+static bool opSearch(SystemData& data, ProtocolSession& session, const JsonValue& request, JsonWriter& out, string& error) {
+    string query = request.getString("query");
+    if (query.empty()) {
+        error = "query is required";
+        return false;
+    }
+    long long limit = request.getInteger("limit", 20);
+    string scope = request.getString("scope", "events");
+
+    if (scope == "feedback") {
+        vector<SearchHit> hits = searchFeedback(data.feedbackSearch, query, static_cast<size_t>(max(limit, 0LL)));
+        out.key("feedback").beginArray();
+        for (const auto& hit : hits) {
+            out.beginObject()
+                .field("feedbackID", hit.feedbackID)
+                .field("score", hit.score)
+                .field("matchedIn", fieldNames(hit.fields))
+                .endObject();
+        }
+        out.endArray();
+        return true;
+    }
+    if (scope != "events") {
+        error = "scope must be events or feedback";
+        return false;
+    }
+
+    // Same matching as the Search My Events screen
+    string term = toUpperCase(query);
+    const string me = normalizeUserID(session.user);
+    auto matches = [&](const EventRegistration& reg) {
+        return containsUpper(reg.eventTitle, term) ||
+            containsUpper(reg.manufacturer, term) ||
+            containsUpper(reg.organizer.organizerName, term);
+    };
+
+    long long count = 0;
+    out.key("registrations").beginArray();
+    for (const auto& reg : data.registrations) {
+        if (count < limit && ownedBy(reg, me) &&
+            (matches(reg) || containsUpper(reg.eventStatus, term))) {
+            out.beginObject()
+                .field("eventID", reg.eventID)
+                .field("eventTitle", reg.eventTitle)
+                .field("manufacturer", reg.manufacturer)
+                .field("status", reg.eventStatus)
+                .endObject();
+            count++;
+        }
+    }
+    out.endArray();
+
+    count = 0;
+    out.key("bookings").beginArray();
+    for (const auto& booking : data.bookings) {
+        if (count < limit && ownedBy(booking.eventReg, me) && matches(booking.eventReg)) {
+            writeBooking(out, booking);
+            count++;
+        }
+    }
+    out.endArray();
+    return true;
+}
+
+static bool opFinancialReport(SystemData& data, ProtocolSession& session, const JsonValue& request, JsonWriter& out, string& error) {
+    static const vector<pair<string, RevenueDimension>> DIMENSIONS = {
+        { "month", RevenueDimension::Month },
+        { "week", RevenueDimension::Week },
+        { "venue", RevenueDimension::Venue },
+        { "manufacturer", RevenueDimension::Manufacturer },
+        { "method", RevenueDimension::PaymentMethod },
+        { "status", RevenueDimension::Status },
+    };
+    string by = request.getString("by", "status");
+    auto dimension = find_if(DIMENSIONS.begin(), DIMENSIONS.end(),
+        [&](const auto& entry) { return entry.first == by; });
+    if (dimension == DIMENSIONS.end()) {
+        error = "by must be month, week, venue, manufacturer, method or status";
+        return false;
+    }
+
+    RevenueFilter filter;
+    filter.organizerID = normalizeUserID(session.user);
+    filter.month = request.getString("month");
+    filter.venueID = request.getString("venueID");
+
+    auto writeRows = [&](const map<string, RevenueCell>& rows) {
+        out.beginArray();
+        for (const auto& [label, cell] : rows) {
+            out.beginObject().field("key", label).field("total", cell.total).field("count", cell.count).endObject();
+        }
+        out.endArray();
+    };
+
+    out.field("by", by);
+    out.key("bookings");
+    writeRows(rollupBookingRevenue(data.revenue, dimension->second, filter));
+    out.key("payments");
+    writeRows(rollupPaymentRevenue(data.revenue, dimension->second, filter));
+    return true;
+}
+
+static bool opSave(SystemData&, ProtocolSession&, const JsonValue&, JsonWriter& out, string&) {
+    out.field("filesWritten", flushDeferredSaves());
+    return true;
+}
+
+// Snapshot and change feed metrics of the whole process; touches no collection
+// Fields of one TaskTiming, averages rather than totals
+static void appendTiming(JsonWriter& out, const TaskTiming& timing) {
+    double runs = static_cast<double>(max(timing.count, 1LL));
+    out.field("runs", timing.count)
+        .field("avgWaitMs", timing.totalWaitMs / runs)
+        .field("maxWaitMs", timing.maxWaitMs)
+        .field("avgRunMs", timing.totalRunMs / runs)
+        .field("maxRunMs", timing.maxRunMs);
+}
+
+static bool opStats(SystemData& data, ProtocolSession&, const JsonValue&, JsonWriter& out, string&) {
+    SnapshotMetrics metrics = snapshotMetrics(data);
+    out.key("snapshots").beginObject()
+        .field("pinned", metrics.pinned)
+        .field("oldestAgeSeconds", metrics.oldestAgeSeconds)
+        .field("cachedBytes", metrics.cachedBytes)
+        .field("retainedBytes", metrics.retainedBytes)
+        .field("taken", metrics.taken)
+        .field("partsReused", metrics.partsReused)
+        .field("partsCopied", metrics.partsCopied)
+        .field("partsReclaimed", metrics.partsReclaimed)
+        .endObject();
+
+    out.key("changes").beginObject().field("published", static_cast<long long>(data.changes.published()));
+    out.key("subscribers").beginArray();
+    for (const auto& subscriber : data.changes.subscriberStats()) {
+        out.beginObject()
+            .field("name", subscriber.name)
+            .field("delivered", static_cast<long long>(subscriber.delivered))
+            .field("dropped", static_cast<long long>(subscriber.dropped))
+            .field("waits", static_cast<long long>(subscriber.waits))
+            .field("backlog", subscriber.backlog)
+            .field("capacity", subscriber.capacity)
+            .endObject();
+    }
+    out.endArray().endObject();
+
+    PoolStats pool = backgroundPool().stats();
+    out.key("pool").beginObject()
+        .field("threads", pool.threads)
+        .field("stolen", pool.stolen)
+        .field("ranInline", pool.ranInline);
+    out.key("priorities").beginObject();
+    for (int p = 0; p < TASK_PRIORITIES; p++) {
+        const PriorityStats& priority = pool.priorities[p];
+        out.key(taskPriorityName(static_cast<TaskPriority>(p))).beginObject()
+            .field("submitted", priority.submitted)
+            .field("queued", priority.queued)
+            .field("maxQueued", priority.maxQueued);
+        appendTiming(out, priority.timing);
+        out.endObject();
+    }
+    out.endObject();
+    out.key("tasks").beginObject();
+    for (const auto& [name, timing] : pool.byName) {
+        out.key(name).beginObject();
+        appendTiming(out, timing);
+        out.endObject();
+    }
+    out.endObject().endObject();
+    return true;
+}
+
+static const vector<JsonOperation>& jsonOperations() {
+    static const vector<JsonOperation> operations = {
+        { "ping", false, opPing, 0, 0, ShardAccess::None, ShardAccess::None },
+        { "login", false, opLogin, 0, USERS_DATA, ShardAccess::None, ShardAccess::None },
+        { "logout", true, opLogout, 0, 0, ShardAccess::None, ShardAccess::None },
+        { "bookings", true, opBookings, BOOKINGS_DATA, 0, ShardAccess::Read, ShardAccess::None },
+        { "createBooking", true, opCreateBooking, REGISTRATIONS_DATA | VENUES_DATA,
+            BOOKINGS_DATA | SCHEDULE_DATA | REVENUE_DATA, ShardAccess::Write, ShardAccess::Write },
+        { "pay", true, opPay, BOOKINGS_DATA, PAYMENTS_DATA | SCHEDULE_DATA | REVENUE_DATA, ShardAccess::Write, ShardAccess::None },
+        { "refund", true, opRefund, BOOKINGS_DATA, PAYMENTS_DATA | REVENUE_DATA, ShardAccess::Read, ShardAccess::None },
+        { "search", true, opSearch, REGISTRATIONS_DATA | BOOKINGS_DATA | FEEDBACK_DATA, 0, ShardAccess::Read, ShardAccess::None },
+        { "financialReport", true, opFinancialReport, REVENUE_DATA, 0, ShardAccess::None, ShardAccess::None },
+        { "save", false, opSave, ALL_DATA, 0, ShardAccess::All, ShardAccess::None },
+        { "stats", false, opStats, 0, 0, ShardAccess::None, ShardAccess::None },
+    };
+    return operations;
+}
+
+static LockPlan lockPlan(const JsonOperation& operation, const ProtocolSession& session, const JsonValue& request) {
+    LockPlan plan;
+    plan.reads(operation.reads).writes(operation.writes);
+    switch (operation.organizer) {
+    case ShardAccess::None: break;
+    case ShardAccess::Read: plan.readsOrganizer(session.user); break;
+    case ShardAccess::Write: plan.writesOrganizer(session.user); break;
+    case ShardAccess::All: plan.readsAllPartitions(); break;
+    }
+    switch (operation.venue) {
+    case ShardAccess::None: break;
+    case ShardAccess::Read: plan.readsVenue(request.getString("venueID")); break;
+    case ShardAccess::Write: plan.writesVenue(request.getString("venueID")); break;
+    case ShardAccess::All: plan.readsAllPartitions(); break;
+    }
+    return plan;
+}
+
+bool handleJsonRequest(SystemData& data, ProtocolSession& session, string_view request, string& response) {
+    JsonWriter out(response);
+    out.beginObject();
+
+    JsonValue parsed;
+    string error;
+    if (!parseJson(request, parsed, error) || parsed.type != JsonValue::Type::Object) {
+        out.field("id", JsonValue()).field("ok", false)
+            .field("error", error.empty() ? "request must be a JSON object" : "malformed request: " + error)
+            .endObject();
+        return false;
+    }
+
+    const JsonValue* id = parsed.find("id");
+    out.field("id", id != nullptr ? *id : JsonValue());
+    JsonWriter::Mark resultStart = out.mark();
+
+    string name = parsed.getString("op");
+    const JsonOperation* operation = nullptr;
+    for (const auto& candidate : jsonOperations()) {
+        if (name == candidate.name) {
+            operation = &candidate;
+            break;
+        }
+    }
+
+    bool ok = false;
+    if (operation == nullptr) {
+        error = "unknown op \"" + name + "\"";
+    }
+    else if (operation->needsLogin && session.user.empty()) {
+        error = "login required";
+    }
+    else {
+        out.field("ok", true);
+        try {
+            DataLockSet locks(data.locks, lockPlan(*operation, session, parsed));
+            ok = operation->handler(data, session, parsed, out, error);
+        }
+        catch (const exception& e) {
+            // e.g. a prompt reached in headless mode, or Money overflow
+            error = e.what();
+        }
+    }
+
+    if (!ok) {
+        // Drop any partial result; the writer is back where it was after the id
+        out.rewind(resultStart);
+        out.field("ok", false).field("error", error);
+    }
+    out.endObject();
+    return ok;
+}
+
+int runJsonProtocol(SystemData& data, istream& in, ostream& out) {
+    ProtocolSession session;
+    string line;
+    string response;
+    int failures = 0;
+
+    // Nothing should prompt, but if something does it must fail, not read the protocol stream
+    setHeadless(true);
+    setSavesDeferred(true);
+
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.find_first_not_of(" \t") == string::npos) {
+            continue;
+        }
+
+        // Alone on the data here, so the sweeps can run before every request
+        if (!session.user.empty()) {
+            runHousekeeping(data);
+        }
+        response.clear();
+        if (!handleJsonRequest(data, session, line, response)) {
+            failures++;
+        }
+        response += '\n';
+        out.write(response.data(), static_cast<streamsize>(response.size()));
+
+        // Input has run dry: the client is waiting on us, so settle the
+        // batch now rather than after its next request
+        if (in.rdbuf()->in_avail() <= 0) {
+            out.flush();
+            flushDeferredSaves();
+        }
+    }
+
+    setSavesDeferred(false);
+    out.flush();
+    setHeadless(false);
+    return failures;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef JSON_PROTOCOL_H
+#define JSON_PROTOCOL_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+using namespace std;
+
+// Forward declarations
+class SystemData;
+
+// Per-client state: who this client logged in as
+struct ProtocolSession {
+    string user;
+};
+
+// Machine interface. Every request is one JSON object on one line:
+//   {"id":1,"op":"login","user":"USER1001","password":"Secret123"}
+//   {"id":2,"op":"bookings","status":"Pending"}
+//   {"id":3,"op":"createBooking","eventID":"EVT001","date":"2026-12-05","slot":1,"venueID":"V001"}
+//   {"id":4,"op":"pay","bookingID":"BKG0007","method":"Credit Card","card":"4111111111111111",
+//    "holder":"Alice Tan","expiry":"12/28","cvv":"123","promo":"PROMO10"}
+//   {"id":5,"op":"refund","paymentID":"PAY0003"}
+//   {"id":6,"op":"search","query":"projector","scope":"feedback"}
+//   {"id":7,"op":"financialReport","by":"month"}
+//   {"id":8,"op":"save"}
+//   {"id":9,"op":"stats"}          (snapshot memory, change subscribers' backlog and drops, pool queues and timings)
+// and is answered by exactly one line echoing the id:
+//   {"id":2,"ok":true,"count":1,"bookings":[...]}
+//   {"id":3,"ok":false,"error":"..."}
+// Money is sent as a decimal string so no precision is lost.
+
+// Answers one request, appending the response object (no newline) to
+// response. The session supplies the logged-in user. Takes the locks the
+// operation declares in data.locks, so several threads may answer
+// different sessions at once. Housekeeping is left to the caller.
+// Returns false when the request failed.
+bool handleJsonRequest(SystemData& data, ProtocolSession& session, string_view request, string& response);
+
+// Serves requests from in until end of input, writing one response line
+// per request to out. File saves are coalesced and written whenever the
+// input runs dry, so a pipelined burst costs one write per file. Anything
+// the underlying code prints to cout should be redirected by the caller.
+// Returns how many requests failed.
+int runJsonProtocol(SystemData& data, istream& in, ostream& out);
+
+#endif
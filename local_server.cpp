@@ -0,0 +1,765 @@
+#include "local_server.h"
+#include <iostream>
+
+#ifdef __linux__
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "system_data.h"
+#include "console_input.h"
+#include "file_operation.h"
+#include "booking_lifecycle.h"
+#include "json_protocol.h"
+#include "worker_pool.h"
+#include "data_locks.h"
+#include "change_feed.h"
+
+using namespace std;
+
+namespace {
+
+// The data itself is guarded by data.locks. Menu sessions render through
+// the one cout, though, so they take turns on this, and so does anything
+// else that prints while serving (flushes, housekeeping); one session's
+// setw/fixed never bleeds into another's output. Taken before any data lock.
+mutex consoleLock;
+
+// Writes the coalesced saves. Caller holds consoleLock and no data locks.
+void settleSaves(SystemData& data) {
+    DataLockSet reading(data.locks, LockPlan().reads(ALL_DATA).readsAllPartitions());
+    flushDeferredSaves();
+}
+
+// ---- Output routing ----
+
+// Where the current thread's cout output goes; null means the server console
+thread_local streambuf* threadOutput = nullptr;
+
+// Installed as cout's buffer while serving. It never reports a failure:
+// cout is shared, and one dropped client must not set badbit for all.
+class RoutedOutput : public streambuf {
+public:
+    explicit RoutedOutput(streambuf* console) : console(console) {}
+
+protected:
+    int overflow(int c) override {
+        if (c != EOF) {
+            target()->sputc(static_cast<char>(c));
+        }
+        return traits_type::not_eof(c);
+    }
+    streamsize xsputn(const char* text, streamsize count) override {
+        target()->sputn(text, count);
+        return count;
+    }
+    int sync() override {
+        target()->pubsync();
+        return 0;
+    }
+
+private:
+    streambuf* console;
+
+    streambuf* target() const { return threadOutput != nullptr ? threadOutput : console; }
+};
+
+// For workers: what the protocol handlers print is not part of any response
+class DiscardOutput : public streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    streamsize xsputn(const char*, streamsize count) override { return count; }
+};
+
+DiscardOutput discardOutput;
+
+// Buffered writes to a menu client. A client that has gone away is
+// noticed on the next read; until then its output is dropped.
+class SocketOutput : public streambuf {
+public:
+    explicit SocketOutput(int fd) : fd(fd) { setp(buffer, buffer + sizeof(buffer)); }
+
+protected:
+    int overflow(int c) override {
+        sendBuffered();
+        if (c != EOF) {
+            *pptr() = static_cast<char>(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+    int sync() override {
+        sendBuffered();
+        return 0;
+    }
+
+private:
+    int fd;
+    bool failed = false;
+    char buffer[4096];
+
+    void sendBuffered() {
+        const char* cursor = pbase();
+        while (!failed && cursor < pptr()) {
+            ssize_t sent = send(fd, cursor, pptr() - cursor, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent <= 0) {
+                failed = true;
+                break;
+            }
+            cursor += sent;
+        }
+        setp(buffer, buffer + sizeof(buffer));
+    }
+};
+
+// ---- Menu sessions ----
+
+// Unwinds a menu session whose client disconnected
+struct SessionClosed {};
+
+struct MenuThread {
+    int fd;
+    thread worker;
+    atomic<bool> finished{ false };
+};
+
+class RemoteMenu {
+public:
+    RemoteMenu(SystemData& data, int fd, string pending)
+        : data(data), fd(fd), inbox(move(pending)), output(fd), locks(data.locks) {}
+
+    // The menus may change anything, so a session holds every collection
+    // exclusively while it runs, except inside a ReadOnlySection
+    void run(MenuSession menu) {
+        threadOutput = &output;
+        holdCompaction();
+        console = unique_lock<mutex>(consoleLock);
+        locks.lock(LockPlan().writes(ALL_DATA));
+        setSessionLocks(&locks);
+        data.currentUser.clear();
+        setThreadInputSource([this](string& line) { return nextLine(line); });
+
+        try {
+            menu(data);
+        }
+        catch (const SessionClosed&) {
+            // client went away; whatever was in progress is abandoned
+        }
+        catch (const exception& e) {
+            cerr << "[server] menu session ended by error: " << e.what() << endl;
+        }
+
+        setThreadInputSource(nullptr);
+        setSessionLocks(nullptr);
+        data.currentUser.clear();
+        locks.unlock();
+        settleSaves(data);
+        output.pubsync();
+        console.unlock();
+        threadOutput = nullptr;
+        releaseCompaction();
+    }
+
+private:
+    SystemData& data;
+    int fd;
+    string inbox;
+    SocketOutput output;
+    unique_lock<mutex> console;
+    DataLockSet locks;
+    string user;
+
+    // Every prompt parks here: the action's saves are written and the data
+    // is free for other sessions until the answer arrives. The session
+    // comes back with the same locks it parked with.
+    bool nextLine(string& line) {
+        user = data.currentUser;
+        locks.unlock();
+        settleSaves(data);
+        output.pubsync();
+        console.unlock();
+
+        bool received = receiveLine(line);
+
+        console.lock();
+        locks.relock();
+        data.currentUser = user;
+        if (!received) {
+            throw SessionClosed();
+        }
+        return true;
+    }
+
+    bool receiveLine(string& line) {
+        while (true) {
+            size_t end = inbox.find('\n');
+            if (end != string::npos) {
+                line.assign(inbox, 0, end);
+                inbox.erase(0, end + 1);
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                return true;
+            }
+            char chunk[1024];
+            ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received <= 0) {
+                return false;
+            }
+            inbox.append(chunk, received);
+        }
+    }
+};
+
+// ---- JSON clients ----
+
+struct Connection {
+    int fd;
+    string inbox;               // partial line; epoll thread only
+    bool modeKnown = false;     // first line seen (MENU or not)
+
+    mutex lock;                 // guards everything below
+    ProtocolSession session;
+    deque<string> requests;     // whole lines waiting for a worker
+    string outbox;              // responses not yet accepted by the socket
+    bool busy = false;          // a worker is answering this client
+    bool wantWrite = false;     // EPOLLOUT armed
+    bool inputEnded = false;    // client shut its side; answer, then hang up
+    bool closed = false;
+    ChangeSubscription* changes = nullptr;  // set for a change stream; epoll thread only
+
+    explicit Connection(int fd) : fd(fd) {}
+    ~Connection() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+int signalPipe[2] = { -1, -1 };
+
+void onStopSignal(int) {
+    char byte = 1;
+    ssize_t ignored = write(signalPipe[1], &byte, 1);
+    (void)ignored;
+}
+
+class LocalServer {
+public:
+    LocalServer(SystemData& data, MenuSession menu) : data(data), menu(menu) {}
+
+    bool listenOn(const string& path);
+    void serve();
+    void shutdown();
+
+private:
+    SystemData& data;
+    MenuSession menu;
+    string socketPath;
+    int listenFd = -1;
+    int epollFd = -1;
+    int changesReady = -1;      // eventfd poked when a change stream's ring gets an event
+    unordered_map<int, shared_ptr<Connection>> connections;
+    vector<unique_ptr<MenuThread>> menuThreads;
+    atomic<int> answering{ 0 };     // answerRequests calls queued or running on the pool
+
+    void acceptClients();
+    void readClient(const shared_ptr<Connection>& connection);
+    void dropClient(const shared_ptr<Connection>& connection);
+    void startMenu(const shared_ptr<Connection>& connection);
+    void startChangeStream(const shared_ptr<Connection>& connection);
+    void pumpChanges(Connection& connection);
+    void answerRequests(const shared_ptr<Connection>& connection);
+    void sendPending(Connection& connection);
+    void watch(Connection& connection);
+    void reapMenuThreads();
+};
+
+bool LocalServer::listenOn(const string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        cerr << "Error: socket path is too long: " << path << endl;
+        return false;
+    }
+    strcpy(address.sun_path, path.c_str());
+
+    // A socket file nobody answers on is left over from a crash; a live one
+    // means another server already owns the data
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+        close(probe);
+        cerr << "Error: a server is already running on " << path << endl;
+        return false;
+    }
+    close(probe);
+    unlink(path.c_str());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0 ||
+        bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0) {
+        cerr << "Error: cannot listen on " << path << ": " << strerror(errno) << endl;
+        return false;
+    }
+    socketPath = path;
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (pipe2(signalPipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.fd = signalPipe[0];
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, signalPipe[0], &event);
+    changesReady = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    event.data.fd = changesReady;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, changesReady, &event);
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, onStopSignal);
+    signal(SIGTERM, onStopSignal);
+    return true;
+}
+
+void LocalServer::serve() {
+    const int MAX_EVENTS = 64;
+    const auto HOUSEKEEPING_INTERVAL = chrono::seconds(1);
+    epoll_event events[MAX_EVENTS];
+    auto lastHousekeeping = chrono::steady_clock::now();
+
+    while (true) {
+        // Payment holds and past events are swept on a timer rather than
+        // before every request, since it needs everything exclusively
+        if (chrono::steady_clock::now() - lastHousekeeping >= HOUSEKEEPING_INTERVAL) {
+            lock_guard<mutex> console(consoleLock);
+            DataLockSet everything(data.locks, LockPlan().writes(ALL_DATA));
+            runHousekeeping(data);
+            lastHousekeeping = chrono::steady_clock::now();
+        }
+
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, 1000);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (ready == 0) {
+            // Quiet second: top up any change stream a wake-up was missed for
+            for (auto& entry : connections) {
+                if (entry.second->changes != nullptr) {
+                    pumpChanges(*entry.second);
+                }
+            }
+        }
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == signalPipe[0]) {
+                return;
+            }
+            if (fd == changesReady) {
+                uint64_t pokes;
+                ssize_t ignored = read(changesReady, &pokes, sizeof(pokes));
+                (void)ignored;
+                for (auto& entry : connections) {
+                    if (entry.second->changes != nullptr) {
+                        pumpChanges(*entry.second);
+                    }
+                }
+                continue;
+            }
+            if (fd == listenFd) {
+                acceptClients();
+                continue;
+            }
+            auto found = connections.find(fd);
+            if (found == connections.end()) {
+                continue;
+            }
+            shared_ptr<Connection> connection = found->second;
+            if (events[i].events & EPOLLOUT) {
+                if (connection->changes != nullptr) {
+                    pumpChanges(*connection);
+                }
+                else {
+                    lock_guard<mutex> guard(connection->lock);
+                    sendPending(*connection);
+                }
+            }
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                readClient(connection);
+            }
+        }
+    }
+}
+
+void LocalServer::acceptClients() {
+    reapMenuThreads();
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        connections[fd] = make_shared<Connection>(fd);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+void LocalServer::readClient(const shared_ptr<Connection>& connection) {
+    bool peerClosed = false;
+    char chunk[16384];
+    while (true) {
+        ssize_t received = recv(connection->fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            connection->inbox.append(chunk, received);
+            continue;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        peerClosed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+        break;
+    }
+
+    if (!connection->modeKnown) {
+        size_t end = connection->inbox.find('\n');
+        if (end == string::npos) {
+            if (peerClosed) {
+                dropClient(connection);
+            }
+            return;
+        }
+        connection->modeKnown = true;
+        string first = connection->inbox.substr(0, end);
+        if (!first.empty() && first.back() == '\r') {
+            first.pop_back();
+        }
+        if (first == "MENU") {
+            connection->inbox.erase(0, end + 1);
+            startMenu(connection);
+            return;
+        }
+        if (first == "CHANGES") {
+            startChangeStream(connection);
+        }
+    }
+
+    // A change stream only sends; anything it says is ignored
+    if (connection->changes != nullptr) {
+        connection->inbox.clear();
+        if (peerClosed) {
+            dropClient(connection);
+        }
+        return;
+    }
+
+    // Hand every complete line to the client's queue
+    bool submit = false;
+    {
+        lock_guard<mutex> guard(connection->lock);
+        size_t start = 0;
+        size_t end;
+        while ((end = connection->inbox.find('\n', start)) != string::npos) {
+            connection->requests.emplace_back(connection->inbox, start, end - start);
+            start = end + 1;
+        }
+        connection->inbox.erase(0, start);
+        if (!connection->requests.empty() && !connection->busy) {
+            connection->busy = true;
+            submit = true;
+        }
+    }
+    if (submit) {
+        answering.fetch_add(1);
+        backgroundPool().submit(TaskPriority::Interactive, "json requests", [this, connection] {
+            answerRequests(connection);
+            if (answering.fetch_sub(1) == 1) {
+                answering.notify_all();
+            }
+            });
+    }
+    if (peerClosed) {
+        unique_lock<mutex> guard(connection->lock);
+        if (connection->busy || !connection->outbox.empty()) {
+            // Still answering: stop watching for input, finish the replies first
+            connection->inputEnded = true;
+            watch(*connection);
+            return;
+        }
+        guard.unlock();
+        dropClient(connection);
+    }
+}
+
+void LocalServer::dropClient(const shared_ptr<Connection>& connection) {
+    {
+        lock_guard<mutex> guard(connection->lock);
+        connection->closed = true;
+    }
+    data.changes.unsubscribe(connection->changes);
+    connection->changes = nullptr;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, nullptr);
+    connections.erase(connection->fd);   // a busy worker keeps it alive until done
+}
+
+void LocalServer::startMenu(const shared_ptr<Connection>& connection) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, nullptr);
+    connections.erase(connection->fd);
+
+    // The session thread owns the socket from here, with blocking reads
+    int fd = connection->fd;
+    connection->fd = -1;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    timeval sendTimeout{ 10, 0 };       // a client that stops reading can't stall the server
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &sendTimeout, sizeof(sendTimeout));
+
+    auto session = make_unique<MenuThread>();
+    session->fd = fd;
+    MenuThread* state = session.get();
+    string pending = move(connection->inbox);
+    session->worker = thread([this, state, fd, pending = move(pending)]() mutable {
+        RemoteMenu remote(data, fd, move(pending));
+        remote.run(menu);
+        ::shutdown(fd, SHUT_RDWR);      // the client sees the end now; the fd is closed when reaped
+        state->finished = true;
+    });
+    menuThreads.push_back(move(session));
+}
+
+// From here on the client only receives: one JSON line per change (see
+// change_feed.h). A client that reads too slowly loses events rather than
+// slowing the writers; the loss shows in the stats op's drop counters.
+void LocalServer::startChangeStream(const shared_ptr<Connection>& connection) {
+    int wake = changesReady;
+    connection->changes = data.changes.subscribe("socket " + to_string(connection->fd), 4096, OverflowPolicy::Drop,
+        [wake] {
+            uint64_t one = 1;
+            ssize_t ignored = write(wake, &one, sizeof(one));
+            (void)ignored;
+        });
+    if (connection->changes == nullptr) {
+        lock_guard<mutex> guard(connection->lock);
+        connection->outbox = "{\"ok\":false,\"error\":\"too many change subscribers\"}\n";
+        connection->inputEnded = true;
+        sendPending(*connection);
+    }
+}
+
+// Moves queued changes into the outbox, a bounded batch at a time: while
+// the socket is full the events stay in the ring, where overflow is counted
+void LocalServer::pumpChanges(Connection& connection) {
+    const size_t MAX_OUTBOX = 65536;
+    lock_guard<mutex> guard(connection.lock);
+    ChangeEvent event;
+    while (!connection.closed) {
+        while (connection.outbox.size() < MAX_OUTBOX && connection.changes->tryPop(event)) {
+            appendChangeJson(connection.outbox, event);
+            connection.outbox += '\n';
+        }
+        if (connection.outbox.empty()) {
+            return;
+        }
+        sendPending(connection);
+        if (connection.wantWrite || !connection.outbox.empty()) {
+            return;     // EPOLLOUT brings us back
+        }
+    }
+}
+
+void LocalServer::reapMenuThreads() {
+    for (auto it = menuThreads.begin(); it != menuThreads.end();) {
+        if ((*it)->finished) {
+            (*it)->worker.join();
+            close((*it)->fd);
+            it = menuThreads.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+// Runs on a pool worker. Answers the client's queued lines in order until
+// the queue is empty; at most one worker serves a client at a time.
+void LocalServer::answerRequests(const shared_ptr<Connection>& connection) {
+    threadOutput = &discardOutput;
+    string response;
+    while (true) {
+        string request;
+        {
+            lock_guard<mutex> guard(connection->lock);
+            if (connection->requests.empty() || connection->closed) {
+                connection->busy = false;
+                connection->requests.clear();
+                if (connection->inputEnded && connection->outbox.empty()) {
+                    ::shutdown(connection->fd, SHUT_RDWR);  // the epoll loop sees the hangup and drops it
+                }
+                threadOutput = nullptr;     // the worker goes on to other pool work
+                return;
+            }
+            request = move(connection->requests.front());
+            connection->requests.pop_front();
+        }
+        if (!request.empty() && request.back() == '\r') {
+            request.pop_back();
+        }
+        if (request.find_first_not_of(" \t") == string::npos) {
+            continue;
+        }
+
+        response.clear();
+        handleJsonRequest(data, connection->session, request, response);
+        bool drained;
+        {
+            lock_guard<mutex> guard(connection->lock);
+            drained = connection->requests.empty();
+        }
+        // The client is waiting on us: settle the batch's saves
+        if (drained) {
+            lock_guard<mutex> console(consoleLock);
+            settleSaves(data);
+        }
+        response += '\n';
+
+        lock_guard<mutex> guard(connection->lock);
+        connection->outbox += response;
+        if (drained || connection->outbox.size() > 65536) {
+            sendPending(*connection);
+        }
+    }
+}
+
+// Caller holds connection.lock
+void LocalServer::sendPending(Connection& connection) {
+    while (!connection.closed && !connection.outbox.empty()) {
+        ssize_t sent = send(connection.fd, connection.outbox.data(), connection.outbox.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent > 0) {
+            connection.outbox.erase(0, sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // Socket full: let the epoll loop finish the job
+            if (!connection.wantWrite) {
+                connection.wantWrite = true;
+                watch(connection);
+            }
+            return;
+        }
+        connection.outbox.clear();      // broken; the read side will drop it
+        break;
+    }
+    if (connection.wantWrite && !connection.closed) {
+        connection.wantWrite = false;
+        watch(connection);
+    }
+    if (connection.inputEnded && !connection.busy && connection.outbox.empty()) {
+        ::shutdown(connection.fd, SHUT_RDWR);
+    }
+}
+
+// Caller holds connection.lock. Input stops being watched once it has
+// ended, since a closed socket would report readable forever.
+void LocalServer::watch(Connection& connection) {
+    epoll_event event{};
+    event.events = (connection.inputEnded ? 0u : static_cast<uint32_t>(EPOLLIN)) | (connection.wantWrite ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    event.data.fd = connection.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+}
+
+void LocalServer::shutdown() {
+    // Wake menu sessions parked at a prompt; they unwind as disconnected
+    for (auto& session : menuThreads) {
+        ::shutdown(session->fd, SHUT_RDWR);
+    }
+    for (auto& session : menuThreads) {
+        session->worker.join();
+        close(session->fd);
+    }
+    menuThreads.clear();
+    for (auto& entry : connections) {
+        {
+            lock_guard<mutex> guard(entry.second->lock);
+            entry.second->closed = true;
+        }
+        data.changes.unsubscribe(entry.second->changes);
+        entry.second->changes = nullptr;
+    }
+    connections.clear();
+    // Requests already being answered stop at the next line; wait them out
+    for (int left = answering.load(); left != 0; left = answering.load()) {
+        answering.wait(left);
+    }
+
+    close(listenFd);
+    close(changesReady);
+    close(epollFd);
+    close(signalPipe[0]);
+    close(signalPipe[1]);
+    unlink(socketPath.c_str());
+}
+
+}
+
+bool runLocalServer(SystemData& data, const string& socketPath, MenuSession menu) {
+    streambuf* console = cout.rdbuf();
+    RoutedOutput routed(console);
+    {
+        LocalServer server(data, menu);
+        if (!server.listenOn(socketPath)) {
+            return false;
+        }
+        cout << "Serving on " << socketPath << " with " << backgroundPool().size()
+            << " worker(s). Press Ctrl+C to stop." << endl;
+        cout.rdbuf(&routed);
+        setSavesDeferred(true);
+        // Every change from here on goes through a DataLockSet, so
+        // snapshots can tell which parts are still current
+        data.locks.tracksWrites = true;
+
+        server.serve();
+        server.shutdown();
+    }
+    data.locks.tracksWrites = false;
+    cout.rdbuf(console);
+    setSavesDeferred(false);    // writes whatever is still pending
+    cout << "Server stopped." << endl;
+    return true;
+}
+
+#else
+
+bool runLocalServer(SystemData&, const string&, MenuSession) {
+    cout << "Error: server mode needs Unix domain sockets and epoll (Linux only)." << endl;
+    return false;
+}
+
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+#ifndef LOCAL_SERVER_H
+#define LOCAL_SERVER_H
+
+#include <string>
+using namespace std;
+
+// Forward declarations
+class SystemData;
+
+// What a remote menu session runs: the same sign up / log in loop as the
+// console. Returning ends the session.
+using MenuSession = void (*)(SystemData& data);
+
+// Long-running server. One process owns the data and serves every
+// operator over a Unix domain socket, so the files are loaded once and
+// no session overwrites another's changes.
+//   - A client whose first line is MENU gets the interactive menus on its
+//     own session thread (see runRemoteClient).
+//   - A client whose first line is CHANGES is sent every committed change
+//     as a JSON line (change_feed.h) and nothing else.
+//   - Any other client speaks the JSON-lines protocol of json_protocol.h;
+//     an epoll loop reads them and the background pool (worker_pool.h)
+//     answers them at interactive priority, in order per client.
+// JSON requests lock only what their operation touches (data_locks.h), so
+// readers run side by side. A menu session holds the data exclusively
+// while it works, shared inside read-only screens, and lets go of it
+// whenever it waits at a prompt; menu sessions draw one at a time.
+// Housekeeping runs about once a second. Runs until SIGINT or SIGTERM,
+// then saves.
+// Linux only. Returns false if the server could not start.
+bool runLocalServer(SystemData& data, const string& socketPath, MenuSession menu);
+
+#endif
@@ -0,0 +1,219 @@
+#include "lock_benchmark.h"
+#include <iostream>
+#include <format>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include "system_data.h"
+#include "json.h"
+#include "json_protocol.h"
+#include "file_operation.h"
+
+using namespace std;
+
+static const int ORGANIZERS = 64;
+static const int PRELOADED_PER_ORGANIZER = 16;  // booked before the first round
+static const Date FIRST_EVENT_DAY{ 2030, 1, 7 };
+
+struct RoundResult {
+    double seconds = 0;
+    long long reads = 0;
+    long long writes = 0;   // bookings created and paid
+    long long failures = 0;
+};
+
+static string organizerID(int organizer) {
+    return format("BENCH{:03}", organizer + 1);
+}
+
+static void addOrganizers(SystemData& data) {
+    for (int i = 0; i < ORGANIZERS; i++) {
+        Organizer organizer;
+        organizer.userID = organizerID(i);
+        organizer.organizerName = format("Bench Organizer {}", i + 1);
+        organizer.manufacturer = i % 2 == 0 ? "Acme" : "Globex";
+        data.organizer.push_back(organizer);
+    }
+}
+
+// One unscheduled registration per event ID, dealt round-robin over the organizers
+static void addRegistrations(SystemData& data, int count) {
+    int first = static_cast<int>(data.registrations.size());
+    for (int i = first; i < first + count; i++) {
+        EventRegistration reg;
+        reg.eventID = format("EVT{:05}", i + 1);
+        reg.eventTitle = format("{} Launch {}", i % 3 == 0 ? "Flagship" : "Midrange", i + 1);
+        reg.manufacturer = data.organizer[i % ORGANIZERS].manufacturer;
+        reg.productQuantity = 1;
+        reg.expectedGuests = 100;
+        reg.estimatedBudget = Money::parse("5000.00");
+        reg.eventStatus = "UNSCHEDULED";
+        reg.organizer = data.organizer[i % ORGANIZERS];
+        data.registrations.push_back(reg);
+    }
+}
+
+// Books registration number `index` into its own venue slot, then pays for it
+static bool bookAndPay(SystemData& data, ProtocolSession& session, int index, string& response) {
+    int slots = static_cast<int>(data.timeConfig.timeSlots.size());
+    int venues = static_cast<int>(data.venues.size());
+    Date date = Date::fromDayNumber(FIRST_EVENT_DAY.toDayNumber() + index / (venues * slots));
+    session.user = organizerID(index % ORGANIZERS);
+
+    response.clear();
+    string request = format(R"({{"op":"createBooking","eventID":"EVT{:05}","date":"{:04}-{:02}-{:02}","slot":{},"venueID":"{}"}})",
+        index + 1, date.year, date.month, date.day, index / venues % slots + 1, data.venues[index % venues].venueID);
+    if (!handleJsonRequest(data, session, request, response)) {
+        return false;
+    }
+    JsonValue created;
+    string error;
+    const JsonValue* booking = parseJson(response, created, error) ? created.find("booking") : nullptr;
+    if (booking == nullptr) {
+        return false;
+    }
+
+    response.clear();
+    request = format(R"({{"op":"pay","bookingID":"{}","method":"Cash"}})", booking->getString("bookingID"));
+    return handleJsonRequest(data, session, request, response);
+}
+
+static RoundResult runRound(SystemData& data, int threadCount, int operationsPerThread, int& nextRegistration, int writeBudget) {
+    static const char* QUERIES[] = {
+        R"({"op":"bookings"})",
+        R"({"op":"search","query":"flagship","limit":20})",
+        R"({"op":"bookings","status":"Confirmed"})",
+        R"({"op":"search","query":"acme","limit":20})",
+    };
+    const long long totalReads = static_cast<long long>(threadCount) * operationsPerThread;
+
+    atomic<bool> start{ false };
+    atomic<long long> readsDone{ 0 };
+    atomic<long long> failures{ 0 };
+    long long writes = 0;
+
+    vector<thread> readers;
+    for (int t = 0; t < threadCount; t++) {
+        readers.emplace_back([&, t]() {
+            ProtocolSession session;
+            string response;
+            long long failed = 0;
+            while (!start.load(memory_order_acquire)) {
+                this_thread::yield();
+            }
+            for (int op = 0; op < operationsPerThread; op++) {
+                session.user = organizerID((t * 7 + op) % ORGANIZERS);
+                response.clear();
+                if (!handleJsonRequest(data, session, QUERIES[op % 4], response)) {
+                    failed++;
+                }
+                if (op % 16 == 15) {
+                    readsDone.fetch_add(16, memory_order_relaxed);
+                }
+            }
+            failures += failed;
+            });
+    }
+
+    // The writer spreads its bookings evenly over the readers' run
+    thread writer([&]() {
+        ProtocolSession session;
+        string response;
+        while (!start.load(memory_order_acquire)) {
+            this_thread::yield();
+        }
+        while (writes < writeBudget) {
+            long long done = readsDone.load(memory_order_relaxed);
+            if (done >= totalReads - threadCount * 16) {
+                break;
+            }
+            if (writes * totalReads > done * writeBudget) {
+                this_thread::yield();
+                continue;
+            }
+            if (!bookAndPay(data, session, nextRegistration++, response)) {
+                failures++;
+            }
+            writes++;
+        }
+        });
+
+    auto began = chrono::steady_clock::now();
+    start.store(true, memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - began).count();
+    writer.join();
+
+    return { seconds, totalReads, writes, failures.load() };
+}
+
+bool runLockBenchmark(int threadCount, int operationsPerThread) {
+    SystemData data(false);
+    data.initializeSampleData();
+    rebuildVenueIndex(data);
+    addOrganizers(data);
+
+    vector<int> threadCounts;
+    for (int threads = 1; threads < threadCount; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(threadCount);
+
+    const int writeBudget = max(operationsPerThread / 10, 1);
+    int preloaded = ORGANIZERS * PRELOADED_PER_ORGANIZER;
+    addRegistrations(data, preloaded + static_cast<int>(threadCounts.size()) * 2 * writeBudget);
+
+    // Nothing here is meant for the data files
+    setSavesDeferred(true);
+
+    long long failures = 0;
+    int nextRegistration = 0;
+    ProtocolSession setup;
+    string response;
+    while (nextRegistration < preloaded) {
+        if (!bookAndPay(data, setup, nextRegistration++, response)) {
+            failures++;
+        }
+    }
+
+    cout << "=== DATA LOCK READ SCALING BENCHMARK ===" << endl;
+    cout << format("Organizers: {}, reads per thread: {}, bookings written per round: up to {}",
+        ORGANIZERS, operationsPerThread, writeBudget) << endl;
+    cout << format("{:>8} | {:>10} {:>14} {:>7} | {:>10} {:>14} {:>7}",
+        "Threads", "Sharded", "reads/s", "writes", "One lock", "reads/s", "writes") << endl;
+
+    for (int threads : threadCounts) {
+        data.locks.singleLock = false;
+        RoundResult sharded = runRound(data, threads, operationsPerThread, nextRegistration, writeBudget);
+        data.locks.singleLock = true;
+        RoundResult single = runRound(data, threads, operationsPerThread, nextRegistration, writeBudget);
+        data.locks.singleLock = false;
+        failures += sharded.failures + single.failures;
+
+        cout << format("{:>8} | {:>9.3f}s {:>14.0f} {:>7} | {:>9.3f}s {:>14.0f} {:>7}",
+            threads,
+            sharded.seconds, sharded.seconds > 0 ? sharded.reads / sharded.seconds : 0.0, sharded.writes,
+            single.seconds, single.seconds > 0 ? single.reads / single.seconds : 0.0, single.writes) << endl;
+    }
+
+    discardDeferredSaves();
+    setSavesDeferred(false);
+
+    // Every written booking was paid for exactly once
+    long long confirmed = 0;
+    for (const auto& booking : data.bookings) {
+        if (booking.bookingStatus == "Confirmed") {
+            confirmed++;
+        }
+    }
+    bool consistent = confirmed == static_cast<long long>(data.payments.size()) &&
+        confirmed == static_cast<long long>(data.bookings.size());
+
+    cout << format("Hardware threads: {}, bookings at the end: {}", thread::hardware_concurrency(), data.bookings.size()) << endl;
+    cout << "Failed requests: " << failures << endl;
+    cout << "Consistency: " << (consistent ? "OK" : format("{} confirmed bookings, {} payments", confirmed, data.payments.size())) << endl;
+    return failures == 0 && consistent;
+}
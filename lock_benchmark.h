@@ -0,0 +1,15 @@
+#pragma once
+#ifndef LOCK_BENCHMARK_H
+#define LOCK_BENCHMARK_H
+
+using namespace std;
+
+// Read scaling under the data locks: reader threads answer JSON bookings
+// and search queries for many organizers while one writer keeps creating
+// and paying for bookings, on synthetic in-memory data (nothing is saved).
+// Each thread count from 1 up to threadCount runs twice: with the sharded
+// locks, and with everything behind one exclusive lock for comparison.
+// Returns false if any request failed or the data ended up inconsistent.
+bool runLockBenchmark(int threadCount, int operationsPerThread);
+
+#endif
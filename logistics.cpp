@@ -23,24 +23,24 @@
 vector<LogisticsItem> getLogisticsItems() {
     vector<LogisticsItem> items;
 
-    items.push_back({ "Sound System & Microphones", 150.00, "Professional audio setup with wireless microphones" });
-    items.push_back({ "Projector & Screen", 120.00, "HD projector with large projection screen" });
-    items.push_back({ "LED Stage Lighting", 200.00, "Professional stage lighting setup" });
-    items.push_back({ "Registration Desk & Setup", 80.00, "Welcome desk with registration materials" });
-    items.push_back({ "Catering Service (Basic)", 25.00, "Per person - Light refreshments and beverages" });
-    items.push_back({ "Photography & Videography", 300.00, "Professional event documentation" });
-    items.push_back({ "Decoration Package", 180.00, "Event theming and decoration setup" });
-    items.push_back({ "Security Service", 100.00, "Professional security personnel" });
-    items.push_back({ "Parking Management", 60.00, "Organized parking assistance" });
-    items.push_back({ "Technical Support Staff", 150.00, "On-site technical assistance" });
+    items.push_back({ "Sound System & Microphones", Money::fromCents(15000), "Professional audio setup with wireless microphones" });
+    items.push_back({ "Projector & Screen", Money::fromCents(12000), "HD projector with large projection screen" });
+    items.push_back({ "LED Stage Lighting", Money::fromCents(20000), "Professional stage lighting setup" });
+    items.push_back({ "Registration Desk & Setup", Money::fromCents(8000), "Welcome desk with registration materials" });
+    items.push_back({ "Catering Service (Basic)", Money::fromCents(2500), "Per person - Light refreshments and beverages" });
+    items.push_back({ "Photography & Videography", Money::fromCents(30000), "Professional event documentation" });
+    items.push_back({ "Decoration Package", Money::fromCents(18000), "Event theming and decoration setup" });
+    items.push_back({ "Security Service", Money::fromCents(10000), "Professional security personnel" });
+    items.push_back({ "Parking Management", Money::fromCents(6000), "Organized parking assistance" });
+    items.push_back({ "Technical Support Staff", Money::fromCents(15000), "On-site technical assistance" });
 
     return items;
 }
 
 // Function to handle logistics selection
-double selectLogistics(vector<string>& selectedItems) {
+Money selectLogistics(vector<string>& selectedItems) {
     vector<LogisticsItem> logisticsItems = getLogisticsItems();
-    double totalLogisticsCost = 0.0;
+    Money totalLogisticsCost;
 
     cout << "\n=== LOGISTICS & ADDITIONAL SERVICES ===" << endl;
     cout << setfill('=') << setw(100) << "=" << setfill(' ') << endl;
@@ -51,7 +51,7 @@ double selectLogistics(vector<string>& selectedItems) {
     for (size_t i = 0; i < logisticsItems.size(); i++) {
         cout << left << setw(4) << (i + 1)
             << setw(35) << logisticsItems[i].itemName
-            << "RM " << setw(8) << fixed << setprecision(2) << logisticsItems[i].itemCost
+            << "RM " << setw(8) << logisticsItems[i].itemCost
             << setw(29) << logisticsItems[i].description.substr(0, 50) << endl;
     }
     cout << setfill('=') << setw(100) << "=" << setfill(' ') << endl;
@@ -89,22 +89,21 @@ double selectLogistics(vector<string>& selectedItems) {
             // For catering, ask for number of people
             if (selectedItem.itemName.find("Catering") != string::npos) {
                 int numPeople = getValidIntegerInput("Enter number of people for catering: ", 1, 1000);
-                double cateringCost = selectedItem.itemCost * numPeople;
+                Money cateringCost = selectedItem.itemCost * numPeople;
                 totalLogisticsCost += cateringCost;
                 selectedItems.push_back(selectedItem.itemName + " (for " + to_string(numPeople) +
-                    " people) - RM " + formatDouble(cateringCost));
+                    " people) - RM " + cateringCost.toString());
                 cout << "Added: " << selectedItem.itemName << " for " << numPeople
-                    << " people - RM " << fixed << setprecision(2) << cateringCost << endl;
+                    << " people - RM " << cateringCost << endl;
             }
             else {
                 totalLogisticsCost += selectedItem.itemCost;
-                selectedItems.push_back(selectedItem.itemName + " - RM " + formatDouble(selectedItem.itemCost));
+                selectedItems.push_back(selectedItem.itemName + " - RM " + selectedItem.itemCost.toString());
                 cout << "Added: " << selectedItem.itemName << " - RM "
-                    << fixed << setprecision(2) << selectedItem.itemCost << endl;
+                    << selectedItem.itemCost << endl;
             }
 
-            cout << "\nCurrent logistics total: RM " << fixed << setprecision(2)
-                << totalLogisticsCost << endl;
+            cout << "\nCurrent logistics total: RM " << totalLogisticsCost << endl;
             cout << "\nSelected items so far:" << endl;
             for (size_t i = 0; i < selectedItems.size(); i++) {
                 cout << (i + 1) << ". " << selectedItems[i] << endl;
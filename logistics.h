@@ -6,15 +6,16 @@
 #include <string>
 #include <vector>
 #include "date.h"
+#include "money.h"
 using namespace std;
 
 struct LogisticsItem {
     string itemName;
-    double itemCost;
+    Money itemCost;
     string description;
 };
 
 vector<LogisticsItem> getLogisticsItems();
-double selectLogistics(vector<string>& selectedItems);
+Money selectLogistics(vector<string>& selectedItems);
 
 #endif
\ No newline at end of file
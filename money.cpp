@@ -0,0 +1,150 @@
+#include "money.h"
+#include <charconv>
+#include <cmath>
+#include <string>
+
+using namespace std;
+
+Money Money::fromDouble(double value) {
+    double scaled = round(value * 100.0); // round() takes halves away from zero
+    if (!(scaled >= static_cast<double>(LLONG_MIN) && scaled < static_cast<double>(LLONG_MAX))) {
+        throw overflow_error("Money value out of range");
+    }
+    return Money{ static_cast<long long>(scaled) };
+}
+
+bool Money::tryParse(const string& text, Money& result) {
+    size_t start = text.find_first_not_of(" \t\r\n");
+    if (start == string::npos) {
+        return false;
+    }
+    size_t end = text.find_last_not_of(" \t\r\n") + 1;
+
+    // Older data files were written with plain double output and may hold exponents
+    if (text.find_first_of("eE", start) < end) {
+        try {
+            result = fromDouble(stod(text.substr(start, end - start)));
+            return true;
+        }
+        catch (const exception&) {
+            return false;
+        }
+    }
+
+    size_t pos = start;
+    bool negative = false;
+    if (text[pos] == '-' || text[pos] == '+') {
+        negative = (text[pos] == '-');
+        pos++;
+    }
+
+    long long whole = 0;
+    bool hasDigits = false;
+    while (pos < end && text[pos] >= '0' && text[pos] <= '9') {
+        if (whole > (LLONG_MAX / 100 - 9) / 10) {
+            return false; // too large to hold in sen
+        }
+        whole = whole * 10 + (text[pos] - '0');
+        hasDigits = true;
+        pos++;
+    }
+
+    long long fraction = 0;
+    if (pos < end && text[pos] == '.') {
+        pos++;
+        int digits = 0;
+        bool roundUp = false;
+        while (pos < end && text[pos] >= '0' && text[pos] <= '9') {
+            if (digits < 2) {
+                fraction = fraction * 10 + (text[pos] - '0');
+            }
+            else if (digits == 2) {
+                roundUp = (text[pos] >= '5'); // third decimal decides, halves away from zero
+            }
+            digits++;
+            hasDigits = true;
+            pos++;
+        }
+        if (digits == 1) {
+            fraction *= 10;
+        }
+        if (roundUp) {
+            fraction++;
+        }
+    }
+
+    if (!hasDigits || pos != end) {
+        return false;
+    }
+
+    long long cents = whole * 100 + fraction;
+    result = Money{ negative ? -cents : cents };
+    return true;
+}
+
+Money Money::parse(const string& text) {
+    Money result;
+    if (!tryParse(text, result)) {
+        throw invalid_argument("Invalid money amount: " + text);
+    }
+    return result;
+}
+
+Money Money::operator*(long long quantity) const {
+    if (quantity != 0 && cents != 0) {
+        // Compare magnitudes in unsigned so LLONG_MIN on either side is well defined
+        unsigned long long centsMagnitude = cents < 0
+            ? 0ULL - static_cast<unsigned long long>(cents)
+            : static_cast<unsigned long long>(cents);
+        unsigned long long quantityMagnitude = quantity < 0
+            ? 0ULL - static_cast<unsigned long long>(quantity)
+            : static_cast<unsigned long long>(quantity);
+        // A negative product may reach LLONG_MIN, one further than LLONG_MAX
+        unsigned long long limit = static_cast<unsigned long long>(LLONG_MAX) + ((cents < 0) != (quantity < 0) ? 1 : 0);
+        if (centsMagnitude > limit / quantityMagnitude) {
+            throw overflow_error("Money multiplication overflow");
+        }
+    }
+    return Money{ cents * quantity };
+}
+
+Money Money::percentOf(int percent) const {
+    Money scaled = *this * percent;
+    long long quotient = scaled.cents / 100;
+    long long remainder = scaled.cents % 100;
+    if (remainder >= 50) {
+        quotient++;
+    }
+    else if (remainder <= -50) {
+        quotient--;
+    }
+    return Money{ quotient };
+}
+
+char* Money::formatTo(char* buffer) const {
+    char* out = buffer;
+    // Work in unsigned so LLONG_MIN has a magnitude
+    unsigned long long magnitude = cents < 0
+        ? 0ULL - static_cast<unsigned long long>(cents)
+        : static_cast<unsigned long long>(cents);
+    if (cents < 0) {
+        *out++ = '-';
+    }
+
+    out = to_chars(out, out + 21, magnitude / 100).ptr;
+    unsigned int sen = static_cast<unsigned int>(magnitude % 100);
+    *out++ = '.';
+    *out++ = static_cast<char>('0' + sen / 10);
+    *out++ = static_cast<char>('0' + sen % 10);
+    return out;
+}
+
+string Money::toString() const {
+    char buffer[32];
+    char* end = formatTo(buffer);
+    return string(buffer, end);
+}
+
+ostream& operator<<(ostream& os, const Money& money) {
+    return os << money.toString();
+}
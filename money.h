@@ -0,0 +1,60 @@
+#pragma once
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <iostream>
+#include <string>
+#include <climits>
+#include <compare>
+#include <stdexcept>
+using namespace std;
+
+// Currency amount stored as a whole number of sen (1/100 RM), so sums
+// and comparisons are exact. All arithmetic is overflow checked and
+// throws overflow_error rather than wrapping.
+struct Money {
+    long long cents = 0;
+
+    static Money fromCents(long long cents) { return Money{ cents }; }
+    static Money fromDouble(double value);      // rounds to the nearest sen, halves away from zero
+    static Money parse(const string& text);     // "2500", "2500.5", "2500.00"; throws invalid_argument
+    static bool tryParse(const string& text, Money& result);
+
+    Money& operator+=(Money other) {
+        if ((other.cents > 0 && cents > LLONG_MAX - other.cents) ||
+            (other.cents < 0 && cents < LLONG_MIN - other.cents)) {
+            throw overflow_error("Money addition overflow");
+        }
+        cents += other.cents;
+        return *this;
+    }
+
+    Money& operator-=(Money other) {
+        if ((other.cents < 0 && cents > LLONG_MAX + other.cents) ||
+            (other.cents > 0 && cents < LLONG_MIN + other.cents)) {
+            throw overflow_error("Money subtraction overflow");
+        }
+        cents -= other.cents;
+        return *this;
+    }
+
+    Money operator+(Money other) const { Money result = *this; result += other; return result; }
+    Money operator-(Money other) const { Money result = *this; result -= other; return result; }
+    Money operator*(long long quantity) const;
+
+    // percent% of this amount, halves rounded away from zero (e.g. 10% of 0.05 = 0.01)
+    Money percentOf(int percent) const;
+
+    bool isZero() const { return cents == 0; }
+    double toDouble() const { return cents / 100.0; }
+
+    // Writes "-1234.56" into buffer (at least 24 chars) and returns the end pointer
+    char* formatTo(char* buffer) const;
+    string toString() const;
+
+    auto operator<=>(const Money& other) const = default;
+};
+
+ostream& operator<<(ostream& os, const Money& money);
+
+#endif
@@ -3,13 +3,14 @@
 #define PRODUCT_H
 
 #include <string>
+#include "money.h"
 using namespace std;
 
 // Product launches
 struct Product {
     string productName;   // E.g. iPhone 16
     string productModel;  // E.g. A3287
-    double productPrice;  // E.g. RM3999.00
+    Money productPrice;   // E.g. RM3999.00
 };
 
 #endif
@@ -0,0 +1,323 @@
+#include "rating_trends.h"
+#include <cmath>
+#include <iterator>
+#include <tuple>
+#include "feedback.h"
+#include "system_data.h"
+#include "utility_fun.h"
+
+using namespace std;
+
+// Mean difference between windows that counts as a real change
+static const double TREND_THRESHOLD = 0.25;
+
+bool TrendSample::operator<(const TrendSample& other) const {
+    return tie(eventDay, feedbackID) < tie(other.eventDay, other.feedbackID);
+}
+
+void WindowStats::add(const TrendSample& sample) {
+    count++;
+    for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
+        sums[category] += sample.ratings[category];
+        squares[category] += sample.ratings[category] * sample.ratings[category];
+    }
+}
+
+void WindowStats::remove(const TrendSample& sample) {
+    count--;
+    for (int category = 0; category < NUM_RATING_CATEGORIES; category++) {
+        sums[category] -= sample.ratings[category];
+        squares[category] -= sample.ratings[category] * sample.ratings[category];
+    }
+}
+
+double WindowStats::mean(int category) const {
+    return count > 0 ? static_cast<double>(sums[category]) / count : 0.0;
+}
+
+double WindowStats::variance(int category) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    double average = mean(category);
+    double result = static_cast<double>(squares[category]) / count - average * average;
+    return result > 0.0 ? result : 0.0; // guard against rounding just below zero
+}
+
+static TrendSample makeSample(const EventFeedback& feedback) {
+    TrendSample sample;
+    sample.eventDay = feedback.eventDate.toDayNumber();
+    sample.feedbackID = feedback.feedbackID;
+    sample.eventTitle = feedback.eventTitle;
+    sample.ratings[0] = feedback.venueRating;
+    sample.ratings[1] = feedback.organizationRating;
+    sample.ratings[2] = feedback.logisticsRating;
+    sample.ratings[3] = feedback.overallRating;
+    return sample;
+}
+
+// Which day window a sample falls in: 0 = recent, 1 = prior, -1 = neither
+static int dayWindowOf(const RatingTrendStore& store, int eventDay) {
+    if (eventDay > store.today - store.windowDays) {
+        return 0;
+    }
+    if (eventDay > store.today - 2 * store.windowDays) {
+        return 1;
+    }
+    return -1;
+}
+
+static void insertSample(const RatingTrendStore& store, TrendSeries& series, const TrendSample& sample) {
+    auto inserted = series.samples.insert(sample);
+    if (!inserted.second) {
+        return; // already recorded
+    }
+    size_t capacity = store.windowEvents;
+
+    // Count windows
+    if (static_cast<size_t>(series.recent.count) < capacity) {
+        // Everything fits in the latest window, nothing precedes it yet
+        series.recent.add(sample);
+        series.recentStart = series.samples.begin();
+        series.priorStart = series.samples.begin();
+    }
+    else if (*series.recentStart < sample) {
+        // Joins the latest window, pushing its oldest sample into the prior one
+        series.recent.add(sample);
+        auto pushedOut = series.recentStart++;
+        series.recent.remove(*pushedOut);
+        series.prior.add(*pushedOut);
+        if (static_cast<size_t>(series.prior.count) > capacity) {
+            series.prior.remove(*series.priorStart);
+            ++series.priorStart;
+        }
+    }
+    else if (static_cast<size_t>(series.prior.count) < capacity) {
+        // Prior window still has room, so it already starts at the first sample
+        series.prior.add(sample);
+        series.priorStart = series.samples.begin();
+    }
+    else if (*series.priorStart < sample) {
+        series.prior.add(sample);
+        series.prior.remove(*series.priorStart);
+        ++series.priorStart;
+    }
+
+    // Day windows
+    switch (dayWindowOf(store, sample.eventDay)) {
+    case 0: series.recentDays.add(sample); break;
+    case 1: series.priorDays.add(sample); break;
+    }
+}
+
+static void eraseSample(const RatingTrendStore& store, TrendSeries& series, const TrendSample& sample) {
+    auto it = series.samples.find(sample);
+    if (it == series.samples.end()) {
+        return;
+    }
+    const TrendSample& stored = *it;
+
+    switch (dayWindowOf(store, stored.eventDay)) {
+    case 0: series.recentDays.remove(stored); break;
+    case 1: series.priorDays.remove(stored); break;
+    }
+
+    bool inRecent = series.recent.count > 0 && !(stored < *series.recentStart);
+    bool inPrior = !inRecent && series.prior.count > 0 && !(stored < *series.priorStart);
+
+    if (inRecent) {
+        series.recent.remove(stored);
+        if (it == series.recentStart) {
+            ++series.recentStart;
+        }
+        if (it == series.priorStart) {
+            ++series.priorStart; // prior window was empty and started here too
+        }
+        series.samples.erase(it);
+
+        // Refill from the prior window, then refill the prior window from older samples
+        if (series.priorStart != series.recentStart) {
+            --series.recentStart;
+            series.prior.remove(*series.recentStart);
+            series.recent.add(*series.recentStart);
+        }
+        if (series.priorStart != series.samples.begin()) {
+            --series.priorStart;
+            series.prior.add(*series.priorStart);
+        }
+    }
+    else if (inPrior) {
+        series.prior.remove(stored);
+        if (it == series.priorStart) {
+            ++series.priorStart;
+        }
+        series.samples.erase(it);
+        if (series.priorStart != series.samples.begin()) {
+            --series.priorStart;
+            series.prior.add(*series.priorStart);
+        }
+    }
+    else {
+        series.samples.erase(it);
+    }
+}
+
+void addFeedbackToTrends(RatingTrendStore& store, const EventFeedback& feedback) {
+    TrendSample sample = makeSample(feedback);
+    insertSample(store, store.byOrganizer[normalizeUserID(feedback.submittedBy)], sample);
+    insertSample(store, store.byVenue[feedback.venueName], sample);
+}
+
+void removeFeedbackFromTrends(RatingTrendStore& store, const EventFeedback& feedback) {
+    TrendSample sample = makeSample(feedback);
+
+    auto organizer = store.byOrganizer.find(normalizeUserID(feedback.submittedBy));
+    if (organizer != store.byOrganizer.end()) {
+        eraseSample(store, organizer->second, sample);
+        if (organizer->second.samples.empty()) {
+            store.byOrganizer.erase(organizer);
+        }
+    }
+
+    auto venue = store.byVenue.find(feedback.venueName);
+    if (venue != store.byVenue.end()) {
+        eraseSample(store, venue->second, sample);
+        if (venue->second.samples.empty()) {
+            store.byVenue.erase(venue);
+        }
+    }
+}
+
+void copyRatingTrends(const RatingTrendStore& from, RatingTrendStore& to) {
+    to.windowEvents = from.windowEvents;
+    to.windowDays = from.windowDays;
+    to.today = from.today;
+    to.byOrganizer.clear();
+    to.byVenue.clear();
+    for (const auto& [userID, series] : from.byOrganizer) {
+        TrendSeries& copy = to.byOrganizer[userID];
+        for (const auto& sample : series.samples) {
+            insertSample(to, copy, sample);
+        }
+    }
+    for (const auto& [venueName, series] : from.byVenue) {
+        TrendSeries& copy = to.byVenue[venueName];
+        for (const auto& sample : series.samples) {
+            insertSample(to, copy, sample);
+        }
+    }
+}
+
+void rebuildRatingTrends(SystemData& data) {
+    data.ratingTrends.byOrganizer.clear();
+    data.ratingTrends.byVenue.clear();
+    data.ratingTrends.today = getCurrentDate().toDayNumber();
+    for (const auto& feedback : data.feedbacks) {
+        addFeedbackToTrends(data.ratingTrends, feedback);
+    }
+}
+
+// Move samples with eventDay in (fromDay, toDay] from one window to another (or out)
+static void shiftDays(TrendSeries& series, int fromDay, int toDay, WindowStats* leaving, WindowStats* joining) {
+    TrendSample low, high;
+    low.eventDay = fromDay + 1;
+    high.eventDay = toDay + 1;
+    auto end = series.samples.lower_bound(high);
+    for (auto it = series.samples.lower_bound(low); it != end; ++it) {
+        if (leaving != nullptr) {
+            leaving->remove(*it);
+        }
+        if (joining != nullptr) {
+            joining->add(*it);
+        }
+    }
+}
+
+static void slideSeries(const RatingTrendStore& store, TrendSeries& series, int today) {
+    int days = store.windowDays;
+    // Recent/prior boundary moves first so samples pass through the prior window
+    shiftDays(series, store.today - days, today - days, &series.recentDays, &series.priorDays);
+    shiftDays(series, store.today - 2 * days, today - 2 * days, &series.priorDays, nullptr);
+}
+
+void advanceTrendWindows(RatingTrendStore& store, int today) {
+    if (today == store.today) {
+        return;
+    }
+
+    if (today < store.today) {
+        // Moving backwards is rare (clock corrections), just recount the day windows
+        store.today = today;
+        for (auto* seriesMap : { &store.byOrganizer, &store.byVenue }) {
+            for (auto& entry : *seriesMap) {
+                TrendSeries& series = entry.second;
+                series.recentDays = WindowStats();
+                series.priorDays = WindowStats();
+                for (const auto& sample : series.samples) {
+                    switch (dayWindowOf(store, sample.eventDay)) {
+                    case 0: series.recentDays.add(sample); break;
+                    case 1: series.priorDays.add(sample); break;
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    for (auto* seriesMap : { &store.byOrganizer, &store.byVenue }) {
+        for (auto& entry : *seriesMap) {
+            slideSeries(store, entry.second, today);
+        }
+    }
+    store.today = today;
+}
+
+const TrendSeries* findOrganizerTrend(const RatingTrendStore& store, const string& userID) {
+    auto it = store.byOrganizer.find(normalizeUserID(userID));
+    return it == store.byOrganizer.end() ? nullptr : &it->second;
+}
+
+const TrendSeries* findVenueTrend(const RatingTrendStore& store, const string& venueName) {
+    auto it = store.byVenue.find(venueName);
+    return it == store.byVenue.end() ? nullptr : &it->second;
+}
+
+static TrendReport compareWindows(const WindowStats& recent, const WindowStats& prior, int category) {
+    TrendReport report;
+    report.recentCount = recent.count;
+    report.priorCount = prior.count;
+    report.recentMean = recent.mean(category);
+    report.priorMean = prior.mean(category);
+    report.recentStdDev = sqrt(recent.variance(category));
+
+    if (recent.count == 0 || prior.count == 0) {
+        report.direction = TrendDirection::NotEnoughData;
+    }
+    else if (report.recentMean - report.priorMean >= TREND_THRESHOLD) {
+        report.direction = TrendDirection::Improving;
+    }
+    else if (report.priorMean - report.recentMean >= TREND_THRESHOLD) {
+        report.direction = TrendDirection::Declining;
+    }
+    else {
+        report.direction = TrendDirection::Steady;
+    }
+    return report;
+}
+
+TrendReport eventTrend(const TrendSeries& series, int category) {
+    return compareWindows(series.recent, series.prior, category);
+}
+
+TrendReport dayTrend(const TrendSeries& series, int category) {
+    return compareWindows(series.recentDays, series.priorDays, category);
+}
+
+string trendLabel(TrendDirection direction) {
+    switch (direction) {
+    case TrendDirection::Improving: return "Improving";
+    case TrendDirection::Steady: return "Steady";
+    case TrendDirection::Declining: return "Declining";
+    default: return "Not enough data";
+    }
+}
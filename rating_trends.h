@@ -0,0 +1,95 @@
+#pragma once
+#ifndef RATING_TRENDS_H
+#define RATING_TRENDS_H
+
+#include <string>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "feedback_store.h"
+using namespace std;
+
+// One feedback as seen by the trend windows, ordered by event date
+struct TrendSample {
+    int eventDay = 0;                           // Date::toDayNumber() of the event
+    string feedbackID;                          // tie breaker for events on the same day
+    string eventTitle;
+    int ratings[NUM_RATING_CATEGORIES] = {};
+
+    bool operator<(const TrendSample& other) const;
+};
+
+// Running sums for one window, enough for mean and variance in O(1)
+struct WindowStats {
+    int count = 0;
+    long long sums[NUM_RATING_CATEGORIES] = {};
+    long long squares[NUM_RATING_CATEGORIES] = {};
+
+    void add(const TrendSample& sample);
+    void remove(const TrendSample& sample);
+    double mean(int category) const;
+    double variance(int category) const;
+};
+
+// All samples of one organizer or venue plus two pairs of adjacent windows:
+//  - by count: the latest N events and the N events before them
+//  - by days:  events in the last N days and in the N days before that
+// Inserting or removing a sample moves at most a couple of samples across
+// window boundaries, so the window sums never need a rescan.
+struct TrendSeries {
+    set<TrendSample> samples;
+    set<TrendSample>::iterator recentStart;     // first sample of the latest-N window
+    set<TrendSample>::iterator priorStart;      // first sample of the window before it
+    WindowStats recent, prior;                  // count windows
+    WindowStats recentDays, priorDays;          // day windows
+
+    TrendSeries() : recentStart(samples.end()), priorStart(samples.end()) {}
+    TrendSeries(const TrendSeries&) = delete;   // iterators point into samples
+    TrendSeries& operator=(const TrendSeries&) = delete;
+};
+
+struct RatingTrendStore {
+    size_t windowEvents = 5;    // N for the count windows
+    int windowDays = 90;        // N for the day windows
+    int today = 0;              // day number the day windows are anchored to
+    unordered_map<string, TrendSeries> byOrganizer; // normalized submittedBy -> series
+    unordered_map<string, TrendSeries> byVenue;     // venueName -> series
+};
+
+enum class TrendDirection { NotEnoughData, Improving, Steady, Declining };
+
+struct TrendReport {
+    TrendDirection direction = TrendDirection::NotEnoughData;
+    double recentMean = 0.0;
+    double priorMean = 0.0;
+    double recentStdDev = 0.0;
+    int recentCount = 0;
+    int priorCount = 0;
+};
+
+// Forward declarations
+struct EventFeedback;
+class SystemData;
+
+// Incremental maintenance - call alongside changes to data.feedbacks
+void addFeedbackToTrends(RatingTrendStore& store, const EventFeedback& feedback);
+void removeFeedbackFromTrends(RatingTrendStore& store, const EventFeedback& feedback);
+void rebuildRatingTrends(SystemData& data);
+
+// Slide the day windows forward so they end on the given day
+void advanceTrendWindows(RatingTrendStore& store, int today);
+
+// Independent copy of a whole store; the series hold iterators into
+// themselves, so they are rebuilt sample by sample rather than copied
+void copyRatingTrends(const RatingTrendStore& from, RatingTrendStore& to);
+
+// Returns nullptr when nothing has been recorded for the key
+const TrendSeries* findOrganizerTrend(const RatingTrendStore& store, const string& userID);
+const TrendSeries* findVenueTrend(const RatingTrendStore& store, const string& venueName);
+
+// Compare the latest window against the one before it
+TrendReport eventTrend(const TrendSeries& series, int category);
+TrendReport dayTrend(const TrendSeries& series, int category);
+string trendLabel(TrendDirection direction);
+
+#endif
@@ -0,0 +1,157 @@
+#pragma once
+#ifndef RECORD_TABLE_H
+#define RECORD_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <utility>
+using namespace std;
+
+// Stable reference to one record. Record numbers are never reused, so a
+// handle to a deleted record simply stops resolving.
+struct RecordHandle {
+    static const uint32_t NONE = UINT32_MAX;
+    uint32_t id = NONE;
+
+    bool valid() const { return id != NONE; }
+    bool operator==(const RecordHandle&) const = default;
+};
+
+// Insertion-ordered records with O(1) delete. Deleting leaves a tombstone
+// in place, so nothing shifts: handles, references and pointers to the
+// other records stay valid (the deque never moves records on insert
+// either). compact() drops the tombstones; it moves records, so only call
+// it where no references are held. Handles survive compaction.
+template <typename T>
+class RecordTable {
+public:
+    template <typename Table, typename Value>
+    class Iterator {
+    public:
+        Iterator(Table* table, size_t position) : table(table), position(position) { skipDead(); }
+        Value& operator*() const { return table->records[position]; }
+        Value* operator->() const { return &table->records[position]; }
+        Iterator& operator++() { position++; skipDead(); return *this; }
+        bool operator==(const Iterator& other) const { return position == other.position; }
+        RecordHandle handle() const { return { table->idAt[position] }; }
+
+    private:
+        Table* table;
+        size_t position;
+        void skipDead() {
+            while (position < table->records.size() && table->idAt[position] == RecordHandle::NONE) {
+                position++;
+            }
+        }
+    };
+    using iterator = Iterator<RecordTable, T>;
+    using const_iterator = Iterator<const RecordTable, const T>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, records.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, records.size()); }
+
+    size_t size() const { return liveCount; }
+    bool empty() const { return liveCount == 0; }
+    size_t tombstones() const { return records.size() - liveCount; }
+
+    RecordHandle insert(T record) {
+        RecordHandle handle{ static_cast<uint32_t>(positionOf.size()) };
+        positionOf.push_back(records.size());
+        idAt.push_back(handle.id);
+        records.push_back(move(record));
+        liveCount++;
+        return handle;
+    }
+    void push_back(T record) { insert(move(record)); }
+
+    bool erase(RecordHandle handle) {
+        T* record = find(handle);
+        if (record == nullptr) {
+            return false;
+        }
+        size_t position = positionOf[handle.id];
+        *record = T();                  // free what the record owned
+        idAt[position] = RecordHandle::NONE;
+        positionOf[handle.id] = NO_POSITION;
+        liveCount--;
+        return true;
+    }
+
+    template <typename Predicate>
+    size_t eraseIf(Predicate predicate) {
+        size_t erased = 0;
+        for (auto it = begin(); it != end(); ++it) {
+            if (predicate(*it)) {
+                erase(it.handle());
+                erased++;
+            }
+        }
+        return erased;
+    }
+
+    T* find(RecordHandle handle) {
+        return const_cast<T*>(static_cast<const RecordTable*>(this)->find(handle));
+    }
+    const T* find(RecordHandle handle) const {
+        if (handle.id >= positionOf.size() || positionOf[handle.id] == NO_POSITION) {
+            return nullptr;
+        }
+        return &records[positionOf[handle.id]];
+    }
+    T& operator[](RecordHandle handle) { return *find(handle); }
+    const T& operator[](RecordHandle handle) const { return *find(handle); }
+
+    // Last live record, as vector::back
+    T& back() { return records[lastLive()]; }
+    const T& back() const { return records[lastLive()]; }
+    RecordHandle backHandle() const { return { idAt[lastLive()] }; }
+
+    void clear() {
+        records.clear();
+        idAt.clear();
+        positionOf.clear();
+        liveCount = 0;
+    }
+
+    // Worth compacting once tombstones outnumber live records
+    bool needsCompaction() const { return tombstones() > 32 && tombstones() > liveCount; }
+
+    void compact() {
+        size_t write = 0;
+        for (size_t read = 0; read < records.size(); read++) {
+            uint32_t id = idAt[read];
+            if (id == RecordHandle::NONE) {
+                continue;
+            }
+            if (write != read) {
+                records[write] = move(records[read]);
+                idAt[write] = id;
+                positionOf[id] = write;
+            }
+            write++;
+        }
+        records.resize(write);
+        idAt.resize(write);
+    }
+
+private:
+    static const size_t NO_POSITION = SIZE_MAX;
+
+    deque<T> records;                   // tombstones included until compaction
+    deque<uint32_t> idAt;               // position -> record number, NONE for a tombstone
+    vector<size_t> positionOf;          // record number -> position, NO_POSITION once deleted
+    size_t liveCount = 0;
+
+    size_t lastLive() const {
+        size_t position = records.size();
+        while (idAt[position - 1] == RecordHandle::NONE) {
+            position--;
+        }
+        return position - 1;
+    }
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include "remote_client.h"
+#include <iostream>
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+static bool sendAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+int runRemoteClient(const string& socketPath, RemoteMode mode) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        cout << "Error: socket path is too long: " << socketPath << endl;
+        return 1;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        cout << "Error: no server on " << socketPath << " (" << strerror(errno) << ")" << endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return 1;
+    }
+    const char* greeting = mode == RemoteMode::Menu ? "MENU\n" : mode == RemoteMode::Changes ? "CHANGES\n" : "";
+    if (!sendAll(fd, greeting, strlen(greeting))) {
+        close(fd);
+        return 1;
+    }
+
+    // Shuttle bytes both ways until the server hangs up. Input is passed
+    // on raw; the server splits it into lines.
+    pollfd watched[2] = { { STDIN_FILENO, POLLIN, 0 }, { fd, POLLIN, 0 } };
+    if (mode == RemoteMode::Changes) {
+        watched[0].fd = -1;     // nothing to send; runs until interrupted
+    }
+    char buffer[16384];
+    while (true) {
+        if (poll(watched, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (watched[1].revents & (POLLIN | POLLHUP | POLLERR)) {
+            ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                break;
+            }
+            if (write(STDOUT_FILENO, buffer, received) != received) {
+                break;
+            }
+        }
+        if (watched[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+            ssize_t typed = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (typed <= 0) {
+                // End of input: let the server finish answering, then stop
+                shutdown(fd, SHUT_WR);
+                watched[0].fd = -1;
+            }
+            else if (!sendAll(fd, buffer, typed)) {
+                break;
+            }
+        }
+    }
+    close(fd);
+    return 0;
+}
+
+#else
+
+int runRemoteClient(const string&, RemoteMode) {
+    cout << "Error: the remote client needs Unix domain sockets (Linux only)." << endl;
+    return 1;
+}
+
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+#ifndef REMOTE_CLIENT_H
+#define REMOTE_CLIENT_H
+
+#include <string>
+using namespace std;
+
+enum class RemoteMode { Menu, Json, Changes };
+
+// Thin client for runLocalServer: relays this terminal to the server's
+// menus, relays JSON-lines requests and responses, or prints the server's
+// change stream. Returns 0 once the server ends the session, 1 if it
+// can't connect. Linux only.
+int runRemoteClient(const string& socketPath, RemoteMode mode);
+
+#endif
@@ -0,0 +1,124 @@
+#include "reservation_benchmark.h"
+#include <iostream>
+#include <format>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include "slot_cells.h"
+#include "date.h"
+
+using namespace std;
+
+static const int HOT_VENUES = 4;
+static const int HOT_SLOTS = 2;
+static const int HOT_DAYS = 8;
+
+struct BenchmarkCounters {
+    long long claimed = 0;
+    long long conflicts = 0;
+    long long released = 0;
+    long long reclaimed = 0; // claims on a cell the thread already held
+};
+
+bool runReservationBenchmark(int threadCount, int operationsPerThread) {
+    SlotCells cells;
+    cells.reset(HOT_VENUES, HOT_SLOTS);
+    int firstDay = Date{ 2025, 12, 20 }.toDayNumber(); // crosses a year boundary on purpose
+
+    // Each thread's wins as seen by itself, to cross-check against the cells
+    vector<BenchmarkCounters> counters(threadCount);
+    vector<vector<uint8_t>> held(threadCount, vector<uint8_t>(HOT_VENUES * HOT_SLOTS * HOT_DAYS, 0));
+    atomic<bool> start{ false };
+
+    vector<thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            mt19937 random(1234u + t);
+            uniform_int_distribution<int> pickCell(0, HOT_VENUES * HOT_SLOTS * HOT_DAYS - 1);
+            uniform_int_distribution<int> percent(0, 99);
+            uint32_t token = static_cast<uint32_t>(t + 1);
+
+            while (!start.load(memory_order_acquire)) {
+                this_thread::yield();
+            }
+            for (int op = 0; op < operationsPerThread; op++) {
+                int cell = pickCell(random);
+                int venue = cell % HOT_VENUES;
+                int slot = (cell / HOT_VENUES) % HOT_SLOTS;
+                int day = firstDay + cell / (HOT_VENUES * HOT_SLOTS);
+
+                if (held[t][cell]) {
+                    if (percent(random) < 50) {
+                        if (cells.release(venue, day, slot, token)) {
+                            held[t][cell] = 0;
+                            counters[t].released++;
+                        }
+                    }
+                    else if (cells.claim(venue, day, slot, token) == ReserveResult::Claimed) {
+                        // Re-claiming our own cell succeeds but is not a new win
+                        counters[t].reclaimed++;
+                    }
+                    continue;
+                }
+                if (cells.claim(venue, day, slot, token) == ReserveResult::Claimed) {
+                    held[t][cell] = 1;
+                    counters[t].claimed++;
+                }
+                else {
+                    counters[t].conflicts++;
+                }
+            }
+            });
+    }
+
+    auto began = chrono::steady_clock::now();
+    start.store(true, memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - began).count();
+
+    BenchmarkCounters total;
+    for (const auto& counter : counters) {
+        total.claimed += counter.claimed;
+        total.conflicts += counter.conflicts;
+        total.released += counter.released;
+        total.reclaimed += counter.reclaimed;
+    }
+
+    // Every cell must be owned by exactly the thread that believes it holds it
+    int mismatches = 0;
+    for (int cell = 0; cell < HOT_VENUES * HOT_SLOTS * HOT_DAYS; cell++) {
+        int venue = cell % HOT_VENUES;
+        int slot = (cell / HOT_VENUES) % HOT_SLOTS;
+        int day = firstDay + cell / (HOT_VENUES * HOT_SLOTS);
+        uint32_t owner = cells.owner(venue, day, slot);
+        int holders = 0;
+        for (int t = 0; t < threadCount; t++) {
+            if (held[t][cell]) {
+                holders++;
+                if (owner != static_cast<uint32_t>(t + 1)) {
+                    mismatches++;
+                }
+            }
+        }
+        if (holders > 1 || (holders == 0 && owner != 0)) {
+            mismatches++;
+        }
+    }
+
+    long long operations = total.claimed + total.conflicts + total.released + total.reclaimed;
+    long long attempts = total.claimed + total.conflicts;
+    cout << "=== RESERVATION STRESS BENCHMARK ===" << endl;
+    cout << format("Threads: {}, operations per thread: {}, hot cells: {}",
+        threadCount, operationsPerThread, HOT_VENUES * HOT_SLOTS * HOT_DAYS) << endl;
+    cout << format("Elapsed: {:.3f} s, throughput: {:.0f} ops/s", seconds,
+        seconds > 0 ? operations / seconds : 0.0) << endl;
+    cout << format("Claims won: {}, conflicts: {} ({:.1f}% of attempts), releases: {}, re-claims of held cells: {}",
+        total.claimed, total.conflicts, attempts > 0 ? 100.0 * total.conflicts / attempts : 0.0,
+        total.released, total.reclaimed) << endl;
+    cout << "Consistency: " << (mismatches == 0 ? "OK" : format("{} inconsistent cells", mismatches)) << endl;
+    return mismatches == 0;
+}
@@ -0,0 +1,13 @@
+#pragma once
+#ifndef RESERVATION_BENCHMARK_H
+#define RESERVATION_BENCHMARK_H
+
+using namespace std;
+
+// Stress test for the slot claim cells: every thread races for the same few
+// venues on the same hot dates, cancelling some of what it wins. Prints
+// throughput, conflict rate and whether any cell ended up double-owned.
+// Returns false if the consistency check failed.
+bool runReservationBenchmark(int threadCount, int operationsPerThread);
+
+#endif
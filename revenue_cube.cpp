@@ -0,0 +1,212 @@
+#include "revenue_cube.h"
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include "event_booking.h"
+#include "event_payment.h"
+#include "system_data.h"
+#include "utility_fun.h"
+
+using namespace std;
+
+bool RevenueKey::operator<(const RevenueKey& other) const {
+    return tie(organizerID, month, week, venueID, manufacturer, paymentMethod, status) <
+        tie(other.organizerID, other.month, other.week, other.venueID, other.manufacturer, other.paymentMethod, other.status);
+}
+
+string monthLabel(const Date& date) {
+    return to_string(date.year) + "-" + (date.month < 10 ? "0" : "") + to_string(date.month);
+}
+
+string isoWeekLabel(const Date& date) {
+    int dayNumber = date.toDayNumber();
+    int weekday = ((dayNumber + 3) % 7 + 7) % 7; // Monday = 0 (1970-01-01 was a Thursday)
+    int thursday = dayNumber - weekday + 3;
+
+    // The ISO year is the calendar year of that week's Thursday
+    int isoYear = date.year;
+    if (thursday >= Date{ date.year + 1, 1, 1 }.toDayNumber()) {
+        isoYear = date.year + 1;
+    }
+    else if (thursday < Date{ date.year, 1, 1 }.toDayNumber()) {
+        isoYear = date.year - 1;
+    }
+
+    int week = (thursday - Date{ isoYear, 1, 1 }.toDayNumber()) / 7 + 1;
+    return to_string(isoYear) + "-W" + (week < 10 ? "0" : "") + to_string(week);
+}
+
+// Move a contribution into or out of its cell, dropping cells that become empty
+static void applyToCell(map<RevenueKey, RevenueCell>& cells, const RevenueEntry& entry, int sign) {
+    RevenueCell& cell = cells[entry.key];
+    if (sign > 0) {
+        cell.total += entry.amount;
+    }
+    else {
+        cell.total -= entry.amount;
+    }
+    cell.count += sign;
+    if (cell.count <= 0) {
+        cells.erase(entry.key);
+    }
+}
+
+void recordBookingInCube(RevenueCube& cube, const EventBooking& booking) {
+    RevenueEntry entry;
+    entry.key.organizerID = normalizeUserID(booking.eventReg.organizer.userID);
+    entry.key.month = monthLabel(booking.eventDate);
+    entry.key.week = isoWeekLabel(booking.eventDate);
+    entry.key.venueID = booking.venue.venueID;
+    entry.key.manufacturer = booking.eventReg.manufacturer;
+    entry.key.status = booking.bookingStatus;
+    entry.amount = booking.finalCost;
+
+    // Take back the previous contribution of this booking, if any
+    auto existing = cube.bookingEntries.find(booking.bookingID);
+    if (existing != cube.bookingEntries.end()) {
+        applyToCell(cube.bookingCells, existing->second, -1);
+    }
+
+    applyToCell(cube.bookingCells, entry, +1);
+    cube.bookingEntries[booking.bookingID] = entry;
+}
+
+void removeBookingFromCube(RevenueCube& cube, const string& bookingID) {
+    auto existing = cube.bookingEntries.find(bookingID);
+    if (existing == cube.bookingEntries.end()) {
+        return;
+    }
+    applyToCell(cube.bookingCells, existing->second, -1);
+    cube.bookingEntries.erase(existing);
+
+    // Payments of a deleted booking no longer belong to any organizer
+    auto payments = cube.paymentsByBooking.find(bookingID);
+    if (payments != cube.paymentsByBooking.end()) {
+        for (const auto& paymentID : payments->second) {
+            auto payment = cube.paymentEntries.find(paymentID);
+            if (payment != cube.paymentEntries.end()) {
+                applyToCell(cube.paymentCells, payment->second, -1);
+                cube.paymentEntries.erase(payment);
+            }
+        }
+        cube.paymentsByBooking.erase(payments);
+    }
+}
+
+void recordPaymentInCube(RevenueCube& cube, const Payment& payment, const EventBooking& booking) {
+    RevenueEntry entry;
+    entry.key.organizerID = normalizeUserID(booking.eventReg.organizer.userID);
+    entry.key.month = monthLabel(payment.paymentDate);
+    entry.key.week = isoWeekLabel(payment.paymentDate);
+    entry.key.venueID = booking.venue.venueID;
+    entry.key.manufacturer = booking.eventReg.manufacturer;
+    entry.key.paymentMethod = payment.paymentMethod;
+    entry.key.status = payment.paymentStatus;
+    entry.amount = payment.amount;
+
+    auto existing = cube.paymentEntries.find(payment.paymentID);
+    if (existing != cube.paymentEntries.end()) {
+        applyToCell(cube.paymentCells, existing->second, -1);
+    }
+    else {
+        cube.paymentsByBooking[booking.bookingID].push_back(payment.paymentID);
+    }
+
+    applyToCell(cube.paymentCells, entry, +1);
+    cube.paymentEntries[payment.paymentID] = entry;
+}
+
+void rebuildRevenueCube(SystemData& data) {
+    data.revenue = RevenueCube();
+
+    unordered_map<string, const EventBooking*> bookingByID;
+    for (const auto& booking : data.bookings) {
+        bookingByID[booking.bookingID] = &booking;
+        recordBookingInCube(data.revenue, booking);
+    }
+
+    for (const auto& payment : data.payments) {
+        auto found = bookingByID.find(payment.bookingID);
+        if (found != bookingByID.end()) {
+            recordPaymentInCube(data.revenue, payment, *found->second);
+        }
+    }
+}
+
+static bool matchesFilter(const RevenueKey& key, const RevenueFilter& filter) {
+    return (filter.organizerID.empty() || key.organizerID == filter.organizerID) &&
+        (filter.month.empty() || key.month == filter.month) &&
+        (filter.week.empty() || key.week == filter.week) &&
+        (filter.venueID.empty() || key.venueID == filter.venueID) &&
+        (filter.manufacturer.empty() || key.manufacturer == filter.manufacturer) &&
+        (filter.paymentMethod.empty() || key.paymentMethod == filter.paymentMethod) &&
+        (filter.status.empty() || key.status == filter.status);
+}
+
+static const string& dimensionValue(const RevenueKey& key, RevenueDimension dimension) {
+    switch (dimension) {
+    case RevenueDimension::Month: return key.month;
+    case RevenueDimension::Week: return key.week;
+    case RevenueDimension::Venue: return key.venueID;
+    case RevenueDimension::Manufacturer: return key.manufacturer;
+    case RevenueDimension::PaymentMethod: return key.paymentMethod;
+    case RevenueDimension::Status: return key.status;
+    }
+    return key.status;
+}
+
+// Visit every cell matching the filter. When the organizer is fixed only
+// that organizer's contiguous range of cells is walked.
+template <typename Visitor>
+static void forEachCell(const map<RevenueKey, RevenueCell>& cells, const RevenueFilter& filter, Visitor visit) {
+    auto it = cells.begin();
+    if (!filter.organizerID.empty()) {
+        RevenueKey start;
+        start.organizerID = filter.organizerID;
+        it = cells.lower_bound(start);
+    }
+
+    for (; it != cells.end(); ++it) {
+        if (!filter.organizerID.empty() && it->first.organizerID != filter.organizerID) {
+            break;
+        }
+        if (matchesFilter(it->first, filter)) {
+            visit(it->first, it->second);
+        }
+    }
+}
+
+static RevenueCell sliceCells(const map<RevenueKey, RevenueCell>& cells, const RevenueFilter& filter) {
+    RevenueCell result;
+    forEachCell(cells, filter, [&](const RevenueKey&, const RevenueCell& cell) {
+        result.total += cell.total;
+        result.count += cell.count;
+        });
+    return result;
+}
+
+static map<string, RevenueCell> rollupCells(const map<RevenueKey, RevenueCell>& cells, RevenueDimension dimension, const RevenueFilter& filter) {
+    map<string, RevenueCell> result;
+    forEachCell(cells, filter, [&](const RevenueKey& key, const RevenueCell& cell) {
+        RevenueCell& group = result[dimensionValue(key, dimension)];
+        group.total += cell.total;
+        group.count += cell.count;
+        });
+    return result;
+}
+
+RevenueCell sliceBookingRevenue(const RevenueCube& cube, const RevenueFilter& filter) {
+    return sliceCells(cube.bookingCells, filter);
+}
+
+RevenueCell slicePaymentRevenue(const RevenueCube& cube, const RevenueFilter& filter) {
+    return sliceCells(cube.paymentCells, filter);
+}
+
+map<string, RevenueCell> rollupBookingRevenue(const RevenueCube& cube, RevenueDimension dimension, const RevenueFilter& filter) {
+    return rollupCells(cube.bookingCells, dimension, filter);
+}
+
+map<string, RevenueCell> rollupPaymentRevenue(const RevenueCube& cube, RevenueDimension dimension, const RevenueFilter& filter) {
+    return rollupCells(cube.paymentCells, dimension, filter);
+}
@@ -0,0 +1,81 @@
+#pragma once
+#ifndef REVENUE_CUBE_H
+#define REVENUE_CUBE_H
+
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "date.h"
+#include "money.h"
+using namespace std;
+
+// Dimensions of one rollup cell. organizerID leads the ordering so that
+// per-user reports can range-scan their own cells only.
+struct RevenueKey {
+    string organizerID;
+    string month;          // e.g. "2025-09"
+    string week;           // ISO week, e.g. "2025-W38"
+    string venueID;
+    string manufacturer;
+    string paymentMethod;  // empty for booking cost cells
+    string status;         // booking status or payment status
+
+    bool operator<(const RevenueKey& other) const;
+};
+
+// Pre-aggregated measures for one cell
+struct RevenueCell {
+    Money total;
+    int count = 0;
+};
+
+// Contribution of a single record, kept so it can be taken back out
+struct RevenueEntry {
+    RevenueKey key;
+    Money amount;
+};
+
+// Rollup store kept in step with bookings and payments
+struct RevenueCube {
+    map<RevenueKey, RevenueCell> bookingCells;   // finalCost by booking status
+    map<RevenueKey, RevenueCell> paymentCells;   // amount by payment method and status
+    unordered_map<string, RevenueEntry> bookingEntries; // bookingID -> contribution
+    unordered_map<string, RevenueEntry> paymentEntries; // paymentID -> contribution
+    unordered_map<string, vector<string>> paymentsByBooking; // bookingID -> paymentIDs
+};
+
+// Slice filter - empty fields match everything
+struct RevenueFilter {
+    string organizerID;
+    string month;
+    string week;
+    string venueID;
+    string manufacturer;
+    string paymentMethod;
+    string status;
+};
+
+enum class RevenueDimension { Month, Week, Venue, Manufacturer, PaymentMethod, Status };
+
+// Forward declarations
+struct EventBooking;
+struct Payment;
+class SystemData;
+
+string monthLabel(const Date& date);
+string isoWeekLabel(const Date& date);
+
+// Incremental maintenance - call after the record has been changed
+void recordBookingInCube(RevenueCube& cube, const EventBooking& booking);
+void removeBookingFromCube(RevenueCube& cube, const string& bookingID);
+void recordPaymentInCube(RevenueCube& cube, const Payment& payment, const EventBooking& booking);
+void rebuildRevenueCube(SystemData& data);
+
+// Slice and dice queries answered from the cells only
+RevenueCell sliceBookingRevenue(const RevenueCube& cube, const RevenueFilter& filter);
+RevenueCell slicePaymentRevenue(const RevenueCube& cube, const RevenueFilter& filter);
+map<string, RevenueCell> rollupBookingRevenue(const RevenueCube& cube, RevenueDimension dimension, const RevenueFilter& filter);
+map<string, RevenueCell> rollupPaymentRevenue(const RevenueCube& cube, RevenueDimension dimension, const RevenueFilter& filter);
+
+#endif
@@ -0,0 +1,189 @@
+#include "script_runner.h"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include "system_data.h"
+#include "console_input.h"
+#include "file_operation.h"
+#include "user.h"
+#include "event_registration.h"
+#include "event_booking.h"
+#include "event_payment.h"
+#include "event_monitoring.h"
+#include "feedback.h"
+#include "auto_scheduler.h"
+#include "waitlist.h"
+#include "booking_lifecycle.h"
+
+using namespace std;
+
+struct ScriptCommand {
+    string name;
+    bool needsLogin;
+    function<void(SystemData&)> action;
+};
+
+static void scriptLogin(SystemData& data) {
+    bool loggedIn = false;
+    loginUser(data, &loggedIn);
+}
+
+static void scriptLogout(SystemData& data) {
+    saveDataToFiles(data);
+    data.currentUser.clear();
+    cout << "Logged out." << endl;
+}
+
+static const vector<ScriptCommand>& scriptCommands() {
+    static const vector<ScriptCommand> commands = {
+        { "signUp", false, signUp },
+        { "login", false, scriptLogin },
+        { "logout", true, scriptLogout },
+        { "save", false, [](SystemData& data) { saveDataToFiles(data); } },
+        { "housekeeping", false, runHousekeeping },
+
+        { "viewUserProfile", true, viewUserProfile },
+        { "editUserProfile", true, editUserProfile },
+        { "changeUserPassword", true, changeUserPassword },
+
+        { "createEventRegistration", true, createEventRegistration },
+        { "viewEventRegistrations", true, viewEventRegistrations },
+        { "updateEventRegistration", true, updateEventRegistration },
+        { "deleteEventRegistration", true, deleteEventRegistration },
+        { "withdrawManufacturerSeason", true, withdrawManufacturerSeason },
+
+        { "createEventBooking", true, createEventBooking },
+        { "viewEventBookings", true, viewEventBookings },
+        { "updateEventBooking", true, updateEventBooking },
+        { "cancelEventBooking", true, cancelEventBooking },
+        { "autoScheduleEvents", true, autoScheduleEvents },
+        { "manageWaitlist", true, manageWaitlist },
+
+        { "makePayment", true, makePayment },
+        { "viewPaymentHistory", true, viewPaymentHistory },
+        { "processRefund", true, processRefund },
+        { "viewPaymentStatistics", true, viewPaymentStatistics },
+
+        { "displayEventSummary", true, displayEventSummary },
+        { "displayVenueUtilization", true, displayVenueUtilization },
+        { "displayFinancialReport", true, displayFinancialReport },
+        { "displayUpcomingEvents", true, displayUpcomingEvents },
+        { "displayRegistrationStatistics", true, displayRegistrationStatistics },
+        { "searchEvents", true, searchEvents },
+        { "generateEventReport", true, generateEventReport },
+        { "displayRevenueDrillDown", true, displayRevenueDrillDown },
+
+        { "submitEventFeedback", true, submitEventFeedback },
+        { "viewAllFeedback", true, viewAllFeedback },
+        { "viewFeedbackStatistics", true, viewFeedbackStatistics },
+        { "searchFeedbackComments", true, searchFeedbackComments },
+        { "deleteFeedback", true, deleteFeedback },
+    };
+    return commands;
+}
+
+static const ScriptCommand* findScriptCommand(const string& name) {
+    for (const auto& command : scriptCommands()) {
+        if (command.name == name) {
+            return &command;
+        }
+    }
+    return nullptr;
+}
+
+vector<string> splitScriptLine(const string& line) {
+    vector<string> words;
+    string word;
+    bool inWord = false, quoted = false;
+    for (char c : line) {
+        if (c == '"') {
+            quoted = !quoted;
+            inWord = true;
+        }
+        else if (!quoted && (c == ' ' || c == '\t' || c == '\r')) {
+            if (inWord) {
+                words.push_back(word);
+                word.clear();
+                inWord = false;
+            }
+        }
+        else {
+            word += c;
+            inWord = true;
+        }
+    }
+    if (inWord) {
+        words.push_back(word);
+    }
+    return words;
+}
+
+int runScript(SystemData& data, istream& script) {
+    bool wasHeadless = isHeadless();
+    setHeadless(true);
+
+    string line;
+    int lineNumber = 0, commandCount = 0, failures = 0;
+    double totalMs = 0;
+
+    while (getline(script, line)) {
+        lineNumber++;
+        vector<string> words = splitScriptLine(line);
+        if (words.empty() || words[0][0] == '#') {
+            continue;
+        }
+        commandCount++;
+
+        const ScriptCommand* command = findScriptCommand(words[0]);
+        if (command == nullptr) {
+            cout << "[script] line " << lineNumber << ": unknown command '" << words[0] << "'" << endl;
+            failures++;
+            continue;
+        }
+        if (command->needsLogin && data.currentUser.empty()) {
+            cout << "[script] line " << lineNumber << ": " << command->name << " needs a logged-in user" << endl;
+            failures++;
+            continue;
+        }
+
+        queueScriptedAnswers(deque<string>(words.begin() + 1, words.end()));
+        string error;
+        auto start = chrono::steady_clock::now();
+        try {
+            // Same menu-boundary jobs an interactive session runs between screens
+            if (command->needsLogin) {
+                runHousekeeping(data);
+            }
+            command->action(data);
+        }
+        catch (const ScriptInputExhausted& e) {
+            error = e.what();
+        }
+        catch (const ScriptInputRejected& e) {
+            error = e.what();
+        }
+        catch (const exception& e) {
+            error = string("error: ") + e.what();
+        }
+        double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        totalMs += elapsedMs;
+
+        size_t unused = discardScriptedAnswers();
+        cout << "[script] line " << lineNumber << ": " << command->name << " "
+            << (error.empty() ? "ok" : "FAILED (" + error + ")")
+            << " in " << fixed << setprecision(3) << elapsedMs << " ms";
+        if (unused > 0) {
+            cout << ", " << unused << " unused argument(s)";
+        }
+        cout << endl;
+        if (!error.empty()) {
+            failures++;
+        }
+    }
+
+    cout << "[script] " << commandCount << " command(s), " << failures << " failed, "
+        << fixed << setprecision(3) << totalMs << " ms total" << endl;
+    setHeadless(wasHeadless);
+    return failures;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#ifndef SCRIPT_RUNNER_H
+#define SCRIPT_RUNNER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Forward declarations
+class SystemData;
+
+// Headless command layer. A script holds one command per line:
+//   login USER1001 Secret123
+//   createEventBooking 1 2026 12 5 1 1 Y 1 0
+//   makePayment 1 "" 1 4111111111111111 "Alice Tan" 12/28 123
+// The first word names a menu action and the remaining words answer its
+// prompts in order (quote an answer to keep spaces, "" for an empty one).
+// Lines starting with # are comments. A command fails, without blocking,
+// when it runs out of answers or a prompt rejects one. Runs with no
+// screen clears or pauses, reports the time taken by every command and
+// returns how many commands failed.
+int runScript(SystemData& data, istream& script);
+
+// Splits a command line into words, honouring double quotes
+vector<string> splitScriptLine(const string& line);
+
+#endif
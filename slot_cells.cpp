@@ -0,0 +1,187 @@
+#include "slot_cells.h"
+#include <algorithm>
+#include "date.h"
+#include "timeslot.h"
+
+using namespace std;
+
+// Cells per year are laid out [day of year][slot][venue] so one slot on one
+// day is a contiguous run across venues
+static const int DAYS_PER_YEAR = 366;
+
+SlotCells::SlotCells() {
+    for (auto& year : years) {
+        year.store(nullptr, memory_order_relaxed);
+    }
+}
+
+SlotCells::~SlotCells() {
+    freeYears();
+}
+
+void SlotCells::freeYears() {
+    for (auto& year : years) {
+        delete[] year.exchange(nullptr);
+    }
+}
+
+void SlotCells::reset(int venueCount, int slotCount) {
+    freeYears();
+    this->venueCount = venueCount;
+    this->slotCount = slotCount;
+    openDays.clear();
+    closures.clear();
+}
+
+void SlotCells::setCalendar(vector<uint8_t> openDays, vector<ClosedRange> closures) {
+    this->openDays = move(openDays);
+    this->closures = move(closures);
+}
+
+void SlotCells::closeCells(atomic<uint32_t>* block, int year) const {
+    int firstDay = Date{ year, 1, 1 }.toDayNumber();
+    int lastDay = Date{ year, 12, 31 }.toDayNumber();
+    auto at = [&](int dayNumber, int slot, int venue) -> atomic<uint32_t>& {
+        return block[(static_cast<size_t>(dayNumber - firstDay) * slotCount + slot) * venueCount + venue];
+    };
+
+    if (!openDays.empty()) {
+        for (int day = firstDay; day <= lastDay; day++) {
+            uint8_t weekday = static_cast<uint8_t>(1 << weekdayOf(day));
+            for (int slot = 0; slot < slotCount; slot++) {
+                for (int venue = 0; venue < venueCount; venue++) {
+                    if ((openDays[static_cast<size_t>(venue) * slotCount + slot] & weekday) == 0) {
+                        at(day, slot, venue).store(CLOSED_TOKEN, memory_order_relaxed);
+                    }
+                }
+            }
+        }
+    }
+
+    for (const auto& closure : closures) {
+        int from = max(closure.firstDay, firstDay);
+        int to = min(closure.lastDay, lastDay);
+        for (int day = from; day <= to; day++) {
+            for (int slot = 0; slot < slotCount; slot++) {
+                if (closure.slot != -1 && closure.slot != slot) {
+                    continue;
+                }
+                for (int venue = 0; venue < venueCount; venue++) {
+                    if (closure.venue == -1 || closure.venue == venue) {
+                        at(day, slot, venue).store(CLOSED_TOKEN, memory_order_relaxed);
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool SlotCells::closedByCalendar(int venue, int dayNumber, int slot) const {
+    if (!openDays.empty() &&
+        (openDays[static_cast<size_t>(venue) * slotCount + slot] & (1 << weekdayOf(dayNumber))) == 0) {
+        return true;
+    }
+    for (const auto& closure : closures) {
+        if (dayNumber >= closure.firstDay && dayNumber <= closure.lastDay &&
+            (closure.slot == -1 || closure.slot == slot) && (closure.venue == -1 || closure.venue == venue)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+atomic<uint32_t>* SlotCells::allocatedCell(int venue, int dayNumber, int slot) const {
+    if (!covers(venue, dayNumber, slot)) {
+        return nullptr;
+    }
+    Date date = Date::fromDayNumber(dayNumber);
+    atomic<uint32_t>* block = years[date.year - FIRST_YEAR].load(memory_order_acquire);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    int dayOfYear = dayNumber - Date{ date.year, 1, 1 }.toDayNumber();
+    return &block[(static_cast<size_t>(dayOfYear) * slotCount + slot) * venueCount + venue];
+}
+
+atomic<uint32_t>* SlotCells::cell(int venue, int dayNumber, int slot) {
+    if (!covers(venue, dayNumber, slot)) {
+        return nullptr;
+    }
+    Date date = Date::fromDayNumber(dayNumber);
+    int yearIndex = date.year - FIRST_YEAR;
+
+    atomic<uint32_t>* block = years[yearIndex].load(memory_order_acquire);
+    if (block == nullptr) {
+        // Install a zeroed year; if another thread got there first use theirs
+        size_t size = static_cast<size_t>(DAYS_PER_YEAR) * slotCount * venueCount;
+        atomic<uint32_t>* fresh = new atomic<uint32_t>[size];
+        for (size_t i = 0; i < size; i++) {
+            fresh[i].store(0, memory_order_relaxed);
+        }
+        closeCells(fresh, FIRST_YEAR + yearIndex);
+        if (years[yearIndex].compare_exchange_strong(block, fresh, memory_order_acq_rel)) {
+            block = fresh;
+        }
+        else {
+            delete[] fresh;
+        }
+    }
+
+    int dayOfYear = dayNumber - Date{ date.year, 1, 1 }.toDayNumber();
+    return &block[(static_cast<size_t>(dayOfYear) * slotCount + slot) * venueCount + venue];
+}
+
+ReserveResult SlotCells::claim(int venue, int dayNumber, int slot, uint32_t token) {
+    atomic<uint32_t>* target = cell(venue, dayNumber, slot);
+    if (target == nullptr || token == 0) {
+        return ReserveResult::OutOfRange;
+    }
+    uint32_t expected = 0;
+    if (target->compare_exchange_strong(expected, token, memory_order_acq_rel)) {
+        return ReserveResult::Claimed;
+    }
+    // Claiming a cell the token already owns is not a conflict
+    return expected == token ? ReserveResult::Claimed : ReserveResult::Conflict;
+}
+
+bool SlotCells::release(int venue, int dayNumber, int slot, uint32_t token) {
+    atomic<uint32_t>* target = allocatedCell(venue, dayNumber, slot);
+    if (target == nullptr) {
+        return false;
+    }
+    uint32_t expected = token;
+    return target->compare_exchange_strong(expected, 0, memory_order_acq_rel);
+}
+
+bool SlotCells::covers(int venue, int dayNumber, int slot) const {
+    if (venue < 0 || venue >= venueCount || slot < 0 || slot >= slotCount) {
+        return false;
+    }
+    int yearIndex = Date::fromDayNumber(dayNumber).year - FIRST_YEAR;
+    return yearIndex >= 0 && yearIndex < YEAR_COUNT;
+}
+
+uint32_t SlotCells::owner(int venue, int dayNumber, int slot) const {
+    const atomic<uint32_t>* target = allocatedCell(venue, dayNumber, slot);
+    if (target != nullptr) {
+        return target->load(memory_order_acquire);
+    }
+    // Nothing claimed that year yet: only the calendar can have closed it
+    return covers(venue, dayNumber, slot) && closedByCalendar(venue, dayNumber, slot) ? CLOSED_TOKEN : 0;
+}
+
+uint32_t reservationToken(const string& bookingID) {
+    if (bookingID.size() > 3 && bookingID.compare(0, 3, "BKG") == 0 &&
+        bookingID.find_first_not_of("0123456789", 3) == string::npos && bookingID.size() <= 12) {
+        uint32_t number = static_cast<uint32_t>(stoul(bookingID.substr(3)));
+        if (number != 0 && number < CLOSED_TOKEN) {
+            return number;
+        }
+    }
+    // FNV-1a with the top bit set, so it never collides with a booking number or 0
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : bookingID) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash | 0x80000000u;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef SLOT_CELLS_H
+#define SLOT_CELLS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+enum class ReserveResult { Claimed, Conflict, OutOfRange };
+
+// Owner token of cells the venue calendar keeps closed; never released
+const uint32_t CLOSED_TOKEN = 0x7FFFFFFFu;
+
+// Days [firstDay, lastDay] closed for one venue and slot (-1 = all of them)
+struct ClosedRange {
+    int venue;
+    int slot;
+    int firstDay;
+    int lastDay;
+};
+
+// Claim state of every (venue, day, time slot) cell. A cell holds the
+// owner's token, or 0 when free, and changes only by compare-and-swap:
+// when several sessions race for one slot exactly one wins and the rest
+// see Conflict straight away. Releasing is a CAS back to 0 by the owner.
+// Storage is allocated one calendar year at a time by the first claim, and
+// each year starts with the operating calendar's closed cells already
+// owned by CLOSED_TOKEN, so a closed slot costs nothing extra to check.
+// Reading a year nobody has claimed in asks the calendar instead.
+class SlotCells {
+public:
+    static const int FIRST_YEAR = 2000;
+    static const int YEAR_COUNT = 100;
+
+    SlotCells();
+    ~SlotCells();
+    SlotCells(const SlotCells&) = delete;
+    SlotCells& operator=(const SlotCells&) = delete;
+
+    // Drop every claim and resize; not safe while other threads use the cells
+    void reset(int venueCount, int slotCount);
+
+    // Operating calendar applied to every year as it is allocated.
+    // openDays[venue * slots + slot] holds the weekday bits (Sunday first)
+    // the slot runs on. Set right after reset, before any claim.
+    void setCalendar(vector<uint8_t> openDays, vector<ClosedRange> closures);
+
+    ReserveResult claim(int venue, int dayNumber, int slot, uint32_t token);
+    bool release(int venue, int dayNumber, int slot, uint32_t token);   // false if not the owner
+    uint32_t owner(int venue, int dayNumber, int slot) const;           // 0 when free, CLOSED_TOKEN when closed
+    bool covers(int venue, int dayNumber, int slot) const;              // false where claim gives OutOfRange
+
+    int venues() const { return venueCount; }
+    int slots() const { return slotCount; }
+
+private:
+    atomic<atomic<uint32_t>*> years[YEAR_COUNT];
+    int venueCount = 0;
+    int slotCount = 0;
+    vector<uint8_t> openDays;           // empty = always open
+    vector<ClosedRange> closures;
+
+    atomic<uint32_t>* cell(int venue, int dayNumber, int slot);                     // allocates the year
+    atomic<uint32_t>* allocatedCell(int venue, int dayNumber, int slot) const;      // nullptr if not allocated
+    bool closedByCalendar(int venue, int dayNumber, int slot) const;
+    void closeCells(atomic<uint32_t>* block, int year) const;
+    void freeYears();
+};
+
+// Owner token for a booking: the number in "BKG2001", or a hash for other
+// IDs. Never 0 or CLOSED_TOKEN.
+uint32_t reservationToken(const string& bookingID);
+
+#endif
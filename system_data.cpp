@@ -1,12 +1,17 @@
 #include "system_data.h"
 #include <string>
 #include "file_operation.h"
+#include "worker_pool.h"
 using namespace std;
 
 // Constructor calls initializeSampleData automatically
-SystemData::SystemData() {
-    initializeSampleData();
-    loadAllData();
+SystemData::SystemData() : SystemData(true) {}
+
+SystemData::SystemData(bool loadFiles) {
+    if (loadFiles) {
+        initializeSampleData();
+        loadAllData();
+    }
 }
 
 // Initialize sample venues
@@ -25,7 +30,7 @@ void SystemData::initializeSampleData() {
             venue.venueName = venueData[i][1];
             venue.address = venueData[i][2];
             venue.capacity = stoi(venueData[i][3]);
-            venue.rentalCost = stod(venueData[i][4]);
+            venue.rentalCost = Money::parse(venueData[i][4]);
             venue.contactPerson = venueData[i][5];
             venue.phoneNumber = venueData[i][6];
             venues.push_back(venue);
@@ -61,5 +66,38 @@ void SystemData::loadAllData() {
     loadFeedbackFromFile(feedbacks);
     cout << "Loaded " << feedbacks.size() << " feedbacks." << endl;
 
+    // Each index reads only what is loaded by now and fills its own member,
+    // so they are built side by side on the background pool while the rest
+    // loads here
+    cout << "Building revenue rollups and feedback indexes..." << endl;
+    WorkerPool& pool = backgroundPool();
+    vector<TaskFuture<void>> indexes;
+    indexes.push_back(pool.submit(TaskPriority::Bulk, "revenue rollups", [this] { rebuildRevenueCube(*this); }));
+    indexes.push_back(pool.submit(TaskPriority::Bulk, "feedback ratings", [this] { rebuildFeedbackStore(*this); }));
+    indexes.push_back(pool.submit(TaskPriority::Bulk, "rating trends", [this] { rebuildRatingTrends(*this); }));
+    indexes.push_back(pool.submit(TaskPriority::Bulk, "feedback comments", [this] { rebuildFeedbackSearch(*this); }));
+
+    cout << "Loading venue calendars..." << endl;
+    loadTimeSlotConfig(timeConfig);
+    indexes.push_back(pool.submit(TaskPriority::Bulk, "venue availability", [this] { rebuildVenueIndex(*this); }));
+
+    cout << "Loading waitlists..." << endl;
+    loadWaitlistFromFile(waitlist);
+    linkWaitlistRegistrations(*this);
+
+    cout << "Loading payment holds..." << endl;
+    loadHoldsFromFile(holds);
+
+    // Adopting pending bookings changes what the indexes read
+    for (auto& index : indexes) {
+        index.get();
+    }
+    cout << "Built " << revenue.bookingCells.size() + revenue.paymentCells.size() << " revenue cells." << endl;
+    cout << "Indexed " << feedbackRatings.rowOf.size() << " feedback ratings." << endl;
+    cout << "Indexed " << feedbackSearch.postings.size() << " distinct terms." << endl;
+    cout << "Indexed venue availability." << endl;
+    adoptPendingBookings(*this, currentTimestamp());
+    rebuildLifecycleIndex(*this);
+
     cout << "=== DATA LOADING COMPLETED ===" << endl;
 }
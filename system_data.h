@@ -9,19 +9,42 @@
 #include "timeslot.h"
 #include "event_payment.h"
 #include "feedback.h"
+#include "revenue_cube.h"
+#include "feedback_store.h"
+#include "rating_trends.h"
+#include "feedback_search.h"
+#include "venue_index.h"
+#include "waitlist.h"
+#include "booking_holds.h"
+#include "booking_lifecycle.h"
+#include "data_locks.h"
+#include "data_snapshot.h"
+#include "change_feed.h"
 using namespace std;
 
 struct SystemData {
     string currentUser;
     vector<Venue> venues;
     vector<Organizer> organizer;
-    vector<EventRegistration> registrations;
-    vector<EventBooking> bookings;
+    RegistrationTable registrations;
+    BookingTable bookings;
     TimeSlotConfig timeConfig; 
-    vector<EventFeedback> feedbacks;
+    FeedbackTable feedbacks;
     vector<Payment> payments;
+    RevenueCube revenue; // pre-aggregated booking and payment sums
+    FeedbackRatingStore feedbackRatings; // columnar copy of feedback ratings per user
+    RatingTrendStore ratingTrends; // rolling rating windows per organizer and venue
+    FeedbackSearchIndex feedbackSearch; // inverted index over feedback comments
+    VenueIndex venueIndex; // capacity/cost orderings and slot availability
+    WaitlistBook waitlist; // queued registrations per fully booked venue slot
+    HoldBook holds; // payment deadlines of Pending bookings
+    LifecycleIndex lifecycle; // Confirmed bookings by event day, for auto-completion
+    mutable DataLocks locks; // for sessions sharing one SystemData across threads
+    mutable SnapshotStore snapshots; // copies pinned by reports, see data_snapshot.h
+    ChangeFeed changes; // every committed mutation, for sinks outside the data
 
     SystemData();
+    explicit SystemData(bool loadFiles); // false: start empty, e.g. for benchmarks
     void initializeSampleData();
     void loadAllData();
 };
@@ -0,0 +1,108 @@
+#include "table_format.h"
+#include <charconv>
+#include <format>
+#include <iostream>
+#include "console_input.h"
+
+using namespace std;
+
+// ---- PagedOutput ----
+
+PagedOutput::PagedOutput(size_t pageItems, size_t totalItems)
+    : pageItems(pageItems), totalItems(totalItems) {
+}
+
+PagedOutput::~PagedOutput() {
+    flush();
+}
+
+bool PagedOutput::beginItem() {
+    if (stopped) {
+        return false;
+    }
+    if (shown > 0 && shown % pageItems == 0 && !isHeadless()) {
+        flush();
+        if (totalItems > 0) {
+            cout << format("-- Showing {} of {}. Press Enter for more, or Q to stop: ", shown, totalItems);
+        }
+        else {
+            cout << format("-- Showing {} so far. Press Enter for more, or Q to stop: ", shown);
+        }
+        string answer;
+        if (!readInputLine(answer) || answer == "q" || answer == "Q") {
+            stopped = true;
+            return false;
+        }
+    }
+    shown++;
+    return true;
+}
+
+void PagedOutput::flush() {
+    if (!text.empty()) {
+        cout.write(text.data(), static_cast<streamsize>(text.size()));
+        text.clear();       // keeps its capacity for the next page
+    }
+}
+
+// ---- TableWriter ----
+
+TableWriter::TableWriter(span<const TableColumn> columns, size_t totalRows)
+    : PagedOutput(TABLE_PAGE_ROWS, totalRows), columns(columns) {
+}
+
+void TableWriter::header() {
+    for (const auto& column : columns) {
+        text += column.header;
+        if (static_cast<int>(column.header.size()) < column.width) {
+            text.append(column.width - column.header.size(), ' ');
+        }
+    }
+    text += '\n';
+}
+
+void TableWriter::rule(char fill, int width) {
+    text.append(width, fill);
+    text += '\n';
+}
+
+void TableWriter::cell(const TableColumn& column, string_view value) {
+    size_t room = column.width > static_cast<int>(column.prefix.size())
+        ? column.width - column.prefix.size() : 0;
+    size_t fits = room > 0 ? room - 1 : 0;      // leaving the gap
+    if (column.clip && value.size() > fits) {
+        value = value.substr(0, fits);
+    }
+    text += column.prefix;
+    if (column.align == CellAlign::Right) {
+        if (value.size() < fits) {
+            text.append(fits - value.size(), ' ');
+        }
+        text += value;
+        text += ' ';
+    }
+    else {
+        text += value;
+        if (value.size() < room) {
+            text.append(room - value.size(), ' ');
+        }
+    }
+}
+
+void TableWriter::cell(const TableColumn& column, long long value) {
+    char digits[24];
+    char* end = to_chars(digits, digits + sizeof(digits), value).ptr;
+    cell(column, string_view(digits, end - digits));
+}
+
+void TableWriter::cell(const TableColumn& column, const Money& value) {
+    char digits[32];
+    char* end = value.formatTo(digits);
+    cell(column, string_view(digits, end - digits));
+}
+
+void TableWriter::cell(const TableColumn& column, const Date& value) {
+    char digits[40];
+    char* end = value.formatTo(digits);
+    cell(column, string_view(digits, end - digits));
+}
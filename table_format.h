@@ -0,0 +1,94 @@
+#pragma once
+#ifndef TABLE_FORMAT_H
+#define TABLE_FORMAT_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "money.h"
+#include "date.h"
+using namespace std;
+
+enum class CellAlign : uint8_t { Left, Right };
+
+// One column of a listing. Each report declares its columns once, as a
+// constexpr array. width is the whole cell including the gap before the
+// next column. With clip, longer text is cut to width - 1; without it,
+// longer text runs over, as setw did. A right-aligned cell always keeps
+// its gap. Headings are left-aligned in the full width.
+struct TableColumn {
+    string_view header;
+    int width = 0;
+    bool clip = false;
+    CellAlign align = CellAlign::Left;
+    string_view prefix = {};    // e.g. "RM ", part of width
+};
+
+// Rows per page of a table
+const size_t TABLE_PAGE_ROWS = 40;
+
+// Output of a listing that may run to tens of thousands of items. Items
+// are rendered into one buffer, reused for the whole listing, and written
+// out a page at a time. While someone is reading, a full page asks
+// whether to go on before the next item. Scripts are never paged.
+class PagedOutput {
+public:
+    // totalItems only labels the prompt; 0 when not known up front
+    explicit PagedOutput(size_t pageItems, size_t totalItems = 0);
+    ~PagedOutput();             // writes what is left
+    PagedOutput(const PagedOutput&) = delete;
+    PagedOutput& operator=(const PagedOutput&) = delete;
+
+    // Call before rendering each item; false once the reader has stopped
+    bool beginItem();
+    string& buffer() { return text; }
+    void flush();
+
+protected:
+    string text;
+
+private:
+    size_t pageItems;
+    size_t totalItems;
+    size_t shown = 0;
+    bool stopped = false;
+};
+
+class TableWriter : public PagedOutput {
+public:
+    explicit TableWriter(span<const TableColumn> columns, size_t totalRows = 0);
+
+    void header();
+    void rule(char fill, int width);
+
+    // One cell per column, in order; false (and nothing written) once the
+    // reader has stopped
+    template <typename... Cells>
+    bool row(const Cells&... cells);
+
+private:
+    span<const TableColumn> columns;
+
+    void cell(const TableColumn& column, string_view value);
+    void cell(const TableColumn& column, long long value);
+    void cell(const TableColumn& column, const Money& value);
+    void cell(const TableColumn& column, const Date& value);
+
+    template <typename T> requires is_integral_v<T>
+    void cell(const TableColumn& column, T value) { cell(column, static_cast<long long>(value)); }
+};
+
+template <typename... Cells>
+bool TableWriter::row(const Cells&... cells) {
+    if (!beginItem()) {
+        return false;
+    }
+    size_t index = 0;
+    (cell(columns[index++], cells), ...);
+    text += '\n';
+    return true;
+}
+
+#endif
@@ -3,4 +3,9 @@
 
 string TimeSlot::getDateString() const {
     return date.toString();
+}
+
+int weekdayOf(int dayNumber) {
+    // Day 0 (1970-01-01) was a Thursday
+    return ((dayNumber % 7) + 11) % 7;
 }
\ No newline at end of file
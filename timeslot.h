@@ -4,13 +4,38 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
 #include "date.h"
 using namespace std;
 
-// Time slot configuration
+// Weekday bits for VenueHours::openDays, Sunday first
+const uint8_t EVERY_WEEKDAY = 0x7F;
+int weekdayOf(int dayNumber);           // 0 = Sunday
+
+// Slots a venue runs and the weekdays it opens. Venues without an entry
+// run every slot every day.
+struct VenueHours {
+    string venueID;
+    vector<string> slots;
+    uint8_t openDays = EVERY_WEEKDAY;
+};
+
+// Maintenance blackout or public holiday, inclusive. An empty venueID or
+// time closes every venue or every slot.
+struct SlotClosure {
+    string venueID;
+    Date from;
+    Date to;
+    string time;
+    string reason;
+};
+
+// Time slot configuration, loaded from timeslots.txt when present
 struct TimeSlotConfig {
     vector<string> timeSlots;
     vector<string> timeSlotNames;
+    vector<VenueHours> venueHours;
+    vector<SlotClosure> closures;
 
     TimeSlotConfig() {
         timeSlots = { "09:00-13:00", "17:00-21:00" };
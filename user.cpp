@@ -139,9 +139,19 @@ void signUp(SystemData& data) {
     displayUserInfo(currentUser);
     data.organizer.push_back(currentUser);
     saveUsersToFile(data.organizer);
+    data.changes.publish(ChangeKind::UserCreated, currentUser.userID, currentUser.userID);
     data.currentUser = currentUser.userID;
 }
 
+Organizer* findLoginUser(vector<Organizer>& users, const string& userID, const string& password) {
+    for (auto& user : users) {
+        if ((user.userID == userID || user.organizerEmail == userID) && (password == user.password)) {
+            return &user;
+        }
+    }
+    return nullptr;
+}
+
 void loginUser(SystemData& data, bool *validation) {
     clearScreen();
     while (true)
@@ -162,58 +172,55 @@ void loginUser(SystemData& data, bool *validation) {
             confirmExit();
             return;
         }
-        cin.ignore();
 
         //// Normalize input for comparison
         //string normalizedInputID = normalizeUserID(userID);
 
         // Find user with normalized comparison
-        for (auto& user : data.organizer) {
-            //string normalizedStoredID = normalizeUserID(user.userID);
-
-            if ((user.userID == userID || user.organizerEmail == userID) && (password == user.password)) {
-                user.isLoggedIn = true;
-
-                // CRITICAL: Store the ORIGINAL userID from file, not the input
-                data.currentUser = user.userID;  // Use the stored version
-
-                cout << "Login successful!" << endl;
-                cout << "Welcome, " << user.organizerName << "!" << endl;
-
-                // Debug output to verify IDs match
-                //cout << "\n=== DEBUG INFO ===" << endl;
-                //cout << "Input userID: '" << userID << "'" << endl;
-                //cout << "Stored userID: '" << user.userID << "'" << endl;
-                //cout << "Current user set to: '" << data.currentUser << "'" << endl;
-
-                //// Count user's data immediately
-                //int userRegistrations = 0;
-                //int userBookings = 0;
-
-                //for (const auto& reg : data.registrations) {
-                //    cout << "Checking registration " << reg.eventID
-                //        << " with userID: '" << reg.organizer.userID << "'" << endl;
-                //    if (normalizeUserID(reg.organizer.userID) == normalizedStoredID) {
-                //        userRegistrations++;
-                //    }
-                //}
-
-                //for (const auto& booking : data.bookings) {
-                //    cout << "Checking booking " << booking.bookingID
-                //        << " with userID: '" << booking.eventReg.organizer.userID << "'" << endl;
-                //    if (normalizeUserID(booking.eventReg.organizer.userID) == normalizedStoredID) {
-                //        userBookings++;
-                //    }
-                //}
-
-                //cout << "Found " << userRegistrations << " registrations and "
-                //    << userBookings << " bookings for this user." << endl;
-                //cout << "==================" << endl;
-
-                saveUsersToFile(data.organizer);
-                *validation = true;
-                return;
-            }
+        Organizer* found = findLoginUser(data.organizer, userID, password);
+        if (found != nullptr) {
+            Organizer& user = *found;
+            user.isLoggedIn = true;
+
+            // CRITICAL: Store the ORIGINAL userID from file, not the input
+            data.currentUser = user.userID;  // Use the stored version
+
+            cout << "Login successful!" << endl;
+            cout << "Welcome, " << user.organizerName << "!" << endl;
+
+            // Debug output to verify IDs match
+            //cout << "\n=== DEBUG INFO ===" << endl;
+            //cout << "Input userID: '" << userID << "'" << endl;
+            //cout << "Stored userID: '" << user.userID << "'" << endl;
+            //cout << "Current user set to: '" << data.currentUser << "'" << endl;
+
+            //// Count user's data immediately
+            //int userRegistrations = 0;
+            //int userBookings = 0;
+
+            //for (const auto& reg : data.registrations) {
+            //    cout << "Checking registration " << reg.eventID
+            //        << " with userID: '" << reg.organizer.userID << "'" << endl;
+            //    if (normalizeUserID(reg.organizer.userID) == normalizedStoredID) {
+            //        userRegistrations++;
+            //    }
+            //}
+
+            //for (const auto& booking : data.bookings) {
+            //    cout << "Checking booking " << booking.bookingID
+            //        << " with userID: '" << booking.eventReg.organizer.userID << "'" << endl;
+            //    if (normalizeUserID(booking.eventReg.organizer.userID) == normalizedStoredID) {
+            //        userBookings++;
+            //    }
+            //}
+
+            //cout << "Found " << userRegistrations << " registrations and "
+            //    << userBookings << " bookings for this user." << endl;
+            //cout << "==================" << endl;
+
+            saveUsersToFile(data.organizer);
+            *validation = true;
+            return;
         }
         clearScreen();
         cout << "Invalid User ID or Password! \nTips: Enter your User ID with capital letter. " << endl;
@@ -324,7 +331,7 @@ void viewUserProfile(SystemData& data) {
     int approvedBookings = 0;
     int completedBookings = 0;
     int cancelledBookings = 0;
-    double totalSpent = 0.0;
+    Money totalSpent;
 
     for (const auto& booking : data.bookings) {
         if (booking.eventReg.organizer.userID == data.currentUser) {
@@ -371,7 +378,7 @@ void viewUserProfile(SystemData& data) {
     cout << left << setw(20) << "Approved:" << approvedBookings << endl;
     cout << left << setw(20) << "Completed:" << completedBookings << endl;
     cout << left << setw(20) << "Cancelled:" << cancelledBookings << endl;
-    cout << left << setw(20) << "Total Spent:" << "RM " << fixed << setprecision(2) << totalSpent << endl;
+    cout << left << setw(20) << "Total Spent:" << "RM " << totalSpent << endl;
 
     cout << "\n--- FEEDBACK HISTORY ---" << endl;
     cout << left << setw(20) << "Total Feedbacks:" << totalFeedbacks << endl;
@@ -471,6 +478,7 @@ void editUserProfile(SystemData& data) {
 
     // Save updated information
     saveUsersToFile(data.organizer);
+    data.changes.publish(ChangeKind::UserUpdated, data.organizer[userIndex].userID, data.organizer[userIndex].userID);
     cout << "\nProfile updated successfully!" << endl;
     cout << "\nUpdated Information:" << endl;
     displayUserInfo(data.organizer[userIndex]);
@@ -524,6 +532,7 @@ void changeUserPassword(SystemData& data) {
     // Update password
     strcpy_s(data.organizer[userIndex].password, newPassword.c_str());
     saveUsersToFile(data.organizer);
+    data.changes.publish(ChangeKind::UserUpdated, data.organizer[userIndex].userID, data.organizer[userIndex].userID);
 
     cout << "Password changed successfully!" << endl;
 }
@@ -572,7 +581,7 @@ void viewMyEventRegistrations(const SystemData& data) {
             << setw(20) << reg.eventTitle.substr(0, 19)
             << setw(15) << reg.manufacturer.substr(0, 14)
             << setw(8) << reg.expectedGuests
-            << "RM " << setw(9) << fixed << setprecision(2) << reg.estimatedBudget
+            << "RM " << setw(9) << reg.estimatedBudget
             << setw(12) << reg.eventStatus << endl;
     }
     cout << setfill('=') << setw(100) << "=" << setfill(' ') << endl;
@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 using namespace std;
 
 struct Organizer {
@@ -24,6 +25,7 @@ class SystemData;
 // Function prototypes - User Menu
 void signUp(SystemData& data);
 void loginUser(SystemData& data, bool *validation);
+Organizer* findLoginUser(vector<Organizer>& users, const string& userID, const string& password);  // by ID or email
 void displayUserInfo(const Organizer& organizer);
 bool IsIdDuplicateEmail(const string& email);
 bool IsIdDuplicatePhoneNumber(const string& phoneNo);
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <cstdlib>
 #include <regex>
+#include <charconv>
 #include "date.h"
 #include "venue.h"
 #include "event_registration.h"
@@ -17,6 +18,8 @@
 #include "utility_fun.h"
 #include "input_validation.h"
 #include "file_operation.h"
+#include "clock.h"
+#include "console_output.h"
 
 using namespace std;
 
@@ -50,6 +53,9 @@ string getCurrentUserName(const SystemData& data) {
 // Display system logo
 void displayLogo() {
     clearScreen();
+    if (isHeadless()) {
+        return;
+    }
     cout << endl;
     cout << "	.----------------.  .----------------.  .----------------. " << endl;
     cout << "	| .--------------. || .--------------. || .--------------. | " << endl;
@@ -85,6 +91,17 @@ void displayLogo() {
 
 // Clear screen function
 void clearScreen() {
+    if (isHeadless()) {
+        return;
+    }
+    if (hasThreadInputSource()) {
+        cout << "\033[2J\033[H" << flush;   // the remote terminal, not ours
+        return;
+    }
+    if (consoleScreensActive()) {
+        clearConsoleScreen();
+        return;
+    }
 #ifdef _WIN32
     system("cls");
 #else
@@ -93,12 +110,8 @@ void clearScreen() {
 }
 
 Date getCurrentDate() {
-    // For demonstration purposes - in real application, use system date
-    Date current;
-    current.year = 2025;
-    current.month = 9;
-    current.day = 20;
-    return current;
+    // Read through the active clock so tests and demos can pin or move "today"
+    return dateOfTimestamp(currentTimestamp());
 }
 
 string generateUserID(const vector<Organizer>& user) {
@@ -106,7 +119,7 @@ string generateUserID(const vector<Organizer>& user) {
     return "USER" + to_string(nextNumber);
 }
 
-string generateEventID(const vector<EventRegistration>& registrations) {
+string generateEventID(const RegistrationTable& registrations) {
     int maxNumber = 1000; // Starting base number (so first ID will be EVT1001)
 
     // Parse all existing event IDs to find the maximum number
@@ -131,17 +144,16 @@ string generateEventID(const vector<EventRegistration>& registrations) {
     return "EVT" + to_string(nextNumber);
 }
 
-string generateBookingID(const vector<EventBooking>& bookings) {
+string generateBookingID(const BookingTable& bookings) {
     int maxNumber = 2000;
 
     for (const auto& booking : bookings) {
-        // Extract the number part using stringstream
-        string numberPart = booking.bookingID.substr(3); // Remove "BKG" prefix
-        stringstream ss(numberPart);
-        int currentNumber;
-
-        // Try to convert the number part to integer
-        if (ss >> currentNumber) {
+        // Parse the number part in place, skipping the "BKG" prefix; runs
+        // for every booking on every new booking, so no stream per ID
+        const string& bookingID = booking.bookingID;
+        int currentNumber = 0;
+        if (bookingID.size() > 3 &&
+            from_chars(bookingID.data() + 3, bookingID.data() + bookingID.size(), currentNumber).ec == errc()) {
             // Successfully parsed the entire string as a number
             if (currentNumber > maxNumber) {
                 maxNumber = currentNumber;
@@ -168,6 +180,19 @@ string formatDouble(double value, int precision) {
 
 // Pause screen for user interaction
 void pauseScreen() {
+    if (isHeadless()) {
+        return;
+    }
     cout << "\nPress any key to continue...";
+    if (hasThreadInputSource()) {
+        string ignored;
+        readInputLine(ignored);
+        return;
+    }
+    WaitingForInput waiting;
+    if (consoleScreensActive()) {
+        waitForKeypress();
+        return;
+    }
     system("pause");
 }
\ No newline at end of file
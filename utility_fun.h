@@ -29,8 +29,8 @@ void displayLogo();
 void clearScreen();
 Date getCurrentDate();
 string generateUserID(const vector<Organizer>& user);
-string generateEventID(const vector<EventRegistration>& registrations);
-string generateBookingID(const vector<EventBooking>& bookings);
+string generateEventID(const RegistrationTable& registrations);
+string generateBookingID(const BookingTable& bookings);
 string generateVenueID(const vector<Venue>& venues);
 string formatDouble(double value, int precision = 2);
 void pauseScreen();
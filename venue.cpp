@@ -17,16 +17,17 @@
 #include "utility_fun.h"
 #include "input_validation.h"
 #include "file_operation.h"
+#include "table_format.h"
 
 using namespace std;
 
 // Venue management functions
-int selectAvailableVenue(const vector<Venue>& venues, const Date& date, const string& time) {
+int selectAvailableVenue(const SystemData& data, const Date& date, const string& time) {
     // Build list of available venue indices
     vector<int> availableIndices;
 
-    for (size_t i = 0; i < venues.size(); i++) {
-        if (isVenueAvailableInSchedule(venues[i], date, time)) {
+    for (size_t i = 0; i < data.venues.size(); i++) {
+        if (isVenueSlotFree(data.venueIndex, static_cast<int>(i), date, time)) {
             availableIndices.push_back(static_cast<int>(i));
         }
     }
@@ -41,35 +42,94 @@ int selectAvailableVenue(const vector<Venue>& venues, const Date& date, const st
     return availableIndices[choice - 1]; // Return actual venue index
 }
 
-void displayAvailableVenues(const vector<Venue>& venues, const Date& date, const string& time) {
-    cout << "\n=== AVAILABLE VENUES ===" << endl;
-    cout << "Date: " << date.toString() << " | Time: " << time << endl;
+int selectRecommendedVenue(const SystemData& data, int expectedGuests, Money budget, const Date& date, const string& time) {
+    const size_t MAX_RECOMMENDATIONS = 5;
+    vector<VenueRecommendation> recommendations =
+        recommendVenues(data, expectedGuests, date, time, budget, MAX_RECOMMENDATIONS);
+
+    cout << "\n=== RECOMMENDED VENUES ===" << endl;
+    cout << "Guests: " << expectedGuests << " | Budget: ";
+    if (budget > Money()) {
+        cout << "RM " << budget;
+    }
+    else {
+        cout << "No limit";
+    }
+    cout << " | Date: " << date.toString() << " | Time: " << time << endl;
     cout << setfill('=') << setw(100) << "=" << setfill(' ') << endl;
 
+    if (recommendations.empty()) {
+        cout << "No free venue seats your guests within budget for this slot." << endl;
+        cout << setfill('=') << setw(100) << "=" << setfill(' ') << endl;
+        return -1;
+    }
+
     cout << left << setw(4) << "No."
         << setw(8) << "ID"
         << setw(20) << "Venue Name"
-        << setw(25) << "Address"
-        << setw(8) << "Capacity"
-        << setw(12) << "Cost (RM)"
-        << setw(15) << "Contact"
-        << setw(12) << "Phone" << endl;
+        << setw(10) << "Capacity"
+        << setw(12) << "Spare Seats"
+        << setw(15) << "Cost (RM)"
+        << setw(20) << "Feedback Score" << endl;
     cout << setfill('-') << setw(100) << "-" << setfill(' ') << endl;
 
+    for (size_t i = 0; i < recommendations.size(); i++) {
+        const Venue& venue = data.venues[recommendations[i].position];
+        cout << left << setw(4) << (i + 1)
+            << setw(8) << venue.venueID
+            << setw(20) << venue.venueName.substr(0, 19)
+            << setw(10) << venue.capacity
+            << setw(12) << recommendations[i].spareSeats
+            << "RM " << setw(12) << venue.rentalCost;
+        if (recommendations[i].feedbackCount > 0) {
+            cout << fixed << setprecision(1) << recommendations[i].feedbackScore << "/5 ("
+                << recommendations[i].feedbackCount << ")";
+        }
+        else {
+            cout << "No feedback";
+        }
+        cout << endl;
+    }
+    cout << setfill('=') << setw(100) << "=" << setfill(' ') << endl;
+
+    int choice = getValidIntegerInput("Select venue number (0 to see all available venues): ", 0,
+        static_cast<int>(recommendations.size()));
+    if (choice == 0) {
+        return -1;
+    }
+    return recommendations[choice - 1].position;
+}
+
+void displayAvailableVenues(const SystemData& data, const Date& date, const string& time) {
+    const vector<Venue>& venues = data.venues;
+    cout << "\n=== AVAILABLE VENUES ===" << endl;
+    cout << "Date: " << date.toString() << " | Time: " << time << endl;
+    static constexpr TableColumn columns[] = {
+        { "No.", 4 },
+        { "ID", 8 },
+        { "Venue Name", 20, true },
+        { "Address", 25, true },
+        { "Capacity", 8 },
+        { .header = "Cost (RM)", .width = 12, .prefix = "RM " },
+        { "Contact", 15, true },
+        { "Phone", 12 },
+    };
+    TableWriter table(columns);
+    table.rule('=', 100);
+    table.header();
+    table.rule('-', 100);
+
     int count = 1;
     for (size_t i = 0; i < venues.size(); i++) {
-        if (isVenueAvailableInSchedule(venues[i], date, time)) {
-            cout << left << setw(4) << count
-                << setw(8) << venues[i].venueID
-                << setw(20) << venues[i].venueName.substr(0, 19)
-                << setw(25) << venues[i].address.substr(0, 24)
-                << setw(8) << venues[i].capacity
-                << "RM " << setw(9) << fixed << setprecision(2) << venues[i].rentalCost
-                << setw(15) << venues[i].contactPerson.substr(0, 14)
-                << setw(12) << venues[i].phoneNumber << endl;
+        if (isVenueSlotFree(data.venueIndex, static_cast<int>(i), date, time)) {
+            if (!table.row(count, venues[i].venueID, venues[i].venueName, venues[i].address,
+                venues[i].capacity, venues[i].rentalCost, venues[i].contactPerson, venues[i].phoneNumber)) {
+                break;
+            }
             count++;
         }
     }
+    table.flush();
 
     if (count == 1) {
         cout << "No venues available for the selected date and time." << endl;
@@ -77,7 +137,7 @@ void displayAvailableVenues(const vector<Venue>& venues, const Date& date, const
     cout << setfill('=') << setw(100) << "=" << setfill(' ') << endl;
 }
 
-bool isVenueAvailable(const vector<EventBooking>& bookings, const string& venueID, const Date& eventDate, const string& eventTime) {
+bool isVenueAvailable(const BookingTable& bookings, const string& venueID, const Date& eventDate, const string& eventTime) {
     for (const auto& booking : bookings) {
         if (booking.venue.venueID == venueID &&
             booking.eventDate.day == eventDate.day &&
@@ -109,11 +169,22 @@ bool isVenueAvailableInSchedule(const Venue& venue, const Date& date, const stri
     return true;
 }
 
-EventRegistration* findRegistrationByID(vector<EventRegistration>& registrations, const string& eventID) {
-    for (size_t i = 0; i < registrations.size(); i++) {
-        if (registrations[i].eventID == eventID) {
-            return &registrations[i];
+EventRegistration* findRegistrationByID(RegistrationTable& registrations, const string& eventID) {
+    for (auto& reg : registrations) {
+        if (reg.eventID == eventID) {
+            return &reg;
         }
     }
     return nullptr;
-}
\ No newline at end of file
+}
+Venue venueDetails(const Venue& venue) {
+    Venue details;
+    details.venueID = venue.venueID;
+    details.venueName = venue.venueName;
+    details.address = venue.address;
+    details.capacity = venue.capacity;
+    details.rentalCost = venue.rentalCost;
+    details.contactPerson = venue.contactPerson;
+    details.phoneNumber = venue.phoneNumber;
+    return details;
+}
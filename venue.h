@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 #include "timeslot.h"
+#include "money.h"
+#include "record_table.h"
 
 using namespace std;
 
@@ -15,7 +17,7 @@ struct Venue {
     string venueName;
     string address;
     int capacity = 0;
-    double rentalCost = 0.0;
+    Money rentalCost;
     string contactPerson;
     string phoneNumber;
     vector<TimeSlot> bookingSchedule;
@@ -26,12 +28,20 @@ struct Date;
 struct Venue;
 struct EventBooking;
 struct EventRegistration;
+class SystemData;
+using BookingTable = RecordTable<EventBooking>;
+using RegistrationTable = RecordTable<EventRegistration>;
 
 // Venue management functions
-void displayAvailableVenues(const vector<Venue>& venues, const Date& date, const string& time);
-int selectAvailableVenue(const vector<Venue>& venues, const Date& date, const string& time);
-bool isVenueAvailable(const vector<EventBooking>& bookings, const string& venueID, const Date& eventDate, const string& eventTime); 
+// Both honour the venue operating calendars through the claim cells
+void displayAvailableVenues(const SystemData& data, const Date& date, const string& time);
+int selectAvailableVenue(const SystemData& data, const Date& date, const string& time);
+int selectRecommendedVenue(const SystemData& data, int expectedGuests, Money budget, const Date& date, const string& time);
+bool isVenueAvailable(const BookingTable& bookings, const string& venueID, const Date& eventDate, const string& eventTime); 
 bool isVenueAvailableInSchedule(const Venue& venue, const Date& date, const string& time); 
-EventRegistration* findRegistrationByID(vector<EventRegistration>& registrations, const string& eventID);
+EventRegistration* findRegistrationByID(RegistrationTable& registrations, const string& eventID);
+
+// What a booking keeps of its venue: the details, not the whole schedule
+Venue venueDetails(const Venue& venue);
 
 #endif
\ No newline at end of file
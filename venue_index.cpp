@@ -0,0 +1,209 @@
+#include "venue_index.h"
+#include <algorithm>
+#include <tuple>
+#include <iostream>
+#include "system_data.h"
+
+using namespace std;
+
+static int slotOf(const VenueIndex& index, const string& time) {
+    auto found = find(index.slotTimes.begin(), index.slotTimes.end(), time);
+    return found == index.slotTimes.end() ? -1 : static_cast<int>(found - index.slotTimes.begin());
+}
+
+static int positionOf(const VenueIndex& index, const string& venueID) {
+    auto found = index.positionOf.find(venueID);
+    return found == index.positionOf.end() ? -1 : found->second;
+}
+
+// Turns the configured venue hours and closures into closed claim cells.
+// Slot times only found in old bookings stay open.
+static void compileOperatingCalendar(SystemData& data) {
+    VenueIndex& index = data.venueIndex;
+    const TimeSlotConfig& config = data.timeConfig;
+    int slotCount = static_cast<int>(index.slotTimes.size());
+
+    vector<ClosedRange> closures;
+    for (const auto& closure : config.closures) {
+        int venue = closure.venueID.empty() ? -1 : positionOf(index, closure.venueID);
+        int slot = closure.time.empty() ? -1 : slotOf(index, closure.time);
+        if ((venue == -1 && !closure.venueID.empty()) || (slot == -1 && !closure.time.empty())) {
+            continue; // venue or slot no longer exists
+        }
+        closures.push_back({ venue, slot, closure.from.toDayNumber(), closure.to.toDayNumber() });
+    }
+
+    vector<uint8_t> openDays;
+    if (!config.venueHours.empty()) {
+        openDays.assign(data.venues.size() * slotCount, EVERY_WEEKDAY);
+        for (const auto& hours : config.venueHours) {
+            int venue = positionOf(index, hours.venueID);
+            if (venue == -1) {
+                continue;
+            }
+            for (size_t slot = 0; slot < config.timeSlots.size(); slot++) {
+                bool runs = find(hours.slots.begin(), hours.slots.end(), config.timeSlots[slot]) != hours.slots.end();
+                openDays[static_cast<size_t>(venue) * slotCount + slot] = runs ? hours.openDays : 0;
+            }
+        }
+    }
+
+    index.cells.setCalendar(move(openDays), move(closures));
+}
+
+void rebuildVenueIndex(SystemData& data) {
+    VenueIndex& index = data.venueIndex;
+    index.byCapacity.clear();
+    index.byCost.clear();
+    index.positionOf.clear();
+    index.slotTimes = data.timeConfig.timeSlots;
+
+    const vector<Venue>& venues = data.venues;
+    for (size_t i = 0; i < venues.size(); i++) {
+        index.positionOf[venues[i].venueID] = static_cast<int>(i);
+        index.byCapacity.push_back(static_cast<int>(i));
+    }
+    index.byCost = index.byCapacity;
+
+    sort(index.byCapacity.begin(), index.byCapacity.end(), [&](int a, int b) {
+        return tie(venues[a].capacity, venues[a].rentalCost, a) < tie(venues[b].capacity, venues[b].rentalCost, b);
+        });
+    sort(index.byCost.begin(), index.byCost.end(), [&](int a, int b) {
+        return tie(venues[a].rentalCost, venues[a].capacity, a) < tie(venues[b].rentalCost, venues[b].capacity, b);
+        });
+
+    for (const auto& venue : venues) {
+        for (const auto& slot : venue.bookingSchedule) {
+            if (slot.isBooked && slotOf(index, slot.time) < 0) {
+                index.slotTimes.push_back(slot.time);
+            }
+        }
+    }
+    index.cells.reset(static_cast<int>(venues.size()), static_cast<int>(index.slotTimes.size()));
+    compileOperatingCalendar(data);
+
+    // Bookings made before a closure was configured, or clashing with
+    // another booking, keep their record but can't hold the cell
+    for (const auto& venue : venues) {
+        for (const auto& slot : venue.bookingSchedule) {
+            if (!slot.isBooked ||
+                reserveVenueSlot(index, venue.venueID, slot.date, slot.time, slot.eventID) == ReserveResult::Claimed) {
+                continue;
+            }
+            string problem = isVenueSlotClosed(index, positionOf(index, venue.venueID), slot.date, slot.time)
+                ? "falls on a closed day" : "clashes with another booking";
+            cout << "Error: Booking " + slot.eventID + " at " + venue.venueID + " on " + slot.date.toString() +
+                " (" + slot.time + ") " + problem + "\n";
+        }
+    }
+}
+
+ReserveResult reserveVenueSlot(VenueIndex& index, const string& venueID, const Date& date, const string& time, const string& bookingID) {
+    return index.cells.claim(positionOf(index, venueID), date.toDayNumber(), slotOf(index, time), reservationToken(bookingID));
+}
+
+void releaseVenueSlot(VenueIndex& index, const string& venueID, const Date& date, const string& time, const string& bookingID) {
+    index.cells.release(positionOf(index, venueID), date.toDayNumber(), slotOf(index, time), reservationToken(bookingID));
+}
+
+bool isVenueSlotFree(const VenueIndex& index, int position, const Date& date, const string& time) {
+    // A time the index doesn't know, or a year outside the cells, can't be booked
+    int slot = slotOf(index, time);
+    int dayNumber = date.toDayNumber();
+    return index.cells.covers(position, dayNumber, slot) && index.cells.owner(position, dayNumber, slot) == 0;
+}
+
+bool isVenueSlotTaken(const VenueIndex& index, int position, const Date& date, const string& time) {
+    int slot = slotOf(index, time);
+    int dayNumber = date.toDayNumber();
+    if (!index.cells.covers(position, dayNumber, slot)) {
+        return false;
+    }
+    uint32_t owner = index.cells.owner(position, dayNumber, slot);
+    return owner != 0 && owner != CLOSED_TOKEN;
+}
+
+bool isVenueSlotClosed(const VenueIndex& index, int position, const Date& date, const string& time) {
+    return index.cells.owner(position, date.toDayNumber(), slotOf(index, time)) == CLOSED_TOKEN;
+}
+
+vector<VenueRecommendation> recommendVenues(const SystemData& data, int expectedGuests,
+    const Date& date, const string& time, Money budget, size_t maxResults) {
+    const VenueIndex& index = data.venueIndex;
+    const vector<Venue>& venues = data.venues;
+    bool limitCost = budget > Money();
+
+    // Range of venues big enough, and range of venues cheap enough
+    auto capacityStart = lower_bound(index.byCapacity.begin(), index.byCapacity.end(), expectedGuests,
+        [&](int position, int guests) { return venues[position].capacity < guests; });
+    auto costEnd = limitCost
+        ? upper_bound(index.byCost.begin(), index.byCost.end(), budget,
+            [&](Money limit, int position) { return limit < venues[position].rentalCost; })
+        : index.byCost.end();
+
+    auto fits = [&](int position) {
+        return venues[position].capacity >= expectedGuests &&
+            (!limitCost || venues[position].rentalCost <= budget) &&
+            isVenueSlotFree(index, position, date, time);
+    };
+
+    vector<int> candidates;
+    size_t capacityCount = index.byCapacity.end() - capacityStart;
+    size_t costCount = costEnd - index.byCost.begin();
+
+    if (capacityCount <= costCount) {
+        // Walk in ranking order, stopping once the result is full and the
+        // next venue can no longer tie with the last one kept
+        for (auto it = capacityStart; it != index.byCapacity.end(); ++it) {
+            if (candidates.size() >= maxResults) {
+                const Venue& last = venues[candidates.back()];
+                const Venue& next = venues[*it];
+                if (next.capacity != last.capacity || next.rentalCost != last.rentalCost) {
+                    break;
+                }
+            }
+            if (fits(*it)) {
+                candidates.push_back(*it);
+            }
+        }
+    }
+    else {
+        for (auto it = index.byCost.begin(); it != costEnd; ++it) {
+            if (fits(*it)) {
+                candidates.push_back(*it);
+            }
+        }
+    }
+
+    vector<VenueRecommendation> result;
+    result.reserve(candidates.size());
+    for (int position : candidates) {
+        VenueRecommendation recommendation{ position, venues[position].capacity - expectedGuests, 0.0, 0 };
+        const TrendSeries* trend = findVenueTrend(data.ratingTrends, venues[position].venueName);
+        if (trend != nullptr) {
+            recommendation.feedbackScore = trend->recent.mean(0);
+            recommendation.feedbackCount = trend->recent.count;
+        }
+        result.push_back(recommendation);
+    }
+
+    sort(result.begin(), result.end(), [&](const VenueRecommendation& a, const VenueRecommendation& b) {
+        const Venue& left = venues[a.position];
+        const Venue& right = venues[b.position];
+        if (left.capacity != right.capacity) {
+            return left.capacity < right.capacity;
+        }
+        if (left.rentalCost != right.rentalCost) {
+            return left.rentalCost < right.rentalCost;
+        }
+        if (a.feedbackScore != b.feedbackScore) {
+            return a.feedbackScore > b.feedbackScore;
+        }
+        return a.position < b.position;
+        });
+
+    if (result.size() > maxResults) {
+        result.resize(maxResults);
+    }
+    return result;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#ifndef VENUE_INDEX_H
+#define VENUE_INDEX_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "date.h"
+#include "money.h"
+#include "slot_cells.h"
+using namespace std;
+
+// Ordered views of the venue catalog plus the claim cell of every
+// (venue, date, time slot), with the operating calendar compiled in.
+// Venues are referred to by their position in data.venues, which does
+// not change after loading.
+struct VenueIndex {
+    vector<int> byCapacity;                     // ascending capacity, then cost
+    vector<int> byCost;                         // ascending rental cost, then capacity
+    unordered_map<string, int> positionOf;      // venueID -> position
+    vector<string> slotTimes;                   // configured slots, then any legacy times on file
+    SlotCells cells;
+};
+
+struct VenueRecommendation {
+    int position;           // index into data.venues
+    int spareSeats;         // capacity - expected guests
+    double feedbackScore;   // recent venue rating average, 0 when unrated
+    int feedbackCount;
+};
+
+// Forward declarations
+class SystemData;
+
+void rebuildVenueIndex(SystemData& data);
+
+// Claim a slot for a booking before touching venue.bookingSchedule. Only
+// Claimed lets the booking go ahead: Conflict means someone else got there
+// first, OutOfRange that the venue, time or year can't be booked at all.
+// Release only frees the owner's claim.
+ReserveResult reserveVenueSlot(VenueIndex& index, const string& venueID, const Date& date, const string& time, const string& bookingID);
+void releaseVenueSlot(VenueIndex& index, const string& venueID, const Date& date, const string& time, const string& bookingID);
+bool isVenueSlotFree(const VenueIndex& index, int position, const Date& date, const string& time);
+bool isVenueSlotTaken(const VenueIndex& index, int position, const Date& date, const string& time);   // held by a booking
+bool isVenueSlotClosed(const VenueIndex& index, int position, const Date& date, const string& time);
+
+// Free venues that seat the guests and fit the budget (zero budget = no limit),
+// ranked by smallest sufficient capacity, then lowest cost, then best feedback
+vector<VenueRecommendation> recommendVenues(const SystemData& data, int expectedGuests,
+    const Date& date, const string& time, Money budget, size_t maxResults);
+
+#endif
@@ -0,0 +1,330 @@
+#include "waitlist.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "clock.h"
+#include "system_data.h"
+#include "booking_transaction.h"
+#include "utility_fun.h"
+#include "input_validation.h"
+#include "file_operation.h"
+
+using namespace std;
+
+string waitlistSlotKey(const string& venueID, const Date& date, const string& time) {
+    return venueID + "|" + date.toString() + "|" + time;
+}
+
+string waitlistEntryID(int number) {
+    return "WL" + to_string(number);
+}
+
+static WaitlistRank rankOf(const WaitlistBook& book, const WaitlistEntry& entry) {
+    return { book.rankByBudget ? -entry.budget.cents : 0, entry.requestedAt, entry.number };
+}
+
+void addWaitlistEntry(WaitlistBook& book, const WaitlistEntry& entry) {
+    book.entries[entry.number] = entry;
+    book.queues[waitlistSlotKey(entry.venueID, entry.date, entry.time)].insert(rankOf(book, entry));
+    book.byEvent[entry.eventID].push_back(entry.number);
+    book.nextNumber = max(book.nextNumber, entry.number + 1);
+}
+
+const WaitlistEntry* joinWaitlist(WaitlistBook& book, RecordHandle registration, const EventRegistration& reg,
+    const string& venueID, const Date& date, const string& time, bool allowOverCapacity) {
+    auto waiting = book.byEvent.find(reg.eventID);
+    if (waiting != book.byEvent.end()) {
+        for (int number : waiting->second) {
+            const WaitlistEntry& existing = book.entries.at(number);
+            if (existing.venueID == venueID && existing.time == time &&
+                existing.date.toDayNumber() == date.toDayNumber()) {
+                return nullptr;
+            }
+        }
+    }
+
+    WaitlistEntry entry;
+    entry.number = book.nextNumber;
+    entry.eventID = reg.eventID;
+    entry.venueID = venueID;
+    entry.date = date;
+    entry.time = time;
+    entry.requestedAt = currentTimestamp();
+    entry.budget = reg.estimatedBudget;
+    entry.allowOverCapacity = allowOverCapacity;
+    entry.registration = registration;
+    addWaitlistEntry(book, entry);
+    return &book.entries.at(entry.number);
+}
+
+void linkWaitlistRegistrations(SystemData& data) {
+    WaitlistBook& book = data.waitlist;
+    for (auto it = data.registrations.begin(); it != data.registrations.end(); ++it) {
+        auto waiting = book.byEvent.find(it->eventID);
+        if (waiting == book.byEvent.end()) {
+            continue;
+        }
+        for (int number : waiting->second) {
+            book.entries.at(number).registration = it.handle();
+        }
+    }
+}
+
+bool leaveWaitlist(WaitlistBook& book, int number) {
+    auto found = book.entries.find(number);
+    if (found == book.entries.end()) {
+        return false;
+    }
+    const WaitlistEntry& entry = found->second;
+
+    string key = waitlistSlotKey(entry.venueID, entry.date, entry.time);
+    auto queue = book.queues.find(key);
+    if (queue != book.queues.end()) {
+        queue->second.erase(rankOf(book, entry));
+        if (queue->second.empty()) {
+            book.queues.erase(queue);
+        }
+    }
+
+    auto waiting = book.byEvent.find(entry.eventID);
+    if (waiting != book.byEvent.end()) {
+        erase(waiting->second, number);
+        if (waiting->second.empty()) {
+            book.byEvent.erase(waiting);
+        }
+    }
+
+    book.entries.erase(found);
+    return true;
+}
+
+int removeWaitlistEntriesFor(WaitlistBook& book, const string& eventID) {
+    auto waiting = book.byEvent.find(eventID);
+    if (waiting == book.byEvent.end()) {
+        return 0;
+    }
+    vector<int> numbers = waiting->second;
+    for (int number : numbers) {
+        leaveWaitlist(book, number);
+    }
+    return static_cast<int>(numbers.size());
+}
+
+size_t waitlistLength(const WaitlistBook& book, const string& venueID, const Date& date, const string& time) {
+    auto queue = book.queues.find(waitlistSlotKey(venueID, date, time));
+    return queue == book.queues.end() ? 0 : queue->second.size();
+}
+
+size_t waitlistPosition(const WaitlistBook& book, int number) {
+    auto found = book.entries.find(number);
+    if (found == book.entries.end()) {
+        return 0;
+    }
+    const WaitlistEntry& entry = found->second;
+    const set<WaitlistRank>& queue = book.queues.at(waitlistSlotKey(entry.venueID, entry.date, entry.time));
+    return static_cast<size_t>(distance(queue.begin(), queue.find(rankOf(book, entry)))) + 1;
+}
+
+void setWaitlistBudgetPriority(WaitlistBook& book, bool rankByBudget) {
+    if (book.rankByBudget == rankByBudget) {
+        return;
+    }
+    book.rankByBudget = rankByBudget;
+    book.queues.clear();
+    for (const auto& entry : book.entries) {
+        book.queues[waitlistSlotKey(entry.second.venueID, entry.second.date, entry.second.time)]
+            .insert(rankOf(book, entry.second));
+    }
+}
+
+string promoteFromWaitlist(SystemData& data, const string& venueID, const Date& date, const string& time) {
+    WaitlistBook& book = data.waitlist;
+    string key = waitlistSlotKey(venueID, date, time);
+    auto venue = data.venueIndex.positionOf.find(venueID);
+    if (venue == data.venueIndex.positionOf.end() || book.queues.find(key) == book.queues.end() ||
+        !isVenueSlotFree(data.venueIndex, venue->second, date, time)) {
+        return "";
+    }
+
+    string promoted;
+    bool changed = false;
+    while (promoted.empty()) {
+        // leaveWaitlist drops the queue once it empties, so look it up each round
+        auto queue = book.queues.find(key);
+        if (queue == book.queues.end()) {
+            break;
+        }
+        WaitlistEntry head = book.entries.at(queue->second.begin()->number);
+        leaveWaitlist(book, head.number);
+        changed = true;
+
+        const EventRegistration* reg = data.registrations.find(head.registration);
+        if (reg == nullptr || reg->eventID != head.eventID || reg->eventStatus != "UNSCHEDULED") {
+            continue;
+        }
+
+        BookingTransaction transaction;
+        size_t part = stageBooking(transaction, head.registration, venue->second, date, time);
+        transaction.staged[part].allowOverCapacity = head.allowOverCapacity;
+        TransactionResult result = commitTransaction(data, transaction);
+        if (!result.committed) {
+            continue;
+        }
+
+        promoted = result.bookingIDs.front();
+        removeWaitlistEntriesFor(book, head.eventID);
+        cout << "Waitlist: " << head.eventID << " moved from " << waitlistEntryID(head.number)
+            << " into booking " << promoted << " (Pending payment)." << endl;
+    }
+
+    if (changed) {
+        saveWaitlistToFile(book);
+    }
+    return promoted;
+}
+
+void offerWaitlist(SystemData& data, RecordHandle registration, const Date& date, const string& time) {
+    const EventRegistration& reg = data.registrations[registration];
+    // Booked venues at this slot, smallest sufficient first; closed ones never free up
+    vector<int> fullVenues;
+    for (int position : data.venueIndex.byCapacity) {
+        if (isVenueSlotTaken(data.venueIndex, position, date, time)) {
+            fullVenues.push_back(position);
+        }
+    }
+    if (fullVenues.empty()) {
+        return;
+    }
+    stable_partition(fullVenues.begin(), fullVenues.end(),
+        [&](int position) { return data.venues[position].capacity >= reg.expectedGuests; });
+
+    cout << "\n=== FULLY BOOKED VENUES ===" << endl;
+    cout << "Date: " << date.toString() << " | Time: " << time << endl;
+    cout << setfill('=') << setw(80) << "=" << setfill(' ') << endl;
+    cout << left << setw(4) << "No."
+        << setw(8) << "ID"
+        << setw(20) << "Venue Name"
+        << setw(10) << "Capacity"
+        << setw(15) << "Cost (RM)"
+        << setw(10) << "Waiting" << endl;
+    cout << setfill('-') << setw(80) << "-" << setfill(' ') << endl;
+    for (size_t i = 0; i < fullVenues.size(); i++) {
+        const Venue& venue = data.venues[fullVenues[i]];
+        cout << left << setw(4) << (i + 1)
+            << setw(8) << venue.venueID
+            << setw(20) << venue.venueName.substr(0, 19)
+            << setw(10) << venue.capacity
+            << "RM " << setw(12) << venue.rentalCost
+            << setw(10) << waitlistLength(data.waitlist, venue.venueID, date, time) << endl;
+    }
+    cout << setfill('=') << setw(80) << "=" << setfill(' ') << endl;
+
+    int choice = getValidIntegerInput("Join the waitlist for venue number (0 to skip): ", 0,
+        static_cast<int>(fullVenues.size()));
+    if (choice == 0) {
+        return;
+    }
+
+    const Venue& venue = data.venues[fullVenues[choice - 1]];
+    bool overCapacity = reg.expectedGuests > venue.capacity;
+    if (overCapacity) {
+        cout << "\nWARNING: Expected guests (" << reg.expectedGuests
+            << ") exceeds venue capacity (" << venue.capacity << ")!" << endl;
+        vector<char> validChars = { 'Y', 'N' };
+        char confirm = getValidCharInput("Wait for this venue anyway? (Y/N): ", validChars);
+        if (confirm != 'Y' && confirm != 'y') {
+            cout << "Waitlist request cancelled." << endl;
+            return;
+        }
+    }
+
+    const WaitlistEntry* entry = joinWaitlist(data.waitlist, registration, reg, venue.venueID, date, time, overCapacity);
+    if (entry == nullptr) {
+        cout << reg.eventID << " is already waiting for this venue and slot." << endl;
+        return;
+    }
+    saveWaitlistToFile(data.waitlist);
+
+    cout << "\nAdded to waitlist as " << waitlistEntryID(entry->number) << ", position "
+        << waitlistPosition(data.waitlist, entry->number) << " of "
+        << waitlistLength(data.waitlist, venue.venueID, date, time) << "." << endl;
+    cout << "If the slot is released you will get a Pending booking automatically." << endl;
+}
+
+void manageWaitlist(SystemData& data) {
+    clearScreen();
+    cout << "=== MY WAITLIST ===" << endl;
+
+    if (data.currentUser.empty()) {
+        cout << "Error: No user logged in!" << endl;
+        return;
+    }
+
+    // Current user's entries, soonest slot first
+    string normalizedCurrentUser = normalizeUserID(data.currentUser);
+    vector<const WaitlistEntry*> mine;
+    for (const auto& reg : data.registrations) {
+        if (normalizeUserID(reg.organizer.userID) != normalizedCurrentUser) {
+            continue;
+        }
+        auto waiting = data.waitlist.byEvent.find(reg.eventID);
+        if (waiting != data.waitlist.byEvent.end()) {
+            for (int number : waiting->second) {
+                mine.push_back(&data.waitlist.entries.at(number));
+            }
+        }
+    }
+    sort(mine.begin(), mine.end(), [](const WaitlistEntry* a, const WaitlistEntry* b) {
+        return make_tuple(a->date.toDayNumber(), a->time, a->number) < make_tuple(b->date.toDayNumber(), b->time, b->number);
+        });
+
+    cout << "Queue order: " << (data.waitlist.rankByBudget ? "highest budget first, then request time" : "request time") << endl;
+    cout << setfill('=') << setw(80) << "=" << setfill(' ') << endl;
+    if (mine.empty()) {
+        cout << "You are not waiting for any venue." << endl;
+    }
+    else {
+        cout << left << setw(4) << "No."
+            << setw(10) << "Entry"
+            << setw(10) << "Event ID"
+            << setw(10) << "Venue"
+            << setw(12) << "Date"
+            << setw(14) << "Time"
+            << setw(10) << "Position" << endl;
+        cout << setfill('-') << setw(80) << "-" << setfill(' ') << endl;
+        for (size_t i = 0; i < mine.size(); i++) {
+            cout << left << setw(4) << (i + 1)
+                << setw(10) << waitlistEntryID(mine[i]->number)
+                << setw(10) << mine[i]->eventID
+                << setw(10) << mine[i]->venueID
+                << setw(12) << mine[i]->date.toString()
+                << setw(14) << mine[i]->time
+                << waitlistPosition(data.waitlist, mine[i]->number) << "/"
+                << waitlistLength(data.waitlist, mine[i]->venueID, mine[i]->date, mine[i]->time) << endl;
+        }
+    }
+    cout << setfill('=') << setw(80) << "=" << setfill(' ') << endl;
+
+    // Entries are kept by number past the prompt: a promotion in another
+    // session may drop one while we wait
+    vector<int> mineNumbers;
+    for (const WaitlistEntry* entry : mine) {
+        mineNumbers.push_back(entry->number);
+    }
+
+    if (mine.empty()) {
+        return;
+    }
+    vector<char> validChars = { 'Y', 'N' };
+    char leave = getValidCharInput("Leave one of these waitlists? (Y/N): ", validChars);
+    if (leave == 'Y' || leave == 'y') {
+        int entry = getValidIntegerInput("Entry number to leave: ", 1, static_cast<int>(mineNumbers.size()));
+        int number = mineNumbers[entry - 1];
+        if (!leaveWaitlist(data.waitlist, number)) {
+            cout << "Waitlist " << waitlistEntryID(number) << " has already ended (promoted or removed)." << endl;
+            return;
+        }
+        saveWaitlistToFile(data.waitlist);
+        cout << "Left waitlist " << waitlistEntryID(number) << "." << endl;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef WAITLIST_H
+#define WAITLIST_H
+
+#include <string>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "date.h"
+#include "money.h"
+#include "record_table.h"
+using namespace std;
+
+// A registration waiting for one fully booked (venue, date, time slot)
+struct WaitlistEntry {
+    int number = 0;                 // shown as "WL1001"
+    string eventID;
+    string venueID;
+    Date date;
+    string time;
+    long long requestedAt = 0;      // seconds since epoch
+    Money budget;                   // registration budget when the entry was made
+    bool allowOverCapacity = false; // organizer accepted a venue smaller than the guest list
+    RecordHandle registration;      // not saved; linked again after loading
+};
+
+// Queue order: larger budget first when ranking by budget, then earliest request
+struct WaitlistRank {
+    long long priority;             // -budget cents, or 0
+    long long requestedAt;
+    int number;
+
+    auto operator<=>(const WaitlistRank&) const = default;
+};
+
+struct WaitlistBook {
+    bool rankByBudget = false;      // system setting, the ORDER line of waitlist.txt
+    int nextNumber = 1001;
+    unordered_map<int, WaitlistEntry> entries;              // number -> entry
+    unordered_map<string, set<WaitlistRank>> queues;        // venueID|date|time -> ranked entries
+    unordered_map<string, vector<int>> byEvent;             // eventID -> its entry numbers
+};
+
+// Forward declarations
+class SystemData;
+struct Venue;
+struct EventRegistration;
+
+string waitlistSlotKey(const string& venueID, const Date& date, const string& time);
+string waitlistEntryID(int number);
+
+// Queue bookkeeping, O(log n) in the queue length. join returns nullptr
+// when the registration is already waiting for that slot.
+const WaitlistEntry* joinWaitlist(WaitlistBook& book, RecordHandle registration, const EventRegistration& reg,
+    const string& venueID, const Date& date, const string& time, bool allowOverCapacity);
+void addWaitlistEntry(WaitlistBook& book, const WaitlistEntry& entry);   // used when loading
+// After loading: one pass over the registrations to find each entry's own
+void linkWaitlistRegistrations(SystemData& data);
+bool leaveWaitlist(WaitlistBook& book, int number);
+int removeWaitlistEntriesFor(WaitlistBook& book, const string& eventID);
+size_t waitlistLength(const WaitlistBook& book, const string& venueID, const Date& date, const string& time);
+size_t waitlistPosition(const WaitlistBook& book, int number);           // 1-based, 0 if unknown
+void setWaitlistBudgetPriority(WaitlistBook& book, bool rankByBudget);  // re-ranks every queue
+
+// Called whenever a slot is released: books the first waiting registration
+// that can still take it as a Pending booking. Stale heads (registration
+// gone, cancelled or already scheduled) are dropped on the way. Returns the
+// new booking ID, or "" when nobody was promoted.
+string promoteFromWaitlist(SystemData& data, const string& venueID, const Date& date, const string& time);
+
+// Interactive screens
+void offerWaitlist(SystemData& data, RecordHandle registration, const Date& date, const string& time);
+void manageWaitlist(SystemData& data);
+
+#endif
@@ -0,0 +1,250 @@
+#include "worker_pool.h"
+#include <algorithm>
+
+using namespace std;
+
+// The pool and deque index of the worker running on this thread, if any
+static thread_local WorkerPool* currentPool = nullptr;
+static thread_local int currentWorker = -1;
+
+string taskPriorityName(TaskPriority priority) {
+    switch (priority) {
+    case TaskPriority::Interactive: return "interactive";
+    case TaskPriority::Normal: return "normal";
+    case TaskPriority::Bulk: return "bulk";
+    }
+    return "unknown";
+}
+
+void TaskTiming::add(double waitMs, double runMs) {
+    count++;
+    totalWaitMs += waitMs;
+    maxWaitMs = max(maxWaitMs, waitMs);
+    totalRunMs += runMs;
+    maxRunMs = max(maxRunMs, runMs);
+}
+
+// ---- TaskState ----
+
+bool TaskState::ready() const {
+    lock_guard<mutex> guard(lock);
+    return finished;
+}
+
+void TaskState::wait() {
+    // A continuation is only queued once what it follows is done
+    if (antecedent) {
+        antecedent->wait();
+    }
+    if (shared_ptr<PoolTask> queued = task.lock()) {
+        if (pool->claim(*queued)) {
+            pool->ranInline.fetch_add(1, memory_order_relaxed);
+            pool->execute(*queued);
+        }
+    }
+    unique_lock<mutex> guard(lock);
+    finishedSignal.wait(guard, [this] { return finished; });
+}
+
+// Continuations are queued before waiters are woken, so a waiter on one of
+// them always finds it queued
+void TaskState::complete(exception_ptr failure) {
+    vector<function<void()>> queued;
+    {
+        lock_guard<mutex> guard(lock);
+        error = failure;
+        settled = true;
+        queued.swap(continuations);
+    }
+    for (auto& continuation : queued) {
+        continuation();
+    }
+    {
+        lock_guard<mutex> guard(lock);
+        finished = true;
+    }
+    finishedSignal.notify_all();
+}
+
+void TaskState::onSettled(function<void()> continuation) {
+    {
+        lock_guard<mutex> guard(lock);
+        if (!settled) {
+            continuations.push_back(move(continuation));
+            return;
+        }
+    }
+    continuation();
+}
+
+// ---- WorkerPool ----
+
+WorkerPool::WorkerPool(int threadCount) {
+    for (int p = 0; p < TASK_PRIORITIES; p++) {
+        waiting[p] = 0;
+        maxWaiting[p] = 0;
+        submitted[p] = 0;
+    }
+    for (int i = 0; i < threadCount; i++) {
+        deques.push_back(make_unique<TaskQueue>());
+    }
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : threads) {
+        worker.join();
+    }
+}
+
+shared_ptr<PoolTask> WorkerPool::makeTask(TaskPriority priority, string name, function<void()> run) {
+    auto task = make_shared<PoolTask>();
+    task->pool = this;
+    task->priority = priority;
+    task->name = move(name);
+    task->run = move(run);
+    return task;
+}
+
+void WorkerPool::enqueue(shared_ptr<PoolTask> task) {
+    int priority = static_cast<int>(task->priority);
+    task->queuedAt = chrono::steady_clock::now();
+    submitted[priority].fetch_add(1, memory_order_relaxed);
+    size_t depth = waiting[priority].fetch_add(1) + 1;
+    size_t deepest = maxWaiting[priority].load(memory_order_relaxed);
+    while (depth > deepest && !maxWaiting[priority].compare_exchange_weak(deepest, depth, memory_order_relaxed)) {
+    }
+
+    TaskQueue& queue = currentPool == this ? *deques[currentWorker] : shared;
+    {
+        lock_guard<mutex> guard(queue.lock);
+        queue.tasks[priority].push_back(move(task));
+    }
+    entries.fetch_add(1);
+    // Taking the lock orders this against a worker deciding to sleep
+    {
+        lock_guard<mutex> guard(sleepLock);
+    }
+    wake.notify_one();
+}
+
+bool WorkerPool::claim(PoolTask& task) {
+    if (task.claimed.exchange(true)) {
+        return false;
+    }
+    waiting[static_cast<int>(task.priority)].fetch_sub(1);
+    return true;
+}
+
+void WorkerPool::execute(PoolTask& task) {
+    auto started = chrono::steady_clock::now();
+    task.run();
+    task.run = nullptr;     // let go of what it captured
+    auto ended = chrono::steady_clock::now();
+
+    double waitMs = chrono::duration<double, milli>(started - task.queuedAt).count();
+    double runMs = chrono::duration<double, milli>(ended - started).count();
+    lock_guard<mutex> guard(statsLock);
+    timings[static_cast<int>(task.priority)].add(waitMs, runMs);
+    byName[task.name].add(waitMs, runMs);
+}
+
+// Most urgent first; within a priority, own deque, shared queue, then steal
+shared_ptr<PoolTask> WorkerPool::next(int self) {
+    int count = static_cast<int>(deques.size());
+    for (int priority = 0; priority < TASK_PRIORITIES; priority++) {
+        {
+            TaskQueue& own = *deques[self];
+            lock_guard<mutex> guard(own.lock);
+            if (!own.tasks[priority].empty()) {
+                auto task = move(own.tasks[priority].back());
+                own.tasks[priority].pop_back();
+                entries.fetch_sub(1);
+                return task;
+            }
+        }
+        {
+            lock_guard<mutex> guard(shared.lock);
+            if (!shared.tasks[priority].empty()) {
+                auto task = move(shared.tasks[priority].front());
+                shared.tasks[priority].pop_front();
+                entries.fetch_sub(1);
+                return task;
+            }
+        }
+        for (int offset = 1; offset < count; offset++) {
+            TaskQueue& victim = *deques[(self + offset) % count];
+            lock_guard<mutex> guard(victim.lock);
+            if (!victim.tasks[priority].empty()) {
+                auto task = move(victim.tasks[priority].front());
+                victim.tasks[priority].pop_front();
+                entries.fetch_sub(1);
+                stolen.fetch_add(1, memory_order_relaxed);
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void WorkerPool::workerLoop(int self) {
+    currentPool = this;
+    currentWorker = self;
+    while (true) {
+        if (shared_ptr<PoolTask> task = next(self)) {
+            // Already run by a waiter if the claim fails
+            if (claim(*task)) {
+                execute(*task);
+            }
+            continue;
+        }
+        unique_lock<mutex> guard(sleepLock);
+        if (entries.load() == 0) {
+            if (stopping) {
+                return;     // stopping, and nothing left to finish
+            }
+            wake.wait(guard);
+        }
+    }
+}
+
+PoolStats WorkerPool::stats() const {
+    PoolStats result;
+    result.threads = size();
+    result.stolen = stolen.load(memory_order_relaxed);
+    result.ranInline = ranInline.load(memory_order_relaxed);
+    for (int p = 0; p < TASK_PRIORITIES; p++) {
+        result.priorities[p].submitted = submitted[p].load(memory_order_relaxed);
+        result.priorities[p].queued = waiting[p].load(memory_order_relaxed);
+        result.priorities[p].maxQueued = maxWaiting[p].load(memory_order_relaxed);
+    }
+    lock_guard<mutex> guard(statsLock);
+    for (int p = 0; p < TASK_PRIORITIES; p++) {
+        result.priorities[p].timing = timings[p];
+    }
+    result.byName = byName;
+    return result;
+}
+
+// ---- Shared pool ----
+
+static int backgroundThreads = 0;
+
+void setBackgroundThreads(int threadCount) {
+    backgroundThreads = threadCount;
+}
+
+WorkerPool& backgroundPool() {
+    // At least two, so a long bulk job never leaves interactive work queued
+    // behind it on a one-core machine
+    static WorkerPool pool(backgroundThreads > 0 ? backgroundThreads
+        : max(2, static_cast<int>(thread::hardware_concurrency())));
+    return pool;
+}
@@ -0,0 +1,279 @@
+#pragma once
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+using namespace std;
+
+// Which queued task a free worker takes first. Nothing is interrupted:
+// a bulk job already running finishes, but no bulk job starts while an
+// interactive one is waiting.
+enum class TaskPriority : uint8_t {
+    Interactive,    // a client is waiting on the answer (JSON requests)
+    Normal,         // saves and other work a user started
+    Bulk,           // index rebuilds, report formatting
+};
+
+const int TASK_PRIORITIES = 3;
+
+string taskPriorityName(TaskPriority priority);     // "interactive", "normal", "bulk"
+
+// Latencies in milliseconds: wait is queued -> started, run is started -> done
+struct TaskTiming {
+    long long count = 0;
+    double totalWaitMs = 0;
+    double maxWaitMs = 0;
+    double totalRunMs = 0;
+    double maxRunMs = 0;
+
+    void add(double waitMs, double runMs);
+};
+
+struct PriorityStats {
+    long long submitted = 0;
+    size_t queued = 0;          // waiting to start now
+    size_t maxQueued = 0;       // the most that ever waited at once
+    TaskTiming timing;
+};
+
+struct PoolStats {
+    int threads = 0;
+    long long stolen = 0;       // taken from another worker's deque
+    long long ranInline = 0;    // run by a thread waiting on the result
+    PriorityStats priorities[TASK_PRIORITIES];
+    map<string, TaskTiming> byName;
+};
+
+class WorkerPool;
+
+// One unit of queued work. Whoever claims it first runs it: a worker, or
+// a thread waiting on its result that finds it has not started yet.
+struct PoolTask {
+    WorkerPool* pool = nullptr;
+    TaskPriority priority = TaskPriority::Normal;
+    string name;                // groups the timings in PoolStats::byName
+    chrono::steady_clock::time_point queuedAt;
+    atomic<bool> claimed{ false };
+    function<void()> run;
+};
+
+// Completion shared by a task, its futures and its continuations
+class TaskState {
+public:
+    bool ready() const;
+    // Runs the task here if nobody has started it, otherwise blocks until
+    // it is done. A thread waiting while it holds data locks therefore
+    // never depends on a worker that may be queued behind those locks.
+    void wait();
+    // Records the outcome (null for success), queues the continuations
+    // and wakes the waiters; called once, by whatever ran the task
+    void complete(exception_ptr failure);
+
+protected:
+    template <typename T> friend class TaskFuture;
+    friend class WorkerPool;
+
+    WorkerPool* pool = nullptr;
+    mutable mutex lock;
+    condition_variable finishedSignal;
+    bool settled = false;       // result stored; new continuations are queued at once
+    bool finished = false;      // and the ones registered before are queued too
+    exception_ptr error;
+    vector<function<void()>> continuations;
+    weak_ptr<PoolTask> task;
+    shared_ptr<TaskState> antecedent;   // for a continuation, what it waits on
+
+    void onSettled(function<void()> continuation);
+};
+
+template <typename T>
+class TaskResultState : public TaskState {
+public:
+    conditional_t<is_void_v<T>, monostate, optional<T>> value;
+};
+
+// Runs work and stores its result (or exception) in state
+template <typename T, typename F>
+void settleTask(TaskResultState<T>& state, F& work) {
+    try {
+        if constexpr (is_void_v<T>) {
+            work();
+        }
+        else {
+            state.value.emplace(work());
+        }
+    }
+    catch (...) {
+        state.complete(current_exception());
+        return;
+    }
+    state.complete(nullptr);
+}
+
+// What a continuation returns, given the result it is passed
+template <typename T, typename F>
+struct ContinuationResult {
+    using type = invoke_result_t<F&, T>;
+};
+
+template <typename F>
+struct ContinuationResult<void, F> {
+    using type = invoke_result_t<F&>;
+};
+
+// Result of a pool task. Like std::future, the value can be taken once:
+// by get() or by a continuation, not both.
+template <typename T>
+class TaskFuture {
+public:
+    TaskFuture() = default;
+
+    bool valid() const { return state != nullptr; }
+    bool ready() const { return state->ready(); }
+    void wait() const { state->wait(); }
+
+    // Waits; rethrows what the task threw
+    T get() {
+        state->wait();
+        if (state->error) {
+            rethrow_exception(state->error);
+        }
+        if constexpr (!is_void_v<T>) {
+            return move(*state->value);
+        }
+    }
+
+    // Queues continuation once this task is done, passing it the result
+    // (nothing for void). If this task threw, the continuation is skipped
+    // and its future rethrows the same exception.
+    template <typename F>
+    auto then(TaskPriority priority, string name, F&& continuation);
+
+private:
+    template <typename> friend class TaskFuture;
+    friend class WorkerPool;
+
+    shared_ptr<TaskResultState<T>> state;
+};
+
+// Fixed set of threads sharing work by stealing. Tasks submitted from a
+// worker go on that worker's own deque, which it takes from the newest
+// end; tasks from other threads go on a shared queue. An idle worker
+// looks for the most urgent priority first: its own deque, then the
+// shared queue, then the oldest task on another worker's deque.
+// Destruction finishes every task already queued, then joins.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threadCount);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    template <typename F>
+    auto submit(TaskPriority priority, string name, F&& work) -> TaskFuture<invoke_result_t<decay_t<F>&>>;
+
+    int size() const { return static_cast<int>(threads.size()); }
+    PoolStats stats() const;
+
+private:
+    template <typename> friend class TaskFuture;
+    friend class TaskState;
+
+    struct TaskQueue {
+        mutex lock;
+        deque<shared_ptr<PoolTask>> tasks[TASK_PRIORITIES];
+    };
+
+    vector<unique_ptr<TaskQueue>> deques;   // one per worker
+    TaskQueue shared;
+    vector<thread> threads;
+
+    mutex sleepLock;
+    condition_variable wake;
+    bool stopping = false;
+    atomic<size_t> entries{ 0 };            // in any queue, claimed or not
+
+    atomic<size_t> waiting[TASK_PRIORITIES];        // queued and unclaimed
+    atomic<size_t> maxWaiting[TASK_PRIORITIES];
+    atomic<long long> submitted[TASK_PRIORITIES];
+    atomic<long long> stolen{ 0 };
+    atomic<long long> ranInline{ 0 };
+
+    mutable mutex statsLock;
+    TaskTiming timings[TASK_PRIORITIES];
+    map<string, TaskTiming> byName;
+
+    shared_ptr<PoolTask> makeTask(TaskPriority priority, string name, function<void()> run);
+    void enqueue(shared_ptr<PoolTask> task);
+    bool claim(PoolTask& task);
+    void execute(PoolTask& task);
+    shared_ptr<PoolTask> next(int self);
+    void workerLoop(int self);
+};
+
+template <typename F>
+auto WorkerPool::submit(TaskPriority priority, string name, F&& work) -> TaskFuture<invoke_result_t<decay_t<F>&>> {
+    using Result = invoke_result_t<decay_t<F>&>;
+    TaskFuture<Result> future;
+    future.state = make_shared<TaskResultState<Result>>();
+    future.state->pool = this;
+
+    auto task = makeTask(priority, move(name),
+        [state = future.state, work = decay_t<F>(forward<F>(work))]() mutable {
+            settleTask(*state, work);
+        });
+    future.state->task = task;
+    enqueue(move(task));
+    return future;
+}
+
+template <typename T>
+template <typename F>
+auto TaskFuture<T>::then(TaskPriority priority, string name, F&& continuation) {
+    using Next = typename ContinuationResult<T, decay_t<F>>::type;
+
+    WorkerPool* pool = state->pool;
+    TaskFuture<Next> next;
+    next.state = make_shared<TaskResultState<Next>>();
+    next.state->pool = pool;
+    next.state->antecedent = state;
+
+    auto task = pool->makeTask(priority, move(name),
+        [previous = state, following = next.state, work = decay_t<F>(forward<F>(continuation))]() mutable {
+            if (previous->error) {
+                following->complete(previous->error);
+            }
+            else if constexpr (is_void_v<T>) {
+                settleTask(*following, work);
+            }
+            else {
+                auto withResult = [&]() -> Next { return work(move(*previous->value)); };
+                settleTask(*following, withResult);
+            }
+        });
+    next.state->task = task;
+    state->onSettled([pool, task] { pool->enqueue(task); });
+    return next;
+}
+
+// Pool shared by the whole program for background work: saves, report
+// formatting, index rebuilds, and the shared server's JSON requests. It
+// starts on first use, so size it before then.
+void setBackgroundThreads(int threadCount);
+WorkerPool& backgroundPool();
+
+#endif